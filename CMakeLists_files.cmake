@@ -36,6 +36,7 @@ list (APPEND MAIN_SOURCE_FILES
       src/opm/common/utility/parameters/Parameter.cpp
       src/opm/common/utility/parameters/ParameterGroup.cpp
       src/opm/common/utility/parameters/ParameterTools.cpp
+      src/opm/common/utility/numeric/calculateCellGeometry.cpp
       src/opm/common/utility/numeric/calculateCellVol.cpp
       src/opm/common/utility/TimeService.cpp
 )
@@ -59,6 +60,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/EclipseConfig.cpp
     src/opm/parser/eclipse/EclipseState/EclipseState.cpp
     src/opm/parser/eclipse/EclipseState/EndpointScaling.cpp
+    src/opm/parser/eclipse/EclipseState/Snapshot.cpp
     src/opm/parser/eclipse/EclipseState/Edit/EDITNNC.cpp
     src/opm/parser/eclipse/EclipseState/Grid/FieldProps.cpp
     src/opm/parser/eclipse/EclipseState/Grid/FieldPropsManager.cpp
@@ -156,6 +158,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Tables/PvtwsaltTable.cpp
     src/opm/parser/eclipse/EclipseState/Tables/BrineDensityTable.cpp
     src/opm/parser/eclipse/EclipseState/Tables/SolventDensityTable.cpp
+    src/opm/parser/eclipse/EclipseState/Util/BinarySerializer.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQASTNode.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQParams.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQParser.cpp
@@ -171,6 +174,7 @@ if(ENABLE_ECL_INPUT)
     src/opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQInput.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPInjTable.cpp
     src/opm/parser/eclipse/EclipseState/Schedule/VFPProdTable.cpp
+    src/opm/parser/eclipse/Parser/DeckCache.cpp
     src/opm/parser/eclipse/Parser/ErrorGuard.cpp
     src/opm/parser/eclipse/Parser/ParseContext.cpp
     src/opm/parser/eclipse/Parser/Parser.cpp
@@ -231,9 +235,11 @@ if(ENABLE_ECL_INPUT)
 endif()
 if(ENABLE_ECL_OUTPUT)
   list( APPEND MAIN_SOURCE_FILES
+          src/opm/io/eclipse/Compression.cpp
           src/opm/io/eclipse/EclFile.cpp
           src/opm/io/eclipse/EclOutput.cpp
           src/opm/io/eclipse/EclUtil.cpp
+          src/opm/io/eclipse/MappedFile.cpp
           src/opm/io/eclipse/EGrid.cpp
           src/opm/io/eclipse/ERft.cpp
           src/opm/io/eclipse/ERst.cpp
@@ -337,6 +343,7 @@ if(ENABLE_ECL_INPUT)
     tests/parser/SectionTests.cpp
     tests/parser/SimpleTableTests.cpp
     tests/parser/SimulationConfigTest.cpp
+    tests/parser/SnapshotTests.cpp
     tests/parser/StarTokenTests.cpp
     tests/parser/StringTests.cpp
     tests/parser/SummaryConfigTests.cpp
@@ -493,6 +500,7 @@ list( APPEND PUBLIC_HEADER_FILES
       opm/common/utility/parameters/ParameterRequirement.hpp
       opm/common/utility/parameters/ParameterStrings.hpp
       opm/common/utility/parameters/ParameterTools.hpp
+      opm/common/utility/numeric/calculateCellGeometry.hpp
       opm/common/utility/numeric/calculateCellVol.hpp
       opm/common/utility/TimeService.hpp
 )
@@ -520,6 +528,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/InitConfig/InitConfig.hpp
        opm/parser/eclipse/EclipseState/InitConfig/Equil.hpp
        opm/parser/eclipse/EclipseState/InitConfig/FoamConfig.hpp
+       opm/parser/eclipse/EclipseState/Util/BinarySerializer.hpp
        opm/parser/eclipse/EclipseState/Util/Value.hpp
        opm/parser/eclipse/EclipseState/Util/IOrderSet.hpp
        opm/parser/eclipse/EclipseState/Util/OrderedMap.hpp
@@ -616,6 +625,7 @@ if(ENABLE_ECL_INPUT)
        opm/parser/eclipse/EclipseState/Tables/SgofTable.hpp
        opm/parser/eclipse/EclipseState/EclipseState.hpp
        opm/parser/eclipse/EclipseState/EclipseConfig.hpp
+       opm/parser/eclipse/EclipseState/Snapshot.hpp
        opm/parser/eclipse/EclipseState/Aquancon.hpp
        opm/parser/eclipse/EclipseState/AquiferConfig.hpp
        opm/parser/eclipse/EclipseState/AquiferCT.hpp
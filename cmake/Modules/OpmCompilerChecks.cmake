@@ -4,6 +4,7 @@
 # HAS_ATTRIBUTE_UNUSED             True if attribute unused is supported
 # HAS_ATTRIBUTE_DEPRECATED         True if attribute deprecated is supported
 # HAS_ATTRIBUTE_DEPRECATED_MSG     True if attribute deprecated("msg") is supported
+# HAVE_FLOATING_POINT_CHARCONV     True if std::from_chars/std::to_chars support double
 
 include(CheckCXXSourceCompiles)
 
@@ -92,6 +93,24 @@ CHECK_CXX_SOURCE_COMPILES("
 "  HAS_ATTRIBUTE_DEPRECATED_MSG
 )
 
+# std::from_chars and std::to_chars for floating point values, GCC 11 and later
+if(POLICY CMP0067)
+  # check with the C++ standard of the project
+  cmake_policy(SET CMP0067 NEW)
+endif()
+CHECK_CXX_SOURCE_COMPILES("
+#include <charconv>
+   int main(void)
+   {
+     char text[32];
+     double value = 1.5;
+     auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::scientific, 8);
+     std::from_chars(text, result.ptr, value);
+     return 0;
+   };
+"  HAVE_FLOATING_POINT_CHARCONV
+)
+
 if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
   if (CMAKE_CXX_COMPILER_VERSION VERSION_LESS 9.0)
     list(APPEND ${project}_LIBRARIES stdc++fs)
@@ -3,7 +3,9 @@
 
 # defines that must be present in config.h for our headers
 set (opm-common_CONFIG_VAR
-	"HAS_ATTRIBUTE_UNUSED")
+	"HAS_ATTRIBUTE_UNUSED"
+	"HAVE_FLOATING_POINT_CHARCONV"
+	"HAVE_ZLIB")
 
 # dependencies
 set (opm-common_DEPS
@@ -14,6 +16,8 @@ set (opm-common_DEPS
 list(APPEND opm-common_DEPS
       # various runtime library enhancements
       "Boost 1.44.0 COMPONENTS system unit_test_framework REQUIRED"
+      # compressed binary output files
+      "ZLIB"
 )
 
 find_package_deps(opm-common)
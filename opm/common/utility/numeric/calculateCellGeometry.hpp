@@ -0,0 +1,85 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CALCULATE_CELL_GEOMETRY_HPP
+#define OPM_CALCULATE_CELL_GEOMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+/*
+  Geometry of a set of corner-point cells in structure-of-arrays layout,
+  element n of each vector refers to cell number n of the set.  Only the
+  quantities requested when calculating are filled, the others are empty.
+*/
+
+struct CellGeometry
+{
+    enum Quantity : unsigned {
+        Corners = 1 << 0,
+        Centers = 1 << 1,
+        Volumes = 1 << 2,
+        Depths  = 1 << 3,
+        All     = Corners | Centers | Volumes | Depths
+    };
+
+    // cornerX[c][n] is the x coordinate of corner c of cell n, corners are
+    // numbered as in EclipseGrid::getCellCorners()
+    std::array<std::vector<double>, 8> cornerX;
+    std::array<std::vector<double>, 8> cornerY;
+    std::array<std::vector<double>, 8> cornerZ;
+
+    std::vector<double> centerX;
+    std::vector<double> centerY;
+    std::vector<double> centerZ;
+
+    std::vector<double> volume;     // as calculateCellVol()
+    std::vector<double> depth;      // mean depth of top and bottom face
+};
+
+/*
+  Calculate geometry of the cells with global (cartesian) indices
+  cells[0], ..., cells[numCells-1] from the COORD and ZCORN arrays of a
+  corner-point grid with dimensions dims.  Cells are processed in blocks
+  which are distributed over threads when OpenMP is enabled.  The
+  calculations are those of the single cell functions, applied in the
+  same order.
+*/
+
+template <typename T>
+CellGeometry calculateCellGeometry(const std::array<int, 3>& dims,
+                                   const std::vector<T>& coord,
+                                   const std::vector<T>& zcorn,
+                                   const int* cells, std::size_t numCells,
+                                   unsigned quantities = CellGeometry::All);
+
+template <typename T>
+CellGeometry calculateCellGeometry(const std::array<int, 3>& dims,
+                                   const std::vector<T>& coord,
+                                   const std::vector<T>& zcorn,
+                                   const std::vector<int>& cells,
+                                   unsigned quantities = CellGeometry::All)
+{
+    return calculateCellGeometry(dims, coord, zcorn, cells.data(), cells.size(), quantities);
+}
+
+} // namespace Opm
+
+#endif // OPM_CALCULATE_CELL_GEOMETRY_HPP
@@ -20,6 +20,7 @@
 #define OPM_IO_EGRID_HPP
 
 #include <opm/io/eclipse/EclFile.hpp>
+#include <opm/common/utility/numeric/calculateCellGeometry.hpp>
 
 #include <array>
 #include <iostream>
@@ -34,7 +35,7 @@ namespace Opm { namespace EclIO {
 class EGrid : public EclFile
 {
 public:
-    explicit EGrid(const std::string& filename);
+    explicit EGrid(const std::string& filename, const OpenOptions& options = OpenOptions{});
 
     int global_index(int i, int j, int k) const;
     int active_index(int i, int j, int k) const;
@@ -47,6 +48,10 @@ public:
     void getCellCorners(int globindex, std::array<double,8>& X, std::array<double,8>& Y, std::array<double,8>& Z) const;
     void getCellCorners(const std::array<int, 3>& ijk, std::array<double,8>& X, std::array<double,8>& Y, std::array<double,8>& Z) const;
 
+    // geometry of all active cells, or of active cells in [activeBegin, activeEnd)
+    CellGeometry getCellGeometry(unsigned quantities = CellGeometry::All) const;
+    CellGeometry getCellGeometry(int activeBegin, int activeEnd, unsigned quantities = CellGeometry::All) const;
+
     int activeCells() const { return nactive; }
     int totalNumberOfCells() const { return nijk[0] * nijk[1] * nijk[2]; }
 
@@ -34,7 +34,7 @@ namespace Opm { namespace EclIO {
 class ERft : public EclFile
 {
 public:
-    explicit ERft(const std::string &filename);
+    explicit ERft(const std::string &filename, const OpenOptions& options = OpenOptions{});
 
     using RftDate = std::tuple<int,int,int>;
     template <typename T>
@@ -36,10 +36,11 @@ namespace Opm { namespace EclIO {
 class ERst : public EclFile
 {
 public:
-    explicit ERst(const std::string& filename);
+    explicit ERst(const std::string& filename, const OpenOptions& options = OpenOptions{});
     bool hasReportStepNumber(int number) const;
 
     void loadReportStepNumber(int number);
+    void unloadReportStep(int number);          // release all arrays of report step
 
     template <typename T>
     const std::vector<T>& getRst(const std::string& name, int reportStepNumber, int occurrence);
@@ -50,6 +51,12 @@ public:
         return  this->get<T>(index + std::get<0>(indRange));
     }
 
+    // owning handle, outlives the release of the array from the cache (see EclFile)
+    template <typename T>
+    std::shared_ptr<const std::vector<T>> getRstShared(const std::string& name, int reportStepNumber, int occurrence){
+        return this->getShared<T>(this->getArrayIndex(name, reportStepNumber, occurrence));
+    }
+
     int count(const std::string& name, int reportStepNumber) const; 
 
     const std::vector<int>& listOfReportStepNumbers() const { return seqnum; }
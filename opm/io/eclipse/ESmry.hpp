@@ -19,10 +19,17 @@
 #ifndef OPM_IO_ESMRY_HPP
 #define OPM_IO_ESMRY_HPP
 
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <opm/common/utility/FileSystem.hpp>
+#include <opm/io/eclipse/EclFile.hpp>
 
 namespace Opm { namespace EclIO {
 
@@ -30,15 +37,38 @@ class ESmry
 {
 public:
 
-    // input is smspec (or fsmspec file)
-    explicit ESmry(const std::string& filename, bool loadBaseRunData=false);
+    // input is smspec (or fsmspec file). Only the SMSPEC files and the
+    // array headers of the summary data files are read by the constructor,
+    // the vectors themselves are loaded from file on first access.  A
+    // transposed summary file (see writeCacheFile()) which no longer matches
+    // its source files is rewritten, unless refreshCacheFile is false in
+    // which case it is left alone and ignored.
+    explicit ESmry(const std::string& filename, bool loadBaseRunData=false,
+                   const OpenOptions& options = OpenOptions{},
+                   bool refreshCacheFile = true);
 
     int numberOfVectors() const { return nVect; }
 
     bool hasKey(const std::string& key) const;
 
+    // get() and loadData() may be called concurrently from several threads,
+    // each vector is then read from file only once.  The references returned
+    // by get() stay valid for the lifetime of the object.
     const std::vector<float>& get(const std::string& name) const;
 
+    void loadData() const;                                     // load all vectors
+    void loadData(const std::vector<std::string>& vectList) const;   // load vectors in a single pass over the data files
+
+    // Transposed summary file (CASE.ESMRY) holding each vector as one
+    // contiguous array.  The constructor reads vectors from this file
+    // instead of the summary data files when it is up to date with respect
+    // to all SMSPEC and summary data files involved.  An existing file which
+    // is out of date is rewritten by the constructor, unless disabled by
+    // its refreshCacheFile argument.  Must not be called concurrently with
+    // get() or loadData().
+    void writeCacheFile() const;
+    bool usesCacheFile() const { return static_cast<bool>(cacheFile); }
+
     std::vector<float> get_at_rstep(const std::string& name) const;
 
     const std::vector<std::string>& keywordList() const { return keyword; }
@@ -51,13 +81,46 @@ private:
     int nVect, nI, nJ, nK;
 
     void ijk_from_global_index(int glob, int &i, int &j, int &k) const;
-    std::vector<std::vector<float>> param;
-    std::vector<std::string> keyword;
+    mutable std::vector<std::vector<float>> param;
+    mutable std::vector<bool> arrayLoaded;
+
+    // arrayLoaded and loading are guarded by loadMutex, a vector is published
+    // in param before arrayLoaded is set and is not modified afterwards.  The
+    // summary data files and the cache file are read by one thread at a time.
+    mutable std::vector<bool> loading;
+    mutable std::mutex loadMutex;
+    mutable std::condition_variable loadDone;
+    mutable std::mutex readMutex;
+    std::vector<std::string> keyword;       // sorted
     std::unordered_map<std::string, std::string> kwunits;
 
     std::vector<int> seqIndex;
     std::vector<float> seqTime;
 
+    // summary data files (unified or non-unified) of this run and any base runs
+    std::vector<std::unique_ptr<EclFile>> dataFiles;
+
+    // (data file index, array index of PARAMS in data file, run index) for each time step
+    std::vector<std::tuple<int, int, int>> timeStepList;
+
+    // position of each vector in the PARAMS arrays of each run, -1 if not present in run
+    std::vector<std::vector<int>> paramsPos;
+
+    Opm::filesystem::path cachePath;
+    std::uint64_t sourceKey;
+    std::unique_ptr<EclFile> cacheFile;
+
+    bool openCacheFile(const OpenOptions& options);
+
+    std::vector<std::vector<float>> readVectors(const std::vector<int>& keyIndices) const;
+    std::vector<std::vector<float>> readColumns(const std::vector<std::vector<int>>& columnPos) const;
+
+    void readTimeSteps(size_t fromStep, size_t toStep,
+                       const std::vector<std::vector<std::pair<int,int>>>& runElements,
+                       std::vector<std::vector<float>>& columns) const;
+
+    int getKeywordIndex(const std::string& name) const;
+
     std::vector<std::string> checkForMultipleResultFiles(const Opm::filesystem::path& rootN, bool formatted) const;
 
     void getRstString(const std::vector<std::string>& restartArray,
@@ -23,34 +23,166 @@
 
 #include <opm/io/eclipse/EclIOdata.hpp>
 
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <ios>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm { namespace EclIO {
 
+class MappedFile;
+class PositionedFile;
+
+// Options controlling how an EclFile accesses its backing file.
+struct OpenOptions
+{
+    // Map binary files into memory and decode arrays directly from the
+    // mapped pages rather than through a file stream.  Ignored for
+    // formatted and compressed files.
+    bool memoryMap = false;
+
+    // Keep the array headers of the file in an index file next to it
+    // (e.g. CASE.UNRST.idx) and use that rather than scanning the file
+    // when it is reopened.  The index is keyed on file size and
+    // modification time.  If the file has only been appended to since the
+    // index was written, just the new arrays are scanned.
+    bool useIndexFile = false;
+
+    // Keep a binary file open for the lifetime of the object and read
+    // arrays with positioned reads (pread) on the shared descriptor, rather
+    // than opening a new stream for every load.  Intended for objects shared
+    // between threads.
+    bool keepOpen = false;
+
+    // Upper limit, in bytes, on the memory held by loaded arrays.  When a
+    // newly loaded array brings the total above the limit, the least
+    // recently used arrays are released (see EclFile on references returned
+    // by get()).  Zero means no limit.
+    std::size_t cacheBudget = 0;
+};
+
+// Counters for the array cache of an EclFile.
+struct CacheStatistics
+{
+    std::size_t hits = 0;           // get() served from loaded arrays
+    std::size_t misses = 0;         // get() that had to read the array
+    std::size_t evictions = 0;      // arrays released to stay within budget
+    std::size_t bytesResident = 0;  // memory currently held by loaded arrays
+};
+
+// Read-only view of a numeric array (INTE, REAL or DOUB) in a memory mapped
+// binary file.  Elements are converted from big endian on access, nothing is
+// copied when the view is created.  The view keeps the mapping alive.
+
+template <typename T>
+class MappedArray
+{
+    static_assert(std::is_same<T, int>::value || std::is_same<T, float>::value ||
+                  std::is_same<T, double>::value,
+                  "MappedArray supports int, float and double elements only");
+
+public:
+    MappedArray() = default;
+
+    MappedArray(std::shared_ptr<const MappedFile> file, const char* data, std::size_t size)
+        : mapping(std::move(file)), start(data), numElements(size)
+    {}
+
+    std::size_t size() const { return numElements; }
+    bool empty() const { return numElements == 0; }
+
+    T operator[](std::size_t i) const
+    {
+        // all numeric types are stored in Fortran records of 1000 elements
+        // with a 4 byte record marker before and after each record
+
+        constexpr std::size_t elmPerBlock = 1000;
+        constexpr std::size_t blockBytes = elmPerBlock * sizeof(T) + 2 * sizeof(int);
+
+        const char* ptr = start + (i / elmPerBlock) * blockBytes
+                        + sizeof(int) + (i % elmPerBlock) * sizeof(T);
+
+        return flip(ptr);
+    }
+
+    std::vector<T> toVector() const
+    {
+        std::vector<T> values(numElements);
+
+        for (std::size_t i = 0; i < numElements; i++)
+            values[i] = (*this)[i];
+
+        return values;
+    }
+
+private:
+    std::shared_ptr<const MappedFile> mapping;
+    const char* start = nullptr;
+    std::size_t numElements = 0;
+
+    static T flip(const char* ptr)
+    {
+        T value;
+
+        if constexpr (sizeof(T) == 4) {
+            unsigned int tmp;
+            std::memcpy(&tmp, ptr, sizeof(tmp));
+            tmp = __builtin_bswap32(tmp);
+            std::memcpy(&value, &tmp, sizeof(value));
+        } else {
+            unsigned long long tmp;
+            std::memcpy(&tmp, ptr, sizeof(tmp));
+            tmp = __builtin_bswap64(tmp);
+            std::memcpy(&value, &tmp, sizeof(value));
+        }
+
+        return value;
+    }
+};
+
+// Arrays are loaded on first access.  The get() functions (and getRst() in
+// ERst) may be called concurrently from several threads on one object, each
+// array is then read from file only once.  Functions that discard loaded
+// data, such as clearData() and unloadData(), must not be called
+// concurrently with these.
+//
+// With a cache budget, a reference returned by get() (or getRst() in ERst)
+// is valid until the next array is loaded into the object, which may release
+// it to stay within the budget.  The handle returned by getShared() keeps the
+// array alive after the cache has released it, use that to hold on to an
+// array across loads or while other threads read from the same object.
+
 class EclFile
 {
 public:
     explicit EclFile(const std::string& filename, bool preload = false);
+    EclFile(const std::string& filename, const OpenOptions& options, bool preload = false);
     bool formattedInput() { return formatted; }
 
+    // binary file with compressed arrays, written by EclOutput
+    bool compressedInput() const { return compressed; }
+
     void loadData();                            // load all data
     void loadData(const std::string& arrName);         // load all arrays with array name equal to arrName
     void loadData(int arrIndex);                // load data based on array indices in vector arrIndex
     void loadData(const std::vector<int>& arrIndex);   // load data based on array indices in vector arrIndex
 
-    void clearData()
-    {
-      inte_array.clear();
-      real_array.clear();
-      doub_array.clear();
-      logi_array.clear();
-      char_array.clear();
-    }
+    void clearData();                           // release all loaded arrays
+    void unloadData(int arrIndex);              // release single array
+    void unloadData(const std::vector<int>& arrIndex);
+
+    CacheStatistics cacheStatistics() const;
 
     using EclEntry = std::tuple<std::string, eclArrType, long int>;
     std::vector<EclEntry> getList() const;
@@ -61,20 +193,43 @@ public:
     template <typename T>
     const std::vector<T>& get(const std::string& name);
 
+    // loads the array if needed, only the (mutable) cache of loaded arrays
+    // is modified which makes these usable from const member functions
+    template <typename T>
+    std::shared_ptr<const std::vector<T>> getShared(int arrIndex) const;
+
+    template <typename T>
+    std::shared_ptr<const std::vector<T>> getShared(const std::string& name) const;
+
     bool hasKey(const std::string &name) const;
 
+    // zero-copy access to numeric arrays, requires OpenOptions::memoryMap
+    bool memoryMapped() const { return static_cast<bool>(mappedFile); }
+
+    template <typename T>
+    MappedArray<T> getMapped(int arrIndex) const;
+
+    template <typename T>
+    MappedArray<T> getMapped(const std::string& name) const;
+
     const std::vector<std::string>& arrayNames() const { return array_name; }
     std::size_t size() const;
 
 protected:
     bool formatted;
+    bool compressed = false;
     std::string inputFilename;
 
-    std::unordered_map<int, std::vector<int>> inte_array;
-    std::unordered_map<int, std::vector<bool>> logi_array;
-    std::unordered_map<int, std::vector<double>> doub_array;
-    std::unordered_map<int, std::vector<float>> real_array;
-    std::unordered_map<int, std::vector<std::string>> char_array;
+    template <typename T>
+    using ArrayMap = std::unordered_map<int, std::shared_ptr<const std::vector<T>>>;
+
+    // loaded arrays, a cache which is also filled by the const getShared()
+
+    mutable ArrayMap<int> inte_array;
+    mutable ArrayMap<bool> logi_array;
+    mutable ArrayMap<double> doub_array;
+    mutable ArrayMap<float> real_array;
+    mutable ArrayMap<std::string> char_array;
 
     std::vector<std::string> array_name;
     std::vector<eclArrType> array_type;
@@ -86,30 +241,126 @@ protected:
 
     template<class T>
     const std::vector<T>& getImpl(int arrIndex, eclArrType type,
-                                  const std::unordered_map<int, std::vector<T>>& array,
-                                  const std::string& typeStr)
+                                  const ArrayMap<T>& array,
+                                  const std::string& typeStr) const
+    {
+        return *getSharedImpl(arrIndex, type, array, typeStr);
+    }
+
+    template<class T>
+    std::shared_ptr<const std::vector<T>>
+    getSharedImpl(int arrIndex, eclArrType type,
+                  const ArrayMap<T>& array,
+                  const std::string& typeStr) const
     {
         if (array_type[arrIndex] != type) {
             std::string message = "Array with index " + std::to_string(arrIndex) + " is not of type " + typeStr;
             OPM_THROW(std::runtime_error, message);
         }
 
-        if (!arrayLoaded[arrIndex]) {
-          loadData(arrIndex);
-        }
+        // the array may be released by another thread between loading and
+        // lookup when a cache budget is used, it is then loaded again
+
+        bool loaded = false;
+
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(loadGuard.mutex);
+                auto it = array.find(arrIndex);
 
-        return array.at(arrIndex);
+                if (it != array.end()) {
+                    touchArray(arrIndex, !loaded);
+                    return it->second;
+                }
+            }
+
+            loadOnce(arrIndex);
+            loaded = true;
+        }
     }
 
+    // Serialises access to the array caches, arrayLoaded and the cache
+    // bookkeeping.  Copies get their own mutex.
+    struct LoadGuard
+    {
+        LoadGuard() = default;
+        LoadGuard(const LoadGuard&) {}
+        LoadGuard& operator=(const LoadGuard&) { return *this; }
+
+        std::mutex mutex;
+        std::condition_variable loaded;
+    };
+
+    mutable LoadGuard loadGuard;
+
+    // Bookkeeping of loaded arrays, protected by loadGuard.  Loaded arrays
+    // are ordered by last use in lru.  lastUse, arrayBytes and loading are
+    // per array.
+    struct CacheState
+    {
+        std::size_t budget = 0;
+        std::uint64_t tick = 0;
+        std::vector<std::uint64_t> lastUse;
+        std::vector<std::size_t> arrayBytes;
+        std::vector<bool> loading;
+        std::set<std::pair<std::uint64_t, int>> lru;
+        CacheStatistics stats;
+    };
+
+    mutable CacheState cache;
+
+    void loadOnce(int arrIndex) const;
+
+    // callers must hold loadGuard.mutex
+    void touchArray(int arrIndex, bool hit) const;
+    void registerArray(int arrIndex, std::size_t bytes) const;
+    void releaseArray(int arrIndex) const;
+
+    template <typename T>
+    void storeArray(ArrayMap<T>& array, int arrIndex, std::vector<T>&& data) const;
+
     std::streampos
     seekPosition(const std::vector<std::string>::size_type arrIndex) const;
 
+    friend class ESmry;
+
 private:
-    std::vector<bool> arrayLoaded;
+    mutable std::vector<bool> arrayLoaded;
+
+    std::shared_ptr<MappedFile> mappedFile;
+    std::shared_ptr<PositionedFile> positionedFile;
+
+    template <typename Stream>
+    void scanHeaders(Stream& fileH);
 
-    void loadBinaryArray(std::fstream& fileH, std::size_t arrIndex);
-    void loadFormattedArray(const std::string& fileStr, std::size_t arrIndex, long int fromPos);
-    
+    template <typename Stream>
+    void scanHeadersIndexed(Stream& fileH);
+
+    enum class IndexStatus { Missing, Current, Appended };
+
+    template <typename Stream>
+    IndexStatus readIndexFile(Stream& fileH);
+
+    void writeIndexFile() const;
+    void clearHeaders();
+
+    std::streamoff firstArrayPosition() const;
+
+    // loading arrays only fills the mutable caches
+    void loadArrays(const std::vector<int>& arrIndex) const;
+
+    template <typename Stream>
+    void loadBinaryArray(Stream& fileH, std::size_t arrIndex) const;
+
+    template <typename Stream>
+    void decodeBinaryArray(Stream& fileH, std::size_t arrIndex) const;
+
+    void loadBinaryArrays(const std::vector<int>& arrIndex) const;
+    void loadFormattedArrays(const std::vector<int>& arrIndex) const;
+    void loadFormattedArray(const char* first, const char* last, std::size_t arrIndex) const;
+
+    template <typename T>
+    MappedArray<T> getMappedImpl(int arrIndex, eclArrType type, const std::string& typeStr) const;
 };
 
 }} // namespace Opm::EclIO
@@ -18,10 +18,12 @@
 #ifndef OPM_IO_ECLOUTPUT_HPP
 #define OPM_IO_ECLOUTPUT_HPP
 
+#include <cstddef>
 #include <fstream>
+#include <functional>
 #include <ios>
 #include <string>
-#include <typeinfo>
+#include <type_traits>
 #include <vector>
 
 #include <opm/io/eclipse/EclIOdata.hpp>
@@ -38,52 +40,79 @@ namespace Opm { namespace EclIO {
 class EclOutput
 {
 public:
+    // A compressed binary file (see Compression.hpp) is written if
+    // compressed is set and formatted is not.  When appending to an
+    // existing file (std::ios::app), compressed must match that file.
     EclOutput(const std::string&            filename,
               const bool                    formatted,
-              const std::ios_base::openmode mode = std::ios::out);
+              const std::ios_base::openmode mode = std::ios::out,
+              const bool                    compressed = false);
 
     template<typename T>
     void write(const std::string& name,
                const std::vector<T>& data)
     {
-        eclArrType arrType = MESS;
-        if (typeid(T) == typeid(int))
-            arrType = INTE;
-        else if (typeid(T) == typeid(float))
-            arrType = REAL;
-        else if (typeid(T) == typeid(double))
-            arrType = DOUB;
-        else if (typeid(T) == typeid(bool))
-            arrType = LOGI;
-        else if (typeid(T) == typeid(char))
-            arrType = MESS;
+        constexpr eclArrType arrType = arrayType<T>();
 
         if (isFormatted)
         {
             writeFormattedHeader(name, data.size(), arrType);
-            if (arrType != MESS)
+            if constexpr (arrType != MESS)
                 writeFormattedArray(data);
         }
         else
         {
             writeBinaryHeader(name, data.size(), arrType);
-            if (arrType != MESS)
+            if constexpr (arrType != MESS)
                 writeBinaryArray(data);
+
+            endBinaryArray();
         }
     }
 
+    // Write an array of size elements of type T (float or double) without
+    // holding it in memory.  The elements are produced in blocks as the
+    // array is written; fill(first, num, dst) stores elements first, ...,
+    // first+num-1 at dst.  The output is identical to that of write().
+    template <typename T>
+    void writeBlocks(const std::string& name, std::size_t size,
+                     const std::function<void(std::size_t, std::size_t, T*)>& fill);
+
     void message(const std::string& msg);
     void flushStream();
 
+    // false once writing to the file has failed
+    bool good() const { return ofileH.good(); }
+
     friend class OutputStream::Restart;
     friend class OutputStream::SummarySpecification;
 
 private:
+    template <typename T>
+    static constexpr eclArrType arrayType()
+    {
+        if constexpr (std::is_same<T, int>::value)
+            return INTE;
+        else if constexpr (std::is_same<T, float>::value)
+            return REAL;
+        else if constexpr (std::is_same<T, double>::value)
+            return DOUB;
+        else if constexpr (std::is_same<T, bool>::value)
+            return LOGI;
+        else
+            return MESS;
+    }
+
     void writeBinaryHeader(const std::string& arrName, long int size, eclArrType arrType);
+    void writeBinaryData(const char* data, std::size_t size);
+    void endBinaryArray();
 
     template <typename T>
     void writeBinaryArray(const std::vector<T>& data);
 
+    template <typename Encode>
+    void writeBinaryRecords(std::size_t size, eclArrType arrType, Encode&& encode);
+
     void writeBinaryCharArray(const std::vector<std::string>& data);
     void writeBinaryCharArray(const std::vector<PaddedOutputString<8>>& data);
 
@@ -92,15 +121,25 @@ private:
     template <typename T>
     void writeFormattedArray(const std::vector<T>& data);
 
+    template <typename Encode>
+    void writeFormattedCharRecords(std::size_t size, Encode&& encode);
+
     void writeFormattedCharArray(const std::vector<std::string>& data);
     void writeFormattedCharArray(const std::vector<PaddedOutputString<8>>& data);
 
     void writeArrayType(const eclArrType arrType);
-    std::string make_real_string(float value) const;
-    std::string make_doub_string(double value) const;
 
     bool isFormatted;
+    bool isCompressed;
     std::ofstream ofileH;
+
+    // data records of the current array of a compressed file, compressed
+    // and written when the array is complete
+    std::vector<char> pendingRecords;
+
+    // binary records, markers included, and lines of formatted output are
+    // encoded here and written to ofileH in large chunks
+    std::vector<char> stage;
 };
 
 
@@ -21,6 +21,7 @@
 
 #include <opm/io/eclipse/EclIOdata.hpp>
 
+#include <cstddef>
 #include <string>
 #include <tuple>
 
@@ -31,6 +32,24 @@ namespace Opm { namespace EclIO {
     float flipEndianFloat(float num);
     double flipEndianDouble(double num);
 
+    // Bulk conversion of num contiguous values between big endian (file)
+    // and native byte order.  Source and destination may be the same
+    // buffer.  Uses SSSE3 or AVX2 byte shuffles when supported by the CPU
+    // running the program, a portable scalar loop otherwise.
+    void flipEndian(const int* src, int* dst, std::size_t num);
+    void flipEndian(const float* src, float* dst, std::size_t num);
+    void flipEndian(const double* src, double* dst, std::size_t num);
+
+    // Conversion into a byte buffer which need not be aligned for the
+    // element type, e.g. a position inside an output record.
+    void flipEndian(const int* src, char* dst, std::size_t num);
+    void flipEndian(const float* src, char* dst, std::size_t num);
+    void flipEndian(const double* src, char* dst, std::size_t num);
+
+    void flipEndian(int* data, std::size_t num);
+    void flipEndian(float* data, std::size_t num);
+    void flipEndian(double* data, std::size_t num);
+
     std::tuple<int, int> block_size_data_binary(eclArrType arrType);
     std::tuple<int, int, int> block_size_data_formatted(eclArrType arrType);
 
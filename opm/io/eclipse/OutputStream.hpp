@@ -24,6 +24,8 @@
 
 #include <array>
 #include <chrono>
+#include <cstddef>
+#include <functional>
 #include <ios>
 #include <memory>
 #include <string>
@@ -37,8 +39,9 @@ namespace Opm { namespace EclIO {
 
 namespace Opm { namespace EclIO { namespace OutputStream {
 
-    struct Formatted { bool set; };
-    struct Unified   { bool set; };
+    struct Formatted  { bool set; };
+    struct Unified    { bool set; };
+    struct Compressed { bool set; };
 
     /// Abstract representation of an ECLIPSE-style result set.
     struct ResultSet
@@ -156,6 +159,23 @@ namespace Opm { namespace EclIO { namespace OutputStream {
                          const Formatted& fmt,
                          const Unified&   unif);
 
+        /// Constructor.
+        ///
+        /// As above, but optionally creating a compressed binary restart
+        /// file in which every array is compressed separately.  Readers
+        /// such as ERst handle these files transparently.  Compression
+        /// does not apply to formatted files, and output appended to an
+        /// existing unified restart file uses the compression of that
+        /// file.
+        ///
+        /// \param[in] comp Whether or not to create compressed output
+        ///    files.
+        explicit Restart(const ResultSet&  rset,
+                         const int         seqnum,
+                         const Formatted&  fmt,
+                         const Unified&    unif,
+                         const Compressed& comp);
+
         ~Restart();
 
         Restart(const Restart& rhs) = delete;
@@ -221,6 +241,36 @@ namespace Opm { namespace EclIO { namespace OutputStream {
         void write(const std::string&                        kw,
                    const std::vector<PaddedOutputString<8>>& data);
 
+        /// Callback producing output values in blocks.  Call
+        /// fill(first, num, dst) stores values first, ..., first+num-1
+        /// at dst.
+        template <typename T>
+        using BlockFill = std::function<void(std::size_t first, std::size_t num, T* dst)>;
+
+        /// Write single precision floating point data, produced block by
+        /// block while writing, to underlying output stream.
+        ///
+        /// \param[in] kw Name of output vector (keyword).
+        ///
+        /// \param[in] size Number of output values.
+        ///
+        /// \param[in] fill Callback producing the output values.
+        void write(const std::string&      kw,
+                   const std::size_t       size,
+                   const BlockFill<float>& fill);
+
+        /// Write double precision floating point data, produced block by
+        /// block while writing, to underlying output stream.
+        ///
+        /// \param[in] kw Name of output vector (keyword).
+        ///
+        /// \param[in] size Number of output values.
+        ///
+        /// \param[in] fill Callback producing the output values.
+        void write(const std::string&       kw,
+                   const std::size_t        size,
+                   const BlockFill<double>& fill);
+
     private:
         /// Restart output stream.
         std::unique_ptr<EclOutput> stream_;
@@ -235,10 +285,14 @@ namespace Opm { namespace EclIO { namespace OutputStream {
         /// \param[in] formatted Whether or not to create a
         ///    formatted output file.
         ///
+        /// \param[in] compressed Whether or not to create a
+        ///    compressed output file if none exists.
+        ///
         /// \param[in] seqnum Sequence number of new report.  One-based
         ///    report step ID.
         void openUnified(const std::string& fname,
                          const bool         formatted,
+                         const bool         compressed,
                          const int          seqnum);
 
         /// Open new output stream.
@@ -250,8 +304,12 @@ namespace Opm { namespace EclIO { namespace OutputStream {
         ///
         /// \param[in] formatted Whether or not to create a
         ///    formatted output file.
+        ///
+        /// \param[in] compressed Whether or not to create a
+        ///    compressed output file.
         void openNew(const std::string& fname,
-                     const bool         formatted);
+                     const bool         formatted,
+                     const bool         compressed);
 
         /// Open existing output file and place stream's output indicator
         /// in appropriate location.
@@ -260,11 +318,15 @@ namespace Opm { namespace EclIO { namespace OutputStream {
         ///
         /// \param[in] fname Filename of output stream.
         ///
+        /// \param[in] compressed Whether or not the existing file is
+        ///    a compressed file.
+        ///
         /// \param[in] writePos Position at which to place stream's output
         ///    indicator.  Use \code streampos{ streamoff{-1} } \endcode to
         ///    place output indicator at end of file (i.e, simple append).
         void openExisting(const std::string&   fname,
                           const bool           formatted,
+                          const bool           compressed,
                           const std::streampos writePos);
 
         /// Access writable output stream.
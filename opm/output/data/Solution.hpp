@@ -55,6 +55,9 @@ class Solution : public std::map< std::string, data::CellData > {
         void convertToSI( const UnitSystem& );
         void convertFromSI( const UnitSystem& );
 
+        // whether the data are currently in SI units
+        bool isSI() const;
+
     private:
         bool si = true;
 };
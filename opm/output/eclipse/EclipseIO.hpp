@@ -22,6 +22,7 @@
 #ifndef OPM_ECLIPSE_WRITER_HPP
 #define OPM_ECLIPSE_WRITER_HPP
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -34,10 +35,7 @@
 #include <opm/output/data/Solution.hpp>
 #include <opm/output/data/Wells.hpp>
 #include <opm/output/eclipse/RestartValue.hpp>
-
-namespace Opm { namespace out {
-    class Summary;
-}} // namespace Opm::out
+#include <opm/output/eclipse/Summary.hpp>
 
 namespace Opm {
 
@@ -182,6 +180,57 @@ public:
                         const bool write_double = false);
 
 
+    /*
+      Asynchronous output.
+
+      When enabled, writeTimeStep() takes a copy of the SummaryState, takes
+      over the RestartValue (pass it with std::move() to avoid a copy) and
+      returns as soon as the output request is queued.  The summary, restart
+      and RFT files are then written by a background thread, in the order
+      the requests were made, while the simulator continues.  The writer
+      thread does not start OpenMP threads of its own.
+
+      At most maxQueued requests wait in the queue; writeTimeStep() blocks
+      while the queue is full.  An exception thrown by the writer thread is
+      rethrown from the next call to writeTimeStep() or flush().  The
+      EclipseState and Schedule passed to the constructor must not be
+      modified while output is pending.
+
+      Calling enableAsyncOutput(0) waits for pending output and returns to
+      synchronous output.
+    */
+    struct AsyncOutputStatistics {
+        std::size_t submitted = 0;     // requests queued
+        std::size_t completed = 0;     // requests written
+        std::size_t maxQueued = 0;     // largest number of waiting requests
+        std::size_t stalls = 0;        // writeTimeStep() calls blocked by a full queue
+        double stallSeconds = 0.0;     // total time blocked
+    };
+
+    void enableAsyncOutput(std::size_t maxQueued = 2);
+    bool asyncOutput() const;
+
+    /// Wait until all queued output has been written, and write the
+    /// ministeps held back by the summary flush policy.
+    void flush();
+
+    AsyncOutputStatistics asyncOutputStatistics() const;
+
+    /*
+      Flush policy of the summary file, see out::Summary::FlushPolicy.
+      Summary output of substeps only counts towards the ministep and time
+      criteria, the report step criterion applies to the other steps.
+    */
+    void setSummaryFlushPolicy(const out::Summary::FlushPolicy& policy);
+
+    /*
+      Write binary restart files with every array compressed separately,
+      see EclIO::OutputStream::Restart.  Output appended to an existing
+      unified restart file keeps the compression of that file.
+    */
+    void enableCompressedRestart(bool enable = true);
+
+
     /*
       Will load solution data and wellstate from the restart
       file. This method will consult the IOConfig object to get
@@ -221,6 +270,7 @@ public:
       (there will *not* be an empty vector in the return value).
     */
     RestartValue loadRestart(SummaryState& summary_state, const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys = {}) const;
+    // waits for pending asynchronous output
     const out::Summary& summary();
 
     EclipseIO( const EclipseIO& ) = delete;
@@ -72,7 +72,7 @@ namespace Opm { namespace RestartIO {
     void save(EclIO::OutputStream::Restart& rstFile,
               int                           report_step,
               double                        seconds_elapsed,
-              RestartValue                  value,
+              const RestartValue&           value,
               const EclipseState&           es,
               const EclipseGrid&            grid,
               const Schedule&               schedule,
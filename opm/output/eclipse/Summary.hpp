@@ -20,6 +20,7 @@
 #ifndef OPM_OUTPUT_SUMMARY_HPP
 #define OPM_OUTPUT_SUMMARY_HPP
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -66,7 +67,46 @@ public:
               const RegionParameters&        region_values = {},
               const BlockValues&             block_values  = {}) const;
 
+    /*
+      Output of ministeps to the summary file is governed by a flush
+      policy.  Ministeps added with add_timestep() are kept in memory until
+      the policy asks for a flush, at which point all of them are written
+      and the file is flushed.  A flush happens in write() when any of the
+      enabled criteria is met:
+
+        ministeps   - at least this many ministeps are pending (0 disables)
+        seconds     - at least this long since the previous flush (0 disables)
+        reportSteps - write() is called at the end of a report step
+
+      The default policy flushes every ministep.  The file always ends with
+      complete SEQHDR/MINISTEP/PARAMS groups after a flush, so a crash loses
+      only the pending ministeps.  Pending ministeps are written by flush(),
+      and those passed to write() also when the object is destroyed.
+    */
+    struct FlushPolicy {
+        std::size_t ministeps = 1;
+        double seconds = 0.0;
+        bool reportSteps = false;
+    };
+
+    struct FlushStatistics {
+        std::size_t flushes = 0;           // flushes of the summary file
+        std::size_t ministepsWritten = 0;  // ministeps written by those flushes
+        double writeSeconds = 0.0;         // time spent writing ministeps
+        double flushSeconds = 0.0;         // time spent flushing the stream
+    };
+
+    // Same as write(true).
     void write() const;
+    void write(bool isReportStep) const;
+    void flush() const;
+
+    void setFlushPolicy(const FlushPolicy& policy);
+    FlushStatistics flushStatistics() const;
+
+    // Evaluate the summary vectors in parallel (OpenMP) in eval().  The
+    // results are identical to those of the serial evaluation.
+    void enableParallelEvaluation(bool enable = true);
 
 private:
     class SummaryImplementation;
@@ -130,6 +130,12 @@ namespace Opm {
                  const std::string& dataFile,
                  const std::string& inputPath,
                  size_t accessCount);
+            Deck(std::vector<DeckKeyword>&& keywords,
+                 const UnitSystem& defUnits,
+                 const UnitSystem* activeUnits,
+                 const std::string& dataFile,
+                 const std::string& inputPath,
+                 size_t accessCount);
 
             Deck& operator=(const Deck& rhs);
             bool operator==(const Deck& data) const;
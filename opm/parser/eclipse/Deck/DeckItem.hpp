@@ -20,6 +20,7 @@
 #ifndef DECKITEM_HPP
 #define DECKITEM_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <memory>
@@ -44,10 +45,10 @@ namespace Opm {
         DeckItem( const std::string&, UDAValue) = delete;
         DeckItem( const std::string&, UDAValue, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
         DeckItem( const std::string&, double, const std::vector<Dimension>& active_dim, const std::vector<Dimension>& default_dim);
-        DeckItem(const std::vector<double>& dVec,
-                 const std::vector<int>& iVec,
-                 const std::vector<std::string>& sVec,
-                 const std::vector<UDAValue>& uVec,
+        DeckItem(std::vector<double> dVec,
+                 std::vector<int> iVec,
+                 std::vector<std::string> sVec,
+                 std::vector<UDAValue> uVec,
                  type_tag type,
                  const std::string& itemName,
                  const std::vector<value::status>& valueStat,
@@ -82,7 +83,9 @@ namespace Opm {
 
         template< typename T > const std::vector< T >& getData() const;
         const std::vector< double >& getSIDoubleData() const;
-        const std::vector<value::status>& getValueStatus() const;
+        // the status of each value, expanded from the runs on every call
+        std::vector<value::status> getValueStatus() const;
+        value::status status( std::size_t index ) const;
 
         void push_back( UDAValue );
         void push_back( int );
@@ -101,6 +104,9 @@ namespace Opm {
         template <typename T>
         void push_backDummyDefault();
 
+        // reserve space for n values of the item's type
+        void reserve( std::size_t n );
+
         type_tag getType() const;
 
         void write(DeckOutput& writer) const;
@@ -125,6 +131,23 @@ namespace Opm {
         */
         bool operator==(const DeckItem& other) const;
         bool operator!=(const DeckItem& other) const;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(dval);
+            serializer(ival);
+            serializer(sval);
+            serializer.vector(uval);
+            serializer(type);
+            serializer(item_name);
+            serializer(status_ends);
+            serializer(status_runs);
+            serializer(raw_data);
+            serializer.vector(active_dimensions);
+            serializer.vector(default_dimensions);
+        }
+
         static bool to_bool(std::string string_value);
 
         const std::vector<double>& dVal() const;
@@ -132,7 +155,7 @@ namespace Opm {
         const std::vector<std::string>& sVal() const;
         const std::vector<UDAValue>& uVal() const;
 
-        const std::vector<value::status>& valueStatus() const;
+        std::vector<value::status> valueStatus() const;
         bool rawData() const;
         const std::vector<Dimension>& activeDimensions() const;
         const std::vector<Dimension>& defaultDimensions() const;
@@ -153,7 +176,15 @@ namespace Opm {
         type_tag type = type_tag::unknown;
 
         std::string item_name;
-        std::vector<value::status> value_status;
+
+        /*
+          The status of the values is run-length encoded: the values before
+          status_ends[0] have status status_runs[0], the values from there up
+          to status_ends[1] status_runs[1] and so on. Large arrays are almost
+          entirely deck values and need a single run.
+        */
+        std::vector<std::size_t> status_ends;
+        std::vector<value::status> status_runs;
         /*
           To save space we mutate the dval object in place when asking for SI
           data; the current state of of the dval member is tracked with the
@@ -169,6 +200,9 @@ namespace Opm {
         template< typename T > void push( T, size_t );
         template< typename T > void push_default( T );
         template< typename T > void write_vector(DeckOutput& writer, const std::vector<T>& data) const;
+
+        void push_status( value::status st, std::size_t n = 1 );
+        template< typename Convert > void convert_dimensions( Convert&& convert ) const;
     };
 }
 #endif  /* DECKITEM_HPP */
@@ -75,7 +75,7 @@ namespace Opm {
         const std::vector<double>& getRawDoubleData() const;
         const std::vector<double>& getSIDoubleData() const;
         const std::vector<std::string>& getStringData() const;
-        const std::vector<value::status>& getValueStatus() const;
+        std::vector<value::status> getValueStatus() const;
         size_t getDataSize() const;
         void write( DeckOutput& output ) const;
         void write_data( DeckOutput& output ) const;
@@ -96,6 +96,17 @@ namespace Opm {
         bool operator==(const DeckKeyword& other) const;
         bool operator!=(const DeckKeyword& other) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_keywordName);
+            serializer(m_location);
+            serializer.vector(m_recordList);
+            serializer(m_isDataKeyword);
+            serializer(m_slashTerminated);
+            serializer(m_isDoubleRecordKeyword);
+        }
+
         friend std::ostream& operator<<(std::ostream& os, const DeckKeyword& keyword);
     private:
         std::string m_keywordName;
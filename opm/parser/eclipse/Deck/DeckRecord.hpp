@@ -70,6 +70,12 @@ namespace Opm {
         bool operator==(const DeckRecord& other) const;
         bool operator!=(const DeckRecord& other) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer.vector(m_items);
+        }
+
         const std::vector<DeckItem>& getItems() const;
 
     private:
@@ -40,7 +40,7 @@ public:
     const AquiferCT& ct() const;
     const Aquifetp& fetp() const;
     const Aquancon& connections() const;
-    bool operator==(const AquiferConfig& other);
+    bool operator==(const AquiferConfig& other) const;
 
     template<class Serializer>
     void serializeOp(Serializer& serializer)
@@ -133,6 +133,9 @@ namespace Opm {
         }
 
     private:
+        // packs the input grid and field properties as well
+        friend class BinarySerializer;
+
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
         void initFaults(const Deck& deck);
@@ -29,6 +29,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
 
 #include <opm/io/eclipse/EclFile.hpp>
+#include <opm/common/utility/numeric/calculateCellGeometry.hpp>
 
 #include <array>
 #include <memory>
@@ -164,6 +165,13 @@ namespace Opm {
         bool cellActive( size_t i , size_t j, size_t k ) const;
         double getCellDepth(size_t i,size_t j, size_t k) const;
         double getCellDepth(size_t globalIndex) const;
+
+        /// Geometry of all active cells, or of the active cells with
+        /// active index in [activeBegin, activeEnd), calculated in bulk.
+        CellGeometry getCellGeometry(unsigned quantities = CellGeometry::All) const;
+        CellGeometry getCellGeometry(std::size_t activeBegin, std::size_t activeEnd,
+                                     unsigned quantities = CellGeometry::All) const;
+
         ZcornMapper zcornMapper() const;
 
         const std::vector<double>& getCOORD() const;
@@ -189,6 +197,28 @@ namespace Opm {
 
         bool equal(const EclipseGrid& other) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            GridDims::serializeOp(serializer);
+            serializer(m_minpvVector);
+            serializer(m_minpvMode);
+            m_pinch.serializeOp(serializer);
+            serializer(m_pinchoutMode);
+            serializer(m_multzMode);
+            serializer(m_circle);
+            serializer(zcorn_fixed);
+            serializer(m_useActnumFromGdfile);
+            serializer(m_zcorn);
+            serializer(m_coord);
+            serializer(m_mapaxes);
+            serializer(m_actnum);
+            serializer(m_mapunits);
+            serializer(m_nactive);
+            serializer(m_active_to_global);
+            serializer(m_global_to_active);
+        }
+
     private:
         std::vector<double> m_minpvVector;
         MinpvMode::ModeEnum m_minpvMode;
@@ -24,6 +24,7 @@
 
 namespace Opm {
 
+class BinarySerializer;
 class EclipseGrid;
 class Deck;
 class FieldProps;
@@ -68,6 +69,13 @@ public:
     virtual std::vector<double> porv(bool global = false) const;
     MemInfo meminfo( ) const;
 
+    /*
+      Pack or unpack the field properties with the BinarySerializer. When
+      unpacking, the properties refer to the grid and tables passed in,
+      which should be those of the owning EclipseState.
+    */
+    void serialize(BinarySerializer& serializer, const EclipseGrid& grid, const TableManager& tables);
+
     /*
      The number of cells in the fields managed by this FieldPropsManager.
      Initially this will correspond to the number of active cells in the grid
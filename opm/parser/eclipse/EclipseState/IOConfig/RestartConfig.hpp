@@ -302,6 +302,16 @@ namespace Opm {
             bool operator!=(const RestartSchedule& rhs) const;
             bool operator==( const RestartSchedule& rhs ) const;
 
+            template<class Serializer>
+            void serializeOp(Serializer& serializer)
+            {
+                serializer(timestep);
+                serializer(basic);
+                serializer(frequency);
+                serializer(rptsched_restart_set);
+                serializer(rptsched_restart);
+            }
+
 
 
         //private:
@@ -348,6 +358,17 @@ namespace Opm {
         const std::vector<bool>& saveKeywords() const;
 
         bool operator==(const RestartConfig& data) const;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_timemap);
+            serializer(m_first_restart_step);
+            serializer(m_write_initial_RST_file);
+            serializer(restart_schedule);
+            serializer(restart_keywords);
+            serializer(save_keywords);
+        }
     private:
 
 
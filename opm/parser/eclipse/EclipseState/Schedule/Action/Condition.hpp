@@ -46,6 +46,13 @@ public:
         return quantity == data.quantity &&
                args == data.args;
     }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(quantity);
+        serializer(args);
+    }
 };
 
 
@@ -80,6 +87,16 @@ enum class Comparator {
     std::string cmp_string;
 
     bool operator==(const Condition& data) const;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(lhs);
+        serializer(rhs);
+        serializer(logic);
+        serializer(cmp);
+        serializer(cmp_string);
+    }
 };
 
 
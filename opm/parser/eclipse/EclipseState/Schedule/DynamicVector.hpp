@@ -72,6 +72,12 @@ namespace Opm {
             return this->data() == data.data();
         }
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer.vector(m_data);
+        }
+
     private:
         std::vector<T> m_data;
     };
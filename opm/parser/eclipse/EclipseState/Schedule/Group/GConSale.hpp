@@ -52,6 +52,17 @@ namespace Opm {
                        udq_undefined == data.udq_undefined &&
                        unit_system == data.unit_system;
             }
+
+            template<class Serializer>
+            void serializeOp(Serializer& serializer)
+            {
+                serializer(sales_target);
+                serializer(max_sales_rate);
+                serializer(min_sales_rate);
+                serializer(max_proc);
+                serializer(udq_undefined);
+                serializer(unit_system);
+            }
         };
 
         struct GCONSALEGroupProp {
@@ -75,6 +86,12 @@ namespace Opm {
 
         bool operator==(const GConSale& data) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer.map(groups);
+        }
+
     private:
         std::map<std::string, GCONSALEGroup> groups;
     };
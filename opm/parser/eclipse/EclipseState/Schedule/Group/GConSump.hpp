@@ -45,6 +45,16 @@ namespace Opm {
                        udq_undefined == data.udq_undefined &&
                        unit_system == data.unit_system;
             }
+
+            template<class Serializer>
+            void serializeOp(Serializer& serializer)
+            {
+                serializer(consumption_rate);
+                serializer(import_rate);
+                serializer(network_node);
+                serializer(udq_undefined);
+                serializer(unit_system);
+            }
         };
 
         struct GCONSUMPGroupProp {
@@ -66,6 +76,12 @@ namespace Opm {
 
         bool operator==(const GConSump& data) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer.map(groups);
+        }
+
     private:
         std::map<std::string, GCONSUMPGroup> groups;
     };
@@ -117,6 +117,20 @@ struct GroupInjectionProperties {
     int injection_controls = 0;
     bool operator==(const GroupInjectionProperties& other) const;
     bool operator!=(const GroupInjectionProperties& other) const;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(phase);
+        serializer(cmode);
+        serializer(surface_max_rate);
+        serializer(resv_max_rate);
+        serializer(target_reinj_fraction);
+        serializer(target_void_fraction);
+        serializer(reinj_group);
+        serializer(voidage_group);
+        serializer(injection_controls);
+    }
 };
 
 struct InjectionControls {
@@ -146,6 +160,21 @@ struct GroupProductionProperties {
     int production_controls = 0;
     bool operator==(const GroupProductionProperties& other) const;
     bool operator!=(const GroupProductionProperties& other) const;
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(cmode);
+        serializer(exceed_action);
+        serializer(oil_target);
+        serializer(water_target);
+        serializer(gas_target);
+        serializer(liquid_target);
+        serializer(guide_rate);
+        serializer(guide_rate_def);
+        serializer(resv_target);
+        serializer(production_controls);
+    }
 };
 
 struct ProductionControls {
@@ -240,6 +269,27 @@ struct ProductionControls {
     const Phase& topup_phase() const;
     bool has_topup_phase() const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(m_name);
+        serializer(m_insert_index);
+        serializer(init_step);
+        serializer(udq_undefined);
+        serializer(unit_system);
+        serializer(group_type);
+        serializer(gefac);
+        serializer(transfer_gefac);
+        serializer(available_for_group_control);
+        serializer(vfp_table);
+        serializer(parent_group);
+        serializer(m_wells);
+        serializer(m_groups);
+        serializer.map(injection_properties);
+        serializer(production_properties);
+        serializer(m_topup_phase);
+    }
+
 private:
     bool hasType(GroupType gtype) const;
     void addType(GroupType new_gtype);
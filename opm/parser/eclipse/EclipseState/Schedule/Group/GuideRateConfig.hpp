@@ -44,6 +44,14 @@ public:
                target == data.target &&
                scaling_factor == data.scaling_factor;
     }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(guide_rate);
+        serializer(target);
+        serializer(scaling_factor);
+    }
 };
 
 struct GroupTarget {
@@ -54,6 +62,13 @@ struct GroupTarget {
         return guide_rate == data.guide_rate &&
                target == data.target;
     }
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(guide_rate);
+        serializer(target);
+    }
 };
 
     GuideRateConfig() = default;
@@ -77,6 +92,14 @@ struct GroupTarget {
 
     bool operator==(const GuideRateConfig& data) const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(m_model);
+        serializer.map(wells);
+        serializer.map(groups);
+    }
+
 private:
     std::shared_ptr<GuideRateModel> m_model;
     std::unordered_map<std::string, WellTarget> wells;
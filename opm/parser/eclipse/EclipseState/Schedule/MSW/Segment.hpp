@@ -100,6 +100,25 @@ namespace Opm {
         void updateSpiralICD(const SpiralICD& spiral_icd);
         void updateValve(const Valve& valve, const double segment_length);
         void addInletSegment(const int segment_number);
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_segment_number);
+            serializer(m_branch);
+            serializer(m_outlet_segment);
+            serializer(m_inlet_segments);
+            serializer(m_total_length);
+            serializer(m_depth);
+            serializer(m_internal_diameter);
+            serializer(m_roughness);
+            serializer(m_cross_area);
+            serializer(m_volume);
+            serializer(m_data_ready);
+            serializer(m_segment_type);
+            serializer(m_spiral_icd);
+            serializer(m_valve);
+        }
     private:
         // segment number
         // it should work as a ID.
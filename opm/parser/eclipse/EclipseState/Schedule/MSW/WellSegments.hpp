@@ -93,8 +93,17 @@ namespace Opm {
         const std::vector<Segment>& segments() const;
 
         bool updateWSEGVALV(const std::vector<std::pair<int, Valve> >& valve_pairs);
+
         const std::vector<Segment>::const_iterator begin() const;
         const std::vector<Segment>::const_iterator end() const;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_comp_pressure_drop);
+            serializer.vector(m_segments);
+            serializer(segment_number_to_index);
+        }
     private:
         void processABS();
         void processINC(double depth_top, double length_top);
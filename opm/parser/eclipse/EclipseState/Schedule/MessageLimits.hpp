@@ -57,6 +57,23 @@ namespace Opm {
                      (this->bug_stop_limit      == other.bug_stop_limit     ));
         }
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(message_print_limit);
+            serializer(comment_print_limit);
+            serializer(warning_print_limit);
+            serializer(problem_print_limit);
+            serializer(error_print_limit);
+            serializer(bug_print_limit);
+            serializer(message_stop_limit);
+            serializer(comment_stop_limit);
+            serializer(warning_stop_limit);
+            serializer(problem_stop_limit);
+            serializer(error_stop_limit);
+            serializer(bug_stop_limit);
+        }
+
         bool operator!=(const MLimits& other) const {
             return !(*this == other);
         }
@@ -108,6 +125,12 @@ namespace Opm {
         const DynamicState<MLimits>& getLimits() const;
         bool operator==(const MessageLimits& data) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(limits);
+        }
+
     private:
         void update(size_t timestep, const MLimits& value);
 
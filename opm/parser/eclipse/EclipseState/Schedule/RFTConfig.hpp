@@ -90,6 +90,18 @@ public:
 
     bool operator==(const RFTConfig& data) const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(tm);
+        serializer(first_rft_event);
+        serializer(well_open_rft_time);
+        serializer(well_open_rft_name);
+        serializer(well_open);
+        serializer.map(rft_config);
+        serializer.map(plt_config);
+    }
+
 private:
     template <typename Value>
     using ConfigMap = std::unordered_map<
@@ -22,9 +22,12 @@
 
 #include <string>
 #include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <iosfwd>
 
 namespace Opm{
@@ -60,13 +63,64 @@ namespace Opm{
       // accessible through the specialized st.has_well_var("OPY", "WGOR").
       st.has("WGOR:OPY") => True
       st.has_well_var("OPY", "WGOR") => False
+
+  The values are stored in a contiguous vector, one slot per key.  A key is
+  registered the first time it is updated, or explicitly with handle(),
+  well_handle() or group_handle(), and the returned handle is the index of
+  its slot.  Handles stay valid for the lifetime of the object, also across
+  deserialize(), and are valid in copies of the object.  Code which accesses
+  the same keys repeatedly can hold on to the handles and skip the string
+  lookups:
+
+      auto h = st.well_handle("OPX", "WWCT");
+      st.update(h, 0.75);
+      st.get(h) => 0.75
+      st.get_well_var("OPX", "WWCT") => 0.75
+
+  Registering a key does not give it a value; has() is false until the key
+  has been updated.  The layout() number identifies the set of registered
+  keys, two objects with the same layout() have the same handles for all
+  keys.
 */
 
 class SummaryState {
 public:
-    typedef std::unordered_map<std::string, double>::const_iterator const_iterator;
+    using Handle = std::size_t;
+    static constexpr Handle invalid_handle = std::numeric_limits<Handle>::max();
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const std::string&, double>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        value_type operator*() const;
+        const_iterator& operator++();
+        bool operator==(const const_iterator& other) const { return this->pos == other.pos; }
+        bool operator!=(const const_iterator& other) const { return this->pos != other.pos; }
+
+    private:
+        friend class SummaryState;
+        const_iterator(const SummaryState* st_arg, Handle pos_arg);
+
+        const SummaryState* st;
+        Handle pos;
+    };
+
     explicit SummaryState(std::chrono::system_clock::time_point sim_start_arg);
 
+    Handle handle(const std::string& key);
+    Handle well_handle(const std::string& well, const std::string& var);
+    Handle group_handle(const std::string& group, const std::string& var);
+    Handle find_handle(const std::string& key) const;   // invalid_handle if not registered
+    std::size_t layout() const { return this->m_layout; }
+
+    bool has(Handle handle) const { return this->m_defined[handle] != 0; }
+    double get(Handle handle) const { return this->m_values[handle]; }
+    void update(Handle handle, double value);
+
     /*
       The set() function has to be retained temporarily to support updating of
       cumulatives from restart files.
@@ -98,17 +152,34 @@ public:
     std::size_t num_wells() const;
     std::size_t size() const;
 private:
+    using VarMap = std::unordered_map<std::string, std::unordered_map<std::string, Handle>>;
+
     std::chrono::system_clock::time_point sim_start;
     double elapsed = 0;
-    std::unordered_map<std::string,double> values;
+
+    // Indexed by handle.
+    std::vector<std::string> m_keys;
+    std::vector<double> m_values;
+    std::vector<char> m_defined;
+    std::vector<char> m_total;
+    std::vector<Handle> m_general;     // well and group variables: slot of "var:name"
+    std::size_t m_size = 0;
+    std::size_t m_layout;
+
+    std::unordered_map<std::string, Handle> m_index;
 
     // The first key is the variable and the second key is the well.
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> well_values;
-    std::unordered_set<std::string> m_wells;
+    VarMap well_values;
 
     // The first key is the variable and the second key is the group.
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> group_values;
-    std::unordered_set<std::string> m_groups;
+    VarMap group_values;
+
+    Handle add_slot(const std::string& key, Handle general);
+    Handle var_handle(VarMap& var_map, const std::string& name, const std::string& var);
+    void define(Handle handle);
+    void set(Handle handle, double value);
+    std::vector<std::string> names(const VarMap& var_map) const;
+    std::vector<std::string> names(const VarMap& var_map, const std::string& var) const;
 };
 
 
@@ -63,6 +63,16 @@ namespace Opm {
         const std::vector<std::time_t>& timeList() const;
         bool operator==(const TimeMap& data) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_timeList);
+            serializer.vector(m_first_timestep_years);
+            serializer.vector(m_first_timestep_months);
+            serializer(m_skiprest);
+            serializer(m_restart_offset);
+        }
+
         /// Return true if the given timestep is the first one of a new month or year, or if frequency > 1,
         /// return true if the step is the first of each n-month or n-month period, starting from start_timestep - 1.
         bool isTimestepInFirstOfMonthsYearsSequence(size_t timestep, bool years = true, size_t start_timestep = 1, size_t frequency = 1) const;
@@ -85,6 +95,13 @@ namespace Opm {
                 return stepnumber == data.stepnumber &&
                        timestamp == data.timestamp;
             }
+
+            template<class Serializer>
+            void serializeOp(Serializer& serializer)
+            {
+                serializer(stepnumber);
+                serializer(timestamp);
+            }
         };
 
         bool isTimestepInFreqSequence (size_t timestep, size_t start_timestep, size_t frequency, bool years) const;
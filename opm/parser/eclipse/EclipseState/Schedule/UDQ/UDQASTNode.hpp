@@ -65,6 +65,7 @@ public:
     template<class Serializer>
     void serializeOp(Serializer& serializer)
     {
+        serializer(var_type);
         serializer(type);
         serializer(string_value);
         serializer(selector);
@@ -38,6 +38,12 @@ public:
     const std::map<std::string,WList>& lists() const;
     bool operator==(const WListManager& data) const;
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer.map(wlists);
+    }
+
 private:
     std::map<std::string, WList> wlists;
 };
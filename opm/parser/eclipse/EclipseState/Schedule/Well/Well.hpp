@@ -161,6 +161,15 @@ public:
                    guide_phase == data.guide_phase &&
                    scale_factor == data.scale_factor;
         }
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(available);
+            serializer(guide_rate);
+            serializer(guide_phase);
+            serializer(scale_factor);
+        }
     };
 
 
@@ -214,6 +223,26 @@ public:
         bool operator==(const WellInjectionProperties& other) const;
         bool operator!=(const WellInjectionProperties& other) const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(name);
+            serializer(surfaceInjectionRate);
+            serializer(reservoirInjectionRate);
+            serializer(BHPTarget);
+            serializer(THPTarget);
+            serializer(bhp_hist_limit);
+            serializer(thp_hist_limit);
+            serializer(temperature);
+            serializer(BHPH);
+            serializer(THPH);
+            serializer(VFPTableNumber);
+            serializer(predictionMode);
+            serializer(injectionControls);
+            serializer(injectorType);
+            serializer(controlMode);
+        }
+
         WellInjectionProperties();
         WellInjectionProperties(const UnitSystem& units, const std::string& wname);
         WellInjectionProperties(const std::string& wname,
@@ -369,6 +398,29 @@ public:
         void setBHPLimit(const double limit);
         int productionControls() const { return this->m_productionControls; }
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(name);
+            serializer(OilRate);
+            serializer(WaterRate);
+            serializer(GasRate);
+            serializer(LiquidRate);
+            serializer(ResVRate);
+            serializer(BHPTarget);
+            serializer(THPTarget);
+            serializer(bhp_hist_limit);
+            serializer(thp_hist_limit);
+            serializer(BHPH);
+            serializer(THPH);
+            serializer(VFPTableNumber);
+            serializer(ALQValue);
+            serializer(predictionMode);
+            serializer(controlMode);
+            serializer(whistctl_cmode);
+            serializer(m_productionControls);
+        }
+
     private:
         int m_productionControls = 0;
         void init_rates( const DeckRecord& record );
@@ -540,6 +592,39 @@ public:
 
     bool operator==(const Well& data) const;
     void setInsertIndex(std::size_t index);
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(wname);
+        serializer(group_name);
+        serializer(init_step);
+        serializer(insert_index);
+        serializer(headI);
+        serializer(headJ);
+        serializer(ref_depth);
+        serializer(ordering);
+        serializer(unit_system);
+        serializer(udq_undefined);
+        serializer(status);
+        serializer(drainage_radius);
+        serializer(allow_cross_flow);
+        serializer(automatic_shutin);
+        serializer(wtype);
+        serializer(guide_rate);
+        serializer(efficiency_factor);
+        serializer(solvent_fraction);
+        serializer(prediction_mode);
+        serializer(econ_limits);
+        serializer(foam_properties);
+        serializer(polymer_properties);
+        serializer(brine_properties);
+        serializer(tracer_properties);
+        serializer(connections);
+        serializer(production);
+        serializer(injection);
+        serializer(segments);
+    }
 private:
     void switchToInjector();
     void switchToProducer();
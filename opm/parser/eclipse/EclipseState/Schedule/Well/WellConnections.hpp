@@ -93,6 +93,15 @@ namespace Opm {
         size_t getNumRemoved() const;
         const std::vector<Connection>& getConnections() const;
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(headI);
+            serializer(headJ);
+            serializer(num_removed);
+            serializer.vector(m_connections);
+        }
+
     private:
         void addConnection(int i, int j , int k ,
                            int complnum,
@@ -44,6 +44,16 @@ namespace Opm {
         void handleWPOLYMER(const DeckRecord& record);
         void handleWPMITAB(const DeckRecord& record);
         void handleWSKPTAB(const DeckRecord& record);
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(m_polymerConcentration);
+            serializer(m_saltConcentration);
+            serializer(m_plymwinjtable);
+            serializer(m_skprwattable);
+            serializer(m_skprpolytable);
+        }
     };
 }
 
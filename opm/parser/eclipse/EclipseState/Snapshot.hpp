@@ -0,0 +1,75 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SNAPSHOT_HPP
+#define OPM_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace Opm {
+
+class EclipseState;
+class Schedule;
+class SummaryConfig;
+
+/*
+  A snapshot file holds a fully constructed EclipseState, Schedule and
+  SummaryConfig, so that a simulation can start without parsing the deck
+  and building the Schedule again:
+
+     Snapshot::save("CASE.SNAPSHOT", es, schedule, summary_config);
+     ...
+     EclipseState es;
+     Schedule schedule;
+     SummaryConfig summary_config;
+     Snapshot::load("CASE.SNAPSHOT", es, schedule, summary_config);
+
+  The objects are written with the BinarySerializer through their
+  serializeOp() hooks, i.e. the content is the same as when the objects are
+  broadcast with MPI. In addition the snapshot holds the input grid and the
+  field properties of the EclipseState, which the broadcast leaves out.
+
+  The file starts with a header:
+
+    magic "OPMSNAP1" (8 bytes), format version (uint32),
+    byte order mark (uint32), payload size (uint64)
+
+  The payload is in native byte order, and load() throws if the header does
+  not match - the snapshot must then be created again from the deck. The
+  objects passed to load() must be default constructed.
+*/
+
+namespace Snapshot {
+
+    constexpr std::uint32_t formatVersion = 2;
+
+    void save(const std::string& fileName,
+              const EclipseState& es,
+              const Schedule& schedule,
+              const SummaryConfig& summary_config);
+
+    void load(const std::string& fileName,
+              EclipseState& es,
+              Schedule& schedule,
+              SummaryConfig& summary_config);
+}
+}
+
+#endif
@@ -61,6 +61,7 @@ namespace Opm {
         double eval( const TableIndex& index) const;
         void applyDefaults( const TableColumn& argColumn );
         void assertUnitRange() const;
+        TableColumn(const TableColumn& other) = default;
         TableColumn& operator= (const TableColumn& other);
 
         std::vector<double> vectorCopy() const;
@@ -102,6 +102,7 @@ namespace Opm {
                      std::size_t gas_comp_index,
                      double rtemp);
 
+        TableManager(const TableManager& data) = default;
         TableManager& operator=(const TableManager& data);
 
         const TableContainer& getTables( const std::string& tableName ) const;
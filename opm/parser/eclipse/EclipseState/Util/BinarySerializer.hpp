@@ -0,0 +1,354 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BINARY_SERIALIZER_HPP
+#define OPM_BINARY_SERIALIZER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+class Deck;
+class EclipseState;
+class UnitSystem;
+
+/*
+  The BinarySerializer packs objects into a byte buffer, and unpacks them
+  again, through the serializeOp() hooks of the classes:
+
+     BinarySerializer packer;
+     packer.pack(schedule);
+     ...
+     BinarySerializer unpacker(packer.buffer());
+     Schedule copy;
+     unpacker.unpack(copy);
+
+  Numbers, enums and arrays of them are copied as bytes in native byte
+  order, strings and containers are prefixed with their size, and classes
+  are handled by calling serializeOp(), which in turn calls back with the
+  members. A few classes without a serializeOp() hook are handled by
+  dedicated overloads. Unpacking assigns to default constructed objects.
+
+  An object held by several shared_ptr - e.g. a Well which is unchanged
+  over many report steps in a DynamicState<std::shared_ptr<Well>> - is
+  packed once, the other pointers refer back to it by an id. Unpacking
+  gives pointers which share one object in the same way.
+*/
+
+class BinarySerializer {
+public:
+    BinarySerializer() = default;
+    explicit BinarySerializer(std::vector<char> buffer) :
+        m_buffer(std::move(buffer)),
+        m_packing(false)
+    {}
+
+    template <class T>
+    void pack(const T& data) {
+        if (!this->m_packing)
+            throw std::logic_error("BinarySerializer: pack() called on an unpacking serializer");
+        (*this)(data);
+    }
+
+    template <class T>
+    void unpack(T& data) {
+        if (this->m_packing)
+            throw std::logic_error("BinarySerializer: unpack() called on a packing serializer");
+        (*this)(data);
+    }
+
+    bool isSerializing() const {
+        return this->m_packing;
+    }
+
+    const std::vector<char>& buffer() const {
+        return this->m_buffer;
+    }
+
+    // true when unpacking has consumed the whole buffer
+    bool done() const {
+        return this->m_position == this->m_buffer.size();
+    }
+
+    template <class T>
+    void operator()(const T& data) {
+        auto& value = const_cast<T&>(data);
+
+        if constexpr (has_serializeOp<T>::value)
+            value.serializeOp(*this);
+        else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+            this->bytes(&value, sizeof value);
+        else if constexpr (is_vector<T>::value)
+            this->vector(value);
+        else if constexpr (is_array<T>::value)
+            this->array(value);
+        else if constexpr (is_map<T>::value)
+            this->map(value);
+        else if constexpr (is_set<T>::value)
+            this->set(value);
+        else if constexpr (is_pair<T>::value) {
+            (*this)(value.first);
+            (*this)(value.second);
+        }
+        else if constexpr (is_tuple<T>::value)
+            std::apply([this](auto&... elements) { ((*this)(elements), ...); }, value);
+        else if constexpr (is_optional<T>::value)
+            this->optional(value);
+        else if constexpr (is_ptr<T>::value)
+            this->ptr(value);
+        else
+            static_assert(has_serializeOp<T>::value, "BinarySerializer: no serializeOp() for this type");
+    }
+
+    void operator()(const std::string& data);
+    void operator()(const Deck& data);
+    void operator()(const EclipseState& data);
+    void operator()(const UnitSystem& data);
+
+    template <class T, class A>
+    void vector(std::vector<T, A>& data) {
+        auto size = this->containerSize(data.size());
+        if (!this->m_packing)
+            data.resize(size);
+
+        if constexpr (std::is_same<T, bool>::value) {
+            for (std::size_t i = 0; i < size; i++) {
+                bool value = data[i];
+                (*this)(value);
+                data[i] = value;
+            }
+        }
+        else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value)
+            this->bytes(data.data(), size * sizeof(T));
+        else {
+            for (auto& element : data)
+                (*this)(element);
+        }
+    }
+
+    template <class Map>
+    void map(Map& data) {
+        auto size = this->containerSize(data.size());
+        if (this->m_packing) {
+            for (const auto& pair : data) {
+                (*this)(pair.first);
+                (*this)(pair.second);
+            }
+        } else {
+            data.clear();
+            for (std::size_t i = 0; i < size; i++) {
+                typename Map::key_type key;
+                typename Map::mapped_type value;
+                (*this)(key);
+                (*this)(value);
+                data.emplace(std::move(key), std::move(value));
+            }
+        }
+    }
+
+private:
+    template <class T, class = void>
+    struct has_serializeOp : std::false_type {};
+
+    template <class T>
+    struct has_serializeOp<T, std::void_t<decltype(std::declval<T&>().serializeOp(std::declval<BinarySerializer&>()))>>
+        : std::true_type {};
+
+    template <class T> struct is_vector : std::false_type {};
+    template <class T, class A> struct is_vector<std::vector<T, A>> : std::true_type {};
+
+    template <class T> struct is_array : std::false_type {};
+    template <class T, std::size_t N> struct is_array<std::array<T, N>> : std::true_type {};
+
+    template <class T> struct is_map : std::false_type {};
+    template <class... Args> struct is_map<std::map<Args...>> : std::true_type {};
+    template <class... Args> struct is_map<std::unordered_map<Args...>> : std::true_type {};
+
+    template <class T> struct is_set : std::false_type {};
+    template <class... Args> struct is_set<std::set<Args...>> : std::true_type {};
+    template <class... Args> struct is_set<std::unordered_set<Args...>> : std::true_type {};
+
+    template <class T> struct is_pair : std::false_type {};
+    template <class T1, class T2> struct is_pair<std::pair<T1, T2>> : std::true_type {};
+
+    template <class T> struct is_tuple : std::false_type {};
+    template <class... Args> struct is_tuple<std::tuple<Args...>> : std::true_type {};
+
+    template <class T> struct is_optional : std::false_type {};
+    template <class T> struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <class T> struct is_ptr : std::false_type {};
+    template <class T> struct is_ptr<std::shared_ptr<T>> : std::true_type {};
+    template <class T, class D> struct is_ptr<std::unique_ptr<T, D>> : std::true_type {};
+
+    void bytes(void* data, std::size_t size) {
+        if (size == 0)
+            return;
+
+        if (this->m_packing) {
+            const auto* first = static_cast<const char*>(data);
+            this->m_buffer.insert(this->m_buffer.end(), first, first + size);
+        } else {
+            if (size > this->m_buffer.size() - this->m_position)
+                throw std::runtime_error("BinarySerializer: read past the end of the buffer");
+
+            std::memcpy(data, this->m_buffer.data() + this->m_position, size);
+            this->m_position += size;
+        }
+    }
+
+    // the size of a container - written when packing, returned when unpacking
+    std::size_t containerSize(std::size_t size) {
+        auto value = static_cast<std::uint64_t>(size);
+        this->bytes(&value, sizeof value);
+        if (!this->m_packing && value > this->m_buffer.size())
+            throw std::runtime_error("BinarySerializer: invalid container size");
+
+        return static_cast<std::size_t>(value);
+    }
+
+    template <class T, std::size_t N>
+    void array(std::array<T, N>& data) {
+        for (auto& element : data)
+            (*this)(element);
+    }
+
+    template <class Set>
+    void set(Set& data) {
+        auto size = this->containerSize(data.size());
+        if (this->m_packing) {
+            for (const auto& element : data)
+                (*this)(element);
+        } else {
+            data.clear();
+            for (std::size_t i = 0; i < size; i++) {
+                typename Set::value_type element;
+                (*this)(element);
+                data.insert(std::move(element));
+            }
+        }
+    }
+
+    template <class T>
+    void optional(std::optional<T>& data) {
+        bool has_value = data.has_value();
+        (*this)(has_value);
+        if (!this->m_packing) {
+            if (has_value)
+                data.emplace();
+            else
+                data.reset();
+        }
+        if (has_value)
+            (*this)(*data);
+    }
+
+    template <class Ptr>
+    void ptr(Ptr& data) {
+        using T = typename std::remove_const<typename Ptr::element_type>::type;
+        static_assert(!std::is_polymorphic<T>::value,
+                      "BinarySerializer: pointers to polymorphic types would be sliced");
+
+        bool has_value = static_cast<bool>(data);
+        (*this)(has_value);
+        if (this->m_packing) {
+            if (has_value)
+                (*this)(*data);
+        } else {
+            std::unique_ptr<T> value;
+            if (has_value) {
+                value.reset(new T());
+                (*this)(*value);
+            }
+            data = std::move(value);
+        }
+    }
+
+    // id of an object which has already been packed, or a new id followed
+    // by the object
+    template <class T>
+    void ptr(std::shared_ptr<T>& data) {
+        using U = typename std::remove_const<T>::type;
+        static_assert(!std::is_polymorphic<U>::value,
+                      "BinarySerializer: pointers to polymorphic types would be sliced");
+
+        constexpr std::uint64_t null_id = 0;
+
+        if (this->m_packing) {
+            std::uint64_t id = null_id;
+            bool first = false;
+            if (data) {
+                auto key = std::make_pair(static_cast<const void*>(data.get()), std::type_index(typeid(U)));
+                auto insert = this->m_packed_ptr.emplace(key, this->m_packed_ptr.size() + 1);
+                id = insert.first->second;
+                first = insert.second;
+
+                // keep the object alive, so its address is not reused by
+                // another object while packing
+                if (first)
+                    this->m_packed_objects.push_back(data);
+            }
+            (*this)(id);
+            if (first)
+                (*this)(*data);
+        } else {
+            std::uint64_t id;
+            (*this)(id);
+            if (id == null_id)
+                data.reset();
+            else if (id <= this->m_unpacked_ptr.size())
+                data = std::static_pointer_cast<U>(this->m_unpacked_ptr[id - 1]);
+            else if (id == this->m_unpacked_ptr.size() + 1) {
+                auto value = std::make_shared<U>();
+                this->m_unpacked_ptr.push_back(value);
+                (*this)(*value);
+                data = std::move(value);
+            } else
+                throw std::runtime_error("BinarySerializer: invalid pointer id");
+        }
+    }
+
+    std::vector<char> m_buffer;
+    std::size_t m_position = 0;
+    bool m_packing = true;
+
+    std::map<std::pair<const void*, std::type_index>, std::uint64_t> m_packed_ptr;
+    std::vector<std::shared_ptr<const void>> m_packed_objects;
+    std::vector<std::shared_ptr<void>> m_unpacked_ptr;
+};
+
+}
+
+#endif
@@ -104,6 +104,14 @@ public:
         return !(*this == rhs );
     }
 
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(m_name);
+        serializer(m_initialized);
+        serializer(m_value);
+    }
+
 
 };
 }
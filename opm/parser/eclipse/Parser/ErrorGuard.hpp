@@ -34,6 +34,9 @@ public:
 
     explicit operator bool() const { return !this->error_list.empty(); }
 
+    // true if neither errors nor warnings have been recorded
+    bool empty() const { return this->error_list.empty() && this->warning_list.empty(); }
+
     /*
       Observe that this desctructor has a somewhat special semantics. If there
       are errors in the error list it will print all warnings and errors on
@@ -20,6 +20,8 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -98,6 +100,24 @@ namespace Opm {
          */
         size_t size() const;
 
+        /*!
+         * \brief Data keywords (PORO, ZCORN, ...) with at least numChars
+         * characters of input are converted after the rest of the input has
+         * been read, in parallel when OpenMP is enabled.  Zero converts every
+         * keyword as it is read.  The resulting Deck is the same either way.
+         */
+        void setParallelThreshold(std::size_t numChars);
+
+        /*!
+         * \brief parseFile() stores the parsed Deck in a binary cache file in
+         * directory, and loads it from there as long as the data file and the
+         * files it includes are unchanged.  An empty directory, the default,
+         * disables the cache.  The keyword definitions are part of the cache
+         * key, and are hashed here: keywords added after this call are
+         * hashed again by every parseFile().
+         */
+        void setDeckCacheDirectory(const std::string& directory);
+
         template <class T>
         void addKeyword() {
             addParserKeyword( T() );
@@ -145,6 +165,14 @@ namespace Opm {
         std::map< string_view, const ParserKeyword* > m_wildCardKeywords;
 
         std::vector<std::pair<std::string,std::string>> code_keywords;
+
+        std::size_t parallel_threshold = 65536;
+        std::string deck_cache_directory;
+
+        // hash of the keyword definitions for the deck cache key, computed
+        // by setDeckCacheDirectory() and reset to zero when a keyword is added
+        std::uint64_t keyword_hash = 0;
+        std::uint64_t keywordHash() const;
     };
 
 } // namespace Opm
@@ -0,0 +1,267 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/common/utility/numeric/calculateCellGeometry.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/*
+  Cells are processed in blocks of blockSize cells.  Corner coordinates of a
+  block are gathered into local arrays indexed [corner][cell], all further
+  calculations are then loops over the cells of the block with unit stride
+  which the compiler can vectorise.
+*/
+
+constexpr std::size_t blockSize = 64;
+
+using BlockArray = double[8][blockSize];
+
+
+template <typename T>
+void blockCorners(const std::array<int, 3>& dims, const T* coord, const T* zcorn,
+                  const int* cells, std::size_t num,
+                  BlockArray& X, BlockArray& Y, BlockArray& Z)
+{
+    const std::size_t nx = dims[0];
+    const std::size_t nxy = static_cast<std::size_t>(dims[0]) * dims[1];
+
+    for (std::size_t n = 0; n < num; n++) {
+        const std::size_t glob = cells[n];
+        const std::size_t k = glob / nxy;
+        const std::size_t j = (glob % nxy) / nx;
+        const std::size_t i = glob % nx;
+
+        // pillars in COORD and corner depths in ZCORN, same ordering as
+        // EclipseGrid::getCellCorners()
+
+        const std::size_t p0 = j * (nx + 1) * 6 + i * 6;
+        const std::size_t pind[4] = { p0, p0 + 6, p0 + (nx + 1) * 6, p0 + (nx + 1) * 6 + 6 };
+
+        const std::size_t z0 = k * nxy * 8 + j * nx * 4 + i * 2;
+        const std::size_t zind[4] = { z0, z0 + 1, z0 + nx * 2, z0 + nx * 2 + 1 };
+
+        for (int c = 0; c < 4; c++) {
+            Z[c][n] = zcorn[zind[c]];
+            Z[c + 4][n] = zcorn[zind[c] + nxy * 4];
+        }
+
+        for (int c = 0; c < 4; c++) {
+            const double xt = coord[pind[c]];
+            const double yt = coord[pind[c] + 1];
+            const double zt = coord[pind[c] + 2];
+
+            const double xb = coord[pind[c] + 3];
+            const double yb = coord[pind[c] + 4];
+            const double zb = coord[pind[c] + 5];
+
+            if (zt == zb) {
+                X[c][n] = xt;
+                X[c + 4][n] = xt;
+
+                Y[c][n] = yt;
+                Y[c + 4][n] = yt;
+            } else {
+                X[c][n] = xt + (xb-xt) / (zt-zb) * (zt - Z[c][n]);
+                X[c + 4][n] = xt + (xb-xt) / (zt-zb) * (zt - Z[c + 4][n]);
+
+                Y[c][n] = yt + (yb-yt) / (zt-zb) * (zt - Z[c][n]);
+                Y[c + 4][n] = yt + (yb-yt) / (zt-zb) * (zt - Z[c + 4][n]);
+            }
+        }
+    }
+}
+
+
+// coefficients of the multipole expansion used by calculateCellVol(), see
+// function C() in calculateCellVol.cpp
+
+void blockCoefficients(const BlockArray& r, std::size_t num, BlockArray& coef)
+{
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (std::size_t n = 0; n < num; n++) {
+        coef[0][n] = r[0][n];
+        coef[1][n] = r[1][n] - r[0][n];
+        coef[2][n] = r[2][n] - r[0][n];
+        coef[3][n] = r[3][n] + r[0][n] - r[2][n] - r[1][n];
+        coef[4][n] = r[4][n] - r[0][n];
+        coef[5][n] = r[5][n] + r[0][n] - r[4][n] - r[1][n];
+        coef[6][n] = r[6][n] + r[0][n] - r[4][n] - r[2][n];
+        coef[7][n] = r[7][n] + r[4][n] + r[2][n] + r[1][n] - r[6][n] - r[5][n] - r[3][n] - r[0][n];
+    }
+}
+
+
+// same summation, in the same order, as calculateCellVol()
+
+void blockVolumes(const BlockArray& X, const BlockArray& Y, const BlockArray& Z,
+                  std::size_t num, double* volume)
+{
+    static const std::array<std::array<std::size_t, 3>, 6> permutation = {{{ 0, 1, 2},
+                                                                           { 0, 2, 1},
+                                                                           { 1, 2, 0},
+                                                                           { 1, 0, 2},
+                                                                           { 2, 0, 1},
+                                                                           { 2, 1, 0}}};
+
+    BlockArray coef[3];
+
+    blockCoefficients(X, num, coef[0]);
+    blockCoefficients(Y, num, coef[1]);
+    blockCoefficients(Z, num, coef[2]);
+
+    double sum[blockSize] = {};
+    double perm_sign = 1;
+
+    for (const auto& perm : permutation) {
+        for (int pqr = 0; pqr < 64; pqr++) {
+            const int pb = (pqr >> 5) & 1;
+            const int pg = (pqr >> 4) & 1;
+            const int qa = (pqr >> 3) & 1;
+            const int qg = (pqr >> 2) & 1;
+            const int ra = (pqr >> 1) & 1;
+            const int rb = pqr & 1;
+
+            const double* c0 = coef[perm[0]][1 + pb * 2 + pg * 4];
+            const double* c1 = coef[perm[1]][qa + 2 + qg * 4];
+            const double* c2 = coef[perm[2]][ra + rb * 2 + 4];
+
+            const double denom = (qa + ra + 1) * (pb + rb + 1) * (pg + qg + 1);
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (std::size_t n = 0; n < num; n++) {
+                const double cprod = c0[n] * c1[n] * c2[n];
+                sum[n] += perm_sign * cprod / denom;
+            }
+        }
+
+        perm_sign *= -1;
+    }
+
+    for (std::size_t n = 0; n < num; n++) {
+        volume[n] = std::fabs(sum[n]);
+    }
+}
+
+} // anonymous namespace
+
+
+namespace Opm {
+
+template <typename T>
+CellGeometry calculateCellGeometry(const std::array<int, 3>& dims,
+                                   const std::vector<T>& coord,
+                                   const std::vector<T>& zcorn,
+                                   const int* cells, std::size_t numCells,
+                                   unsigned quantities)
+{
+    CellGeometry geometry;
+
+    if (quantities & CellGeometry::Corners) {
+        for (int c = 0; c < 8; c++) {
+            geometry.cornerX[c].resize(numCells);
+            geometry.cornerY[c].resize(numCells);
+            geometry.cornerZ[c].resize(numCells);
+        }
+    }
+
+    if (quantities & CellGeometry::Centers) {
+        geometry.centerX.resize(numCells);
+        geometry.centerY.resize(numCells);
+        geometry.centerZ.resize(numCells);
+    }
+
+    if (quantities & CellGeometry::Volumes)
+        geometry.volume.resize(numCells);
+
+    if (quantities & CellGeometry::Depths)
+        geometry.depth.resize(numCells);
+
+    const long numBlocks = static_cast<long>((numCells + blockSize - 1) / blockSize);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long block = 0; block < numBlocks; block++) {
+        const std::size_t first = block * blockSize;
+        const std::size_t num = std::min(blockSize, numCells - first);
+
+        BlockArray X, Y, Z;
+
+        blockCorners(dims, coord.data(), zcorn.data(), cells + first, num, X, Y, Z);
+
+        if (quantities & CellGeometry::Corners) {
+            for (int c = 0; c < 8; c++) {
+                std::copy(X[c], X[c] + num, geometry.cornerX[c].begin() + first);
+                std::copy(Y[c], Y[c] + num, geometry.cornerY[c].begin() + first);
+                std::copy(Z[c], Z[c] + num, geometry.cornerZ[c].begin() + first);
+            }
+        }
+
+        if (quantities & CellGeometry::Centers) {
+            for (std::size_t n = 0; n < num; n++) {
+                double x = 0.0, y = 0.0, z = 0.0;
+
+                for (int c = 0; c < 8; c++) {
+                    x += X[c][n];
+                    y += Y[c][n];
+                    z += Z[c][n];
+                }
+
+                geometry.centerX[first + n] = x / 8.0;
+                geometry.centerY[first + n] = y / 8.0;
+                geometry.centerZ[first + n] = z / 8.0;
+            }
+        }
+
+        if (quantities & CellGeometry::Depths) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+            for (std::size_t n = 0; n < num; n++) {
+                const double z1 = (Z[0][n] + Z[1][n] + Z[2][n] + Z[3][n]) / 4.0;
+                const double z2 = (Z[4][n] + Z[5][n] + Z[6][n] + Z[7][n]) / 4.0;
+
+                geometry.depth[first + n] = (z1 + z2) / 2.0;
+            }
+        }
+
+        if (quantities & CellGeometry::Volumes)
+            blockVolumes(X, Y, Z, num, geometry.volume.data() + first);
+    }
+
+    return geometry;
+}
+
+
+template CellGeometry calculateCellGeometry(const std::array<int, 3>&,
+                                            const std::vector<float>&,
+                                            const std::vector<float>&,
+                                            const int*, std::size_t, unsigned);
+
+template CellGeometry calculateCellGeometry(const std::array<int, 3>&,
+                                            const std::vector<double>&,
+                                            const std::vector<double>&,
+                                            const int*, std::size_t, unsigned);
+
+} // namespace Opm
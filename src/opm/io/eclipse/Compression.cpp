@@ -0,0 +1,296 @@
+/*
+   Copyright 2020 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#include "config.h"
+
+#include "Compression.hpp"
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const char fileMagic[8] = {'O', 'P', 'M', 'E', 'C', 'L', 'Z', '1'};
+
+constexpr std::uint32_t zlibCodec = 1;
+
+// Blocks are large enough to compress well and small enough to keep all
+// threads busy on the larger arrays of a restart file.
+constexpr std::size_t blockSize = 1024 * 1024;
+
+constexpr std::size_t blockHeaderSize = 2 * sizeof(std::uint32_t);
+
+template <typename T>
+char* putBigEndian(T value, char* out)
+{
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        out[i] = static_cast<char>((value >> (8 * (sizeof(T) - 1 - i))) & 0xFF);
+    }
+
+    return out + sizeof(T);
+}
+
+template <typename T>
+T getBigEndian(const char* in)
+{
+    T value = 0;
+
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        value = (value << 8) | static_cast<unsigned char>(in[i]);
+    }
+
+    return value;
+}
+
+[[noreturn]] void noCompressionSupport()
+{
+    OPM_THROW(std::runtime_error, "Compressed binary files are not supported, opm-common was built without zlib");
+}
+
+// block of raw data with its block header, uncompressed and compressed size
+
+std::vector<char> compressBlock(const char* src, std::size_t size)
+{
+#if HAVE_ZLIB
+    uLongf compressedSize = compressBound(size);
+    std::vector<char> block(blockHeaderSize + compressedSize);
+
+    // the fastest level, output must not cost more time than it saves
+
+    const int status = compress2(reinterpret_cast<Bytef*>(block.data() + blockHeaderSize), &compressedSize,
+                                 reinterpret_cast<const Bytef*>(src), size, Z_BEST_SPEED);
+
+    if (status != Z_OK) {
+        OPM_THROW(std::runtime_error, "Compression of array data failed");
+    }
+
+    char* out = putBigEndian(static_cast<std::uint32_t>(size), block.data());
+    putBigEndian(static_cast<std::uint32_t>(compressedSize), out);
+
+    block.resize(blockHeaderSize + compressedSize);
+
+    return block;
+#else
+    static_cast<void>(src);
+    static_cast<void>(size);
+    noCompressionSupport();
+#endif
+}
+
+void decompressBlock(const char* src, std::size_t size, char* dst, std::size_t rawSize)
+{
+#if HAVE_ZLIB
+    uLongf length = rawSize;
+
+    const int status = uncompress(reinterpret_cast<Bytef*>(dst), &length,
+                                  reinterpret_cast<const Bytef*>(src), size);
+
+    if ((status != Z_OK) || (length != rawSize)) {
+        OPM_THROW(std::runtime_error, "Error reading compressed binary data, corrupt block");
+    }
+#else
+    static_cast<void>(src);
+    static_cast<void>(size);
+    static_cast<void>(dst);
+    static_cast<void>(rawSize);
+    noCompressionSupport();
+#endif
+}
+
+} // anonymous namespace
+
+namespace Opm { namespace EclIO {
+
+bool compressionSupported()
+{
+#if HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool isCompressedFile(const std::string& filename)
+{
+    std::ifstream fileH(filename, std::ios::in | std::ios::binary);
+
+    char header[compressedFileHeaderSize];
+
+    if (!fileH.read(header, sizeof(header)) || (std::memcmp(header, fileMagic, sizeof(fileMagic)) != 0))
+        return false;
+
+    const auto codec = getBigEndian<std::uint32_t>(header + sizeof(fileMagic));
+
+    if (codec != zlibCodec) {
+        std::string message = "Compressed binary file '" + filename + "' uses unknown codec " + std::to_string(codec);
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    return true;
+}
+
+
+void writeCompressedFileHeader(std::ostream& os)
+{
+    if (!compressionSupported())
+        noCompressionSupport();
+
+    char header[compressedFileHeaderSize];
+
+    std::memcpy(header, fileMagic, sizeof(fileMagic));
+    char* out = putBigEndian(zlibCodec, header + sizeof(fileMagic));
+    putBigEndian(std::uint32_t{0}, out);
+
+    os.write(header, sizeof(header));
+}
+
+
+void writeCompressedChunk(std::ostream& os, const std::vector<char>& raw)
+{
+    const std::size_t numBlocks = (raw.size() + blockSize - 1) / blockSize;
+
+    std::vector<std::vector<char>> blocks(numBlocks);
+    std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1)
+#endif
+    for (long b = 0; b < static_cast<long>(numBlocks); b++) {
+        try {
+            const std::size_t first = b * blockSize;
+            blocks[b] = compressBlock(raw.data() + first, std::min(blockSize, raw.size() - first));
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    std::uint64_t chunkSize = 0;
+
+    for (const auto& block : blocks) {
+        chunkSize += block.size();
+    }
+
+    char descriptor[chunkDescriptorSize];
+
+    char* out = putBigEndian(chunkSize, descriptor);
+    putBigEndian(static_cast<std::uint64_t>(raw.size()), out);
+
+    os.write(descriptor, sizeof(descriptor));
+
+    for (const auto& block : blocks) {
+        os.write(block.data(), block.size());
+    }
+}
+
+
+void readChunkDescriptor(const char* descriptor, std::uint64_t& chunkSize, std::uint64_t& rawSize)
+{
+    chunkSize = getBigEndian<std::uint64_t>(descriptor);
+    rawSize = getBigEndian<std::uint64_t>(descriptor + sizeof(std::uint64_t));
+}
+
+
+std::vector<char> decompressChunk(const char* chunk, std::size_t chunkSize, std::size_t rawSize)
+{
+    // locate the blocks, then decompress them concurrently
+
+    struct Block
+    {
+        const char* data;
+        std::size_t size;
+        std::size_t rawOffset;
+        std::size_t rawSize;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t pos = 0;
+    std::size_t rawOffset = 0;
+
+    while (pos < chunkSize) {
+        if (chunkSize - pos < blockHeaderSize) {
+            OPM_THROW(std::runtime_error, "Error reading compressed binary data, truncated block header");
+        }
+
+        const std::size_t blockRaw = getBigEndian<std::uint32_t>(chunk + pos);
+        const std::size_t blockCompressed = getBigEndian<std::uint32_t>(chunk + pos + sizeof(std::uint32_t));
+
+        pos += blockHeaderSize;
+
+        if ((chunkSize - pos < blockCompressed) || (rawSize - rawOffset < blockRaw)) {
+            OPM_THROW(std::runtime_error, "Error reading compressed binary data, inconsistent block sizes");
+        }
+
+        blocks.push_back({chunk + pos, blockCompressed, rawOffset, blockRaw});
+
+        pos += blockCompressed;
+        rawOffset += blockRaw;
+    }
+
+    if (rawOffset != rawSize) {
+        OPM_THROW(std::runtime_error, "Error reading compressed binary data, inconsistent chunk size");
+    }
+
+    std::vector<char> raw(rawSize);
+    std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (blocks.size() > 1)
+#endif
+    for (long b = 0; b < static_cast<long>(blocks.size()); b++) {
+        try {
+            const auto& block = blocks[b];
+            decompressBlock(block.data, block.size, raw.data() + block.rawOffset, block.rawSize);
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return raw;
+}
+
+}} // namespace Opm::EclIO
@@ -0,0 +1,72 @@
+/*
+   Copyright 2020 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#ifndef OPM_IO_COMPRESSION_HPP
+#define OPM_IO_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Opm { namespace EclIO {
+
+// Compressed binary files have the layout of ordinary binary files, except
+// that they start with a file header and that the data records of each
+// array with elements are replaced by one compressed chunk:
+//
+//   file header:  magic "OPMECLZ1" (8 bytes), codec (uint32), reserved (uint32)
+//
+//   array:        header record(s), as in a binary file
+//                 size of chunk, excluding this descriptor (uint64)
+//                 size of the uncompressed data records (uint64)
+//                 one or more blocks of the data records, each
+//                   uncompressed size (uint32), compressed size (uint32), data
+//
+// Numbers are big endian as elsewhere in binary files.  Blocks are
+// compressed independently, and may be compressed and decompressed
+// concurrently.  Arrays are located by scanning headers and chunk sizes,
+// without decompressing anything.
+
+constexpr std::size_t compressedFileHeaderSize = 16;
+constexpr std::size_t chunkDescriptorSize = 16;
+
+// true if the library was built with support for compressed files (zlib)
+bool compressionSupported();
+
+// true if the file starts with the header of a compressed binary file,
+// throws if the header names an unknown codec
+bool isCompressedFile(const std::string& filename);
+
+void writeCompressedFileHeader(std::ostream& os);
+
+// compress the data records raw of one array and write them as a chunk,
+// descriptor included
+void writeCompressedChunk(std::ostream& os, const std::vector<char>& raw);
+
+// chunk size and uncompressed size from the chunkDescriptorSize bytes at
+// descriptor
+void readChunkDescriptor(const char* descriptor, std::uint64_t& chunkSize, std::uint64_t& rawSize);
+
+// data records of the chunk [chunk, chunk + chunkSize), descriptor excluded
+std::vector<char> decompressChunk(const char* chunk, std::size_t chunkSize, std::size_t rawSize);
+
+}} // namespace Opm::EclIO
+
+#endif // OPM_IO_COMPRESSION_HPP
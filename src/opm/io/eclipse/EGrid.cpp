@@ -30,17 +30,15 @@
 
 namespace Opm { namespace EclIO {
 
-EGrid::EGrid(const std::string &filename) : EclFile(filename)
+EGrid::EGrid(const std::string &filename, const OpenOptions& options) : EclFile(filename, options)
 {
-   EclFile file(filename);
-
    auto gridhead = get<int>("GRIDHEAD");
 
    nijk[0] = gridhead[1];
    nijk[1] = gridhead[2];
    nijk[2] = gridhead[3];
 
-   if (file.hasKey("ACTNUM")) {
+   if (this->hasKey("ACTNUM")) {
        auto actnum = get<int>("ACTNUM");
 
        nactive = 0;
@@ -55,6 +53,7 @@ EGrid::EGrid(const std::string &filename) : EclFile(filename)
         }
    } else {
        int nCells = nijk[0] * nijk[1] * nijk[2];
+       nactive = nCells;
        act_index.resize(nCells);
        glob_index.resize(nCells);
        std::iota(act_index.begin(), act_index.end(), 0);
@@ -179,4 +178,22 @@ void EGrid::getCellCorners(int globindex, std::array<double,8>& X,
     return getCellCorners(ijk_from_global_index(globindex),X,Y,Z);
 }
 
+
+CellGeometry EGrid::getCellGeometry(unsigned quantities) const
+{
+    return getCellGeometry(0, nactive, quantities);
+}
+
+
+CellGeometry EGrid::getCellGeometry(int activeBegin, int activeEnd, unsigned quantities) const
+{
+    if (activeBegin < 0 || activeBegin > activeEnd || activeEnd > nactive) {
+        OPM_THROW(std::invalid_argument, "range of active cells out of range");
+    }
+
+    return calculateCellGeometry(nijk, coord_array, zcorn_array,
+                                 glob_index.data() + activeBegin,
+                                 activeEnd - activeBegin, quantities);
+}
+
 }} // namespace Opm::ecl
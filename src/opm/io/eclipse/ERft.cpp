@@ -29,7 +29,7 @@
 
 namespace Opm { namespace EclIO {
 
-ERft::ERft(const std::string &filename) : EclFile(filename)
+ERft::ERft(const std::string &filename, const OpenOptions& options) : EclFile(filename, options)
 {
     loadData();
     std::vector<int> first;
@@ -157,6 +157,10 @@ int ERft::getArrayIndex(const std::string& name, const std::string& wellName,
 }
 
 
+// getRft() goes through EclFile::getShared() as the array may have been
+// released to stay within the cache budget.  The reference returned stays
+// valid as long as a reference returned by EclFile::get().
+
 template<> const std::vector<float>&
 ERft::getRft<float>(const std::string& name, const std::string &wellName,
                     const RftDate& date) const
@@ -168,8 +172,7 @@ ERft::getRft<float>(const std::string& name, const std::string &wellName,
         OPM_THROW(std::runtime_error, message);
     }
 
-    auto search_array = real_array.find(arrInd);
-    return search_array->second;
+    return *getShared<float>(arrInd);
 }
 
 
@@ -184,8 +187,7 @@ ERft::getRft<double>(const std::string& name, const std::string& wellName,
         OPM_THROW(std::runtime_error, message);
     }
 
-    auto search_array = doub_array.find(arrInd);
-    return search_array->second;
+    return *getShared<double>(arrInd);
 }
 
 
@@ -200,8 +202,7 @@ ERft::getRft<int>(const std::string& name, const std::string& wellName,
         OPM_THROW(std::runtime_error, message);
     }
 
-    auto search_array = inte_array.find(arrInd);
-    return search_array->second;
+    return *getShared<int>(arrInd);
 }
 
 
@@ -216,8 +217,7 @@ ERft::getRft<bool>(const std::string& name, const std::string& wellName,
         OPM_THROW(std::runtime_error, message);
     }
 
-    auto search_array = logi_array.find(arrInd);
-    return search_array->second;
+    return *getShared<bool>(arrInd);
 }
 
 
@@ -232,8 +232,7 @@ ERft::getRft<std::string>(const std::string& name, const std::string& wellName,
         OPM_THROW(std::runtime_error, message);
     }
 
-    auto search_array = char_array.find(arrInd);
-    return search_array->second;
+    return *getShared<std::string>(arrInd);
 }
 
 
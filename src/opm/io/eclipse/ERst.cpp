@@ -23,6 +23,7 @@
 #include <exception>
 #include <iomanip>
 #include <iterator>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
@@ -53,8 +54,8 @@ namespace {
 
 namespace Opm { namespace EclIO {
 
-ERst::ERst(const std::string& filename)
-    : EclFile(filename)
+ERst::ERst(const std::string& filename, const OpenOptions& options)
+    : EclFile(filename, options)
 {
     if (this->hasKey("SEQNUM")) {
         this->initUnified();
@@ -79,19 +80,45 @@ void ERst::loadReportStepNumber(int number)
         OPM_THROW(std::invalid_argument, message);
     }
 
+    const auto& range = arrIndexRange.at(number);
+
     std::vector<int> arrayIndexList;
-    arrayIndexList.reserve(arrIndexRange[number].second - arrIndexRange[number].first + 1);
+    arrayIndexList.reserve(range.second - range.first + 1);
 
-    for (int i = arrIndexRange[number].first; i < arrIndexRange[number].second; i++) {
+    for (int i = range.first; i < range.second; i++) {
         arrayIndexList.push_back(i);
     }
 
     loadData(arrayIndexList);
 
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
     reportLoaded[number] = true;
 }
 
 
+void ERst::unloadReportStep(int number)
+{
+    if (!hasReportStepNumber(number)) {
+        std::string message="Trying to unload non existing report step number " + std::to_string(number);
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    const auto& range = arrIndexRange.at(number);
+
+    std::vector<int> arrayIndexList;
+    arrayIndexList.reserve(range.second - range.first);
+
+    for (int i = range.first; i < range.second; i++) {
+        arrayIndexList.push_back(i);
+    }
+
+    unloadData(arrayIndexList);
+
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
+    reportLoaded[number] = false;
+}
+
+
 std::vector<EclFile::EclEntry> ERst::listOfRstArrays(int reportStepNumber)
 {
     std::vector<EclEntry> list;
@@ -101,7 +128,7 @@ std::vector<EclFile::EclEntry> ERst::listOfRstArrays(int reportStepNumber)
         OPM_THROW(std::invalid_argument, message);
     }
 
-    const auto& rng = this->arrIndexRange[reportStepNumber];
+    const auto& rng = this->arrIndexRange.at(reportStepNumber);
     list.reserve(rng.second - rng.first);
 
     for (int i = rng.first;  i < rng.second; i++) {
@@ -19,16 +19,24 @@
 #include <opm/io/eclipse/ESmry.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
+#include <fstream>
 #include <iterator>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <utility>
 
 #include <opm/common/utility/FileSystem.hpp>
 
+#include <opm/common/ErrorMacros.hpp>
 #include <opm/io/eclipse/EclFile.hpp>
+#include <opm/io/eclipse/EclOutput.hpp>
+#include <opm/io/eclipse/EclUtil.hpp>
 /*
 
      KEYWORDS       WGNAMES        NUMS              |   PARAM index   Corresponding ERT key
@@ -49,9 +57,53 @@
 
  */
 
+namespace {
+
+    // layout of transposed summary file: header, report step indices and
+    // times followed by one REAL array for each vector (sorted on key)
+
+    const int cacheVersion = 1;
+    const int cacheFirstVector = 3;
+
+    // FNV-1a hash of name, size and modification time of the source files
+
+    std::uint64_t makeSourceKey(const std::vector<std::string>& files)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        auto add = [&hash](const void* data, std::size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+            for (std::size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        for (const auto& file : files) {
+            const std::uint64_t size = Opm::filesystem::file_size(file);
+            const std::int64_t mtime = Opm::filesystem::last_write_time(file).time_since_epoch().count();
+
+            add(file.data(), file.size());
+            add(&size, sizeof(size));
+            add(&mtime, sizeof(mtime));
+        }
+
+        return hash;
+    }
+
+    std::vector<int> cacheHeader(int nVect, int nSteps, std::uint64_t key)
+    {
+        return { cacheVersion, nVect, nSteps,
+                 static_cast<int>(key >> 32), static_cast<int>(key & 0xffffffffu) };
+    }
+}
+
 namespace Opm { namespace EclIO {
 
-ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
+ESmry::ESmry(const std::string &filename, bool loadBaseRunData, const OpenOptions& options,
+             bool refreshCacheFile)
 {
 
     Opm::filesystem::path inputFileName(filename);
@@ -86,7 +138,7 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
 
     // Read data from the summary into local data members.
     {
-        EclFile smspec(smspec_file.string());
+        EclFile smspec(smspec_file.string(), options);
 
         smspec.loadData();   // loading all data
 
@@ -134,7 +186,7 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
             baseRunFmt = true;
         }
 
-        EclFile smspec_rst(rstFile.string());
+        EclFile smspec_rst(rstFile.string(), options);
         smspec_rst.loadData();
 
         const std::vector<int> dimens = smspec_rst.get<int>("DIMENS");
@@ -162,23 +214,21 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
 
     const int nFiles = static_cast<int>(smryArray.size());
 
-    // arrayInd should hold indices for each vector and runs
-    // n=file number, i = position in param array in file n (one array pr time step), example arrayInd[n][i] = position in keyword list (std::set)
+    keyword.assign(keywList.begin(), keywList.end());
+    nVect = keyword.size();
 
-    std::vector<std::vector<int>> arrayInd;
+    // paramsPos should hold position in the PARAMS arrays for each vector and run
+    // n=file number, k = index in keyword list, example paramsPos[n][k] = position in PARAMS array of run n
 
-    for (int i = 0; i < nFiles; i++){
-        arrayInd.push_back({});
-    }
+    paramsPos.assign(nFiles, std::vector<int>(nVect, -1));
 
     int n = nFiles - 1;
 
-
     while (n >= 0){
 
         auto smry = smryArray[n];
 
-        EclFile smspec(std::get<0>(smry));
+        EclFile smspec(std::get<0>(smry), options);
         smspec.loadData();
 
         const std::vector<int> dimens = smspec.get<int>("DIMENS");
@@ -191,49 +241,27 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
         const std::vector<std::string> wgnames = smspec.get<std::string>("WGNAMES");
         const std::vector<int> nums = smspec.get<int>("NUMS");
 
-        const std::vector<int> tmpVect(keywords.size(), -1);
-        arrayInd[n]=tmpVect;
-
-        std::set<std::string>::iterator it;
-
         for (size_t i=0; i < keywords.size(); i++) {
             const std::string keyw = makeKeyString(keywords[i], wgnames[i], nums[i]);
-            it = std::find(keywList.begin(), keywList.end(), keyw);
+            auto it = std::lower_bound(keyword.begin(), keyword.end(), keyw);
 
-            if (it != keywList.end()){
-                arrayInd[n][i] = distance(keywList.begin(), it);
+            if ((it != keyword.end()) && (*it == keyw)) {
+                paramsPos[n][std::distance(keyword.begin(), it)] = i;
             }
         }
 
         n--;
     }
 
-    // param array used to stor data for the object, defined in the private section of the class
-    param.assign(keywList.size(), {});
-
-    int fromReportStepNumber = 0;
-    int toReportStepNumber;
-
-    float time = 0.0;
-    int step = 0;
+    // summary data files (unified or non-unified) for each run
 
-    n = nFiles - 1;
-
-    while (n >= 0){
-
-        int reportStepNumber = fromReportStepNumber;
+    std::vector<std::vector<std::string>> resultsFiles(nFiles);
 
-        if (n > 0) {
-            auto rstFrom = smryArray[n-1];
-            toReportStepNumber = std::get<1>(rstFrom);
-        } else {
-            toReportStepNumber = std::numeric_limits<int>::max();
-        }
+    for (n = 0; n < nFiles; n++) {
 
         Opm::filesystem::path smspecFile(std::get<0>(smryArray[n]));
         rootName = smspecFile.parent_path() / smspecFile.stem();
 
-
         // check if multiple or unified result files should be used
         // to import data, no information in smspec file regarding this
         // if both unified and non-unified files exists, will use most recent based on
@@ -247,7 +275,7 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
 
         const std::vector<std::string> multFileList = checkForMultipleResultFiles(rootName, formattedVect[n]);
 
-        std::vector<std::string> resultsFileList;
+        std::vector<std::string>& resultsFileList = resultsFiles[n];
 
         if ((!use_unified) && (multFileList.size()==0)){
             throw std::runtime_error("neigther unified or non-unified result files found");
@@ -266,23 +294,104 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
         } else {
             resultsFileList=multFileList;
         }
+    }
 
-        // make array list with reference to source files (unifed or non unified)
+    param.assign(nVect, {});
+    arrayLoaded.assign(nVect, false);
+    loading.assign(nVect, false);
+
+    // reuse transposed summary file if it is up to date with all the source files
+
+    bool staleCacheFile = false;
+
+    {
+        std::vector<std::string> sourceFiles;
+
+        for (n = 0; n < nFiles; n++) {
+            sourceFiles.push_back(std::get<0>(smryArray[n]));
+            sourceFiles.insert(sourceFiles.end(), resultsFiles[n].begin(), resultsFiles[n].end());
+        }
+
+        sourceKey = makeSourceKey(sourceFiles);
+
+        cachePath = Opm::filesystem::path(std::get<0>(smryArray[0]));
+        cachePath.replace_extension(".ESMRY");
+
+        if (openCacheFile(options)) {
+            return;
+        }
+
+        staleCacheFile = Opm::filesystem::exists(cachePath);
+    }
+
+    // index the PARAMS arrays of all time steps, no summary data is read at this stage.
+    // The data files of all runs are opened, and their array headers scanned, concurrently.
+
+    std::vector<int> firstFileOfRun(nFiles, 0);
+    std::vector<std::string> dataFileNames;
+
+    for (n = nFiles - 1; n >= 0; n--) {
+        firstFileOfRun[n] = static_cast<int>(dataFileNames.size());
+        dataFileNames.insert(dataFileNames.end(), resultsFiles[n].begin(), resultsFiles[n].end());
+    }
+
+    dataFiles.resize(dataFileNames.size());
+
+    std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(dataFileNames.size()); i++) {
+        try {
+            dataFiles[i] = std::make_unique<EclFile>(dataFileNames[i], options);
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    int fromReportStepNumber = 0;
+    int toReportStepNumber;
+
+    std::vector<bool> endOfReportStep;
+
+    n = nFiles - 1;
 
-        std::vector<std::tuple<std::string, std::string, int>> arraySourceList;
+    while (n >= 0){
+
+        int reportStepNumber = fromReportStepNumber;
+
+        if (n > 0) {
+            auto rstFrom = smryArray[n-1];
+            toReportStepNumber = std::get<1>(rstFrom);
+        } else {
+            toReportStepNumber = std::numeric_limits<int>::max();
+        }
+
+        // make array list with reference to source files (unifed or non unified)
 
-        for (std::string fileName : resultsFileList){
-            EclFile unsmry(fileName);
+        std::vector<std::tuple<std::string, int, int>> arraySourceList;
 
-            const std::vector<EclFile::EclEntry> arrayList = unsmry.getList();
+        for (size_t i = 0; i < resultsFiles[n].size(); i++){
+            const int fileIndex = firstFileOfRun[n] + static_cast<int>(i);
+            const std::vector<EclFile::EclEntry> arrayList = dataFiles[fileIndex]->getList();
 
             for (size_t nn = 0; nn < arrayList.size(); nn++){
-                std::tuple<std::string, std::string, int> t1 = std::make_tuple(std::get<0>(arrayList[nn]), fileName, static_cast<int>(nn));
-                arraySourceList.push_back(t1);
+                arraySourceList.emplace_back(std::get<0>(arrayList[nn]), fileIndex, static_cast<int>(nn));
             }
         }
 
-        // loop through arrays and extract symmary data from result files, arrays PARAMS
+        // loop through arrays and register the symmary data arrays (PARAMS) of each time step
         //
         //    2 or 3 arrays pr time step.
         //       If timestep is a report step:  MINISTEP, PARAMS and SEQHDR
@@ -290,9 +399,6 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
 
         size_t i = std::get<0>(arraySourceList[0]) == "SEQHDR" ? 1 : 0 ;
 
-        std::string prevFile;
-        std::unique_ptr<EclFile> pEclFile;
-
         while  (i < arraySourceList.size()){
 
             if (std::get<0>(arraySourceList[i]) != "MINISTEP"){
@@ -307,73 +413,454 @@ ESmry::ESmry(const std::string &filename, bool loadBaseRunData)
 
             i++;
 
-            if (std::get<1>(arraySourceList[i]) != prevFile){
-                pEclFile = std::make_unique<EclFile>(std::get<1>(arraySourceList[i]));
-                pEclFile->loadData();
-
-                prevFile = std::get<1>(arraySourceList[i]);
-            }
-
-            const int m = std::get<2>(arraySourceList[i]);
-
-            const std::vector<float> tmpData = pEclFile->get<float>(m);
-
-            time = tmpData[0];
-
-            if (time == 0.0) {
-                seqTime.push_back(time);
-                seqIndex.push_back(step);
-            }
+            timeStepList.emplace_back(std::get<1>(arraySourceList[i]), std::get<2>(arraySourceList[i]), n);
 
             i++;
 
+            bool endOfReport = false;
+
             if (i < arraySourceList.size()){
                 if (std::get<0>(arraySourceList[i]) == "SEQHDR") {
                     i++;
                     reportStepNumber++;
-                    seqTime.push_back(time);
-                    seqIndex.push_back(step);
+                    endOfReport = true;
                 }
             } else {
                 reportStepNumber++;
-                seqTime.push_back(time);
-                seqIndex.push_back(step);
+                endOfReport = true;
+            }
+
+            endOfReportStep.push_back(endOfReport);
+
+            if (reportStepNumber >= toReportStepNumber) {
+                i = arraySourceList.size();
+            }
+        }
+
+        fromReportStepNumber = toReportStepNumber;
+
+        n--;
+    }
+
+    // first element of each PARAMS array is simulation time, needed for
+    // identifying start of report steps
+
+    const auto timeColumn = readColumns(std::vector<std::vector<int>>(nFiles, std::vector<int>{0}));
+
+    const auto& timeVect = timeColumn[0];
+
+    for (size_t step = 0; step < timeStepList.size(); step++) {
+        const float time = timeVect[step];
+
+        if (time == 0.0) {
+            seqTime.push_back(time);
+            seqIndex.push_back(step);
+        }
+
+        if (endOfReportStep[step]) {
+            seqTime.push_back(time);
+            seqIndex.push_back(step);
+        }
+    }
+
+    // an out of date transposed summary file is replaced, failing that
+    // (e.g. in a read-only directory) the summary data files are used
+
+    if (staleCacheFile && refreshCacheFile) {
+        try {
+            writeCacheFile();
+            openCacheFile(options);
+        }
+        catch (const std::exception&) {
+            // the partially written file has been removed by writeCacheFile()
+        }
+    }
+}
+
+
+std::vector<std::vector<float>> ESmry::readColumns(const std::vector<std::vector<int>>& columnPos) const
+{
+    // columnPos[n][c] is the position in the PARAMS arrays of run n holding
+    // values for column c, -1 if not present in run n (value 0.0 is then used)
+
+    const size_t nColumns = columnPos.empty() ? 0 : columnPos[0].size();
+    const size_t nSteps = timeStepList.size();
+
+    std::vector<std::vector<float>> columns(nColumns, std::vector<float>(nSteps, 0.0f));
+
+    // (position in PARAMS, column) for each run, sorted on position
+
+    std::vector<std::vector<std::pair<int,int>>> runElements(columnPos.size());
+
+    for (size_t run = 0; run < columnPos.size(); run++) {
+        for (size_t c = 0; c < nColumns; c++) {
+            if (columnPos[run][c] > -1) {
+                runElements[run].emplace_back(columnPos[run][c], c);
             }
+        }
+
+        std::sort(runElements[run].begin(), runElements[run].end());
+    }
+
+    // Split time steps in ranges of consecutive steps stored in the same
+    // data file.  Ranges are read concurrently, each range writes to its
+    // own rows of the columns so the result does not depend on the order
+    // of completion.  Formatted and compressed files are loaded through
+    // EclFile and must be processed by a single thread.
+
+    const size_t maxStepsInRange = 256;
+
+    std::vector<std::pair<size_t, size_t>> ranges;
+
+    size_t from = 0;
+    while (from < nSteps) {
+        const int fileIndex = std::get<0>(timeStepList[from]);
+        const bool splitRange = !dataFiles[fileIndex]->formatted &&
+                                !dataFiles[fileIndex]->compressedInput();
 
-            // adding defaut values (0.0) in case vector not found in this particular summary file
+        size_t to = from + 1;
 
-            for (size_t ii = 0; ii < param.size(); ii++){
-                param[ii].push_back(0.0);
+        while ((to < nSteps) && (std::get<0>(timeStepList[to]) == fileIndex) &&
+               (!splitRange || (to - from < maxStepsInRange))) {
+            to++;
+        }
+
+        ranges.emplace_back(from, to);
+        from = to;
+    }
+
+    std::exception_ptr error;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int r = 0; r < static_cast<int>(ranges.size()); r++) {
+        try {
+            readTimeSteps(ranges[r].first, ranges[r].second, runElements, columns);
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (!error) {
+                error = std::current_exception();
             }
+        }
+    }
 
-            for (size_t j = 0; j < tmpData.size(); j++) {
-                int ind = arrayInd[n][j];
+    if (error) {
+        std::rethrow_exception(error);
+    }
 
-                if (ind > -1) {
-                   param[ind][step] = tmpData[j];
+    return columns;
+}
+
+
+void ESmry::readTimeSteps(size_t fromStep, size_t toStep,
+                          const std::vector<std::vector<std::pair<int,int>>>& runElements,
+                          std::vector<std::vector<float>>& columns) const
+{
+    // byte offset of element number pos relative to start of PARAMS data,
+    // skipping the Fortran record markers (1000 elements per record)
+
+    auto offset = [](int pos) -> unsigned long
+    {
+        const unsigned long elmPerBlock = MaxBlockSizeReal / sizeOfReal;
+
+        return (pos / elmPerBlock) * (MaxBlockSizeReal + 2 * sizeOfInte)
+            + sizeOfInte + (pos % elmPerBlock) * sizeOfReal;
+    };
+
+    // elements closer than this are read with a single read call
+
+    const unsigned long maxGap = 4096;
+
+    std::ifstream fileH;
+    std::vector<char> buffer;
+
+    for (size_t step = fromStep; step < toStep; step++) {
+        const int fileIndex = std::get<0>(timeStepList[step]);
+        const int arrIndex = std::get<1>(timeStepList[step]);
+        const auto& elements = runElements[std::get<2>(timeStepList[step])];
+
+        if (elements.empty()) {
+            continue;
+        }
+
+        EclFile& file = *dataFiles[fileIndex];
+
+        if ((file.array_type[arrIndex] != REAL) || (elements.back().first >= file.array_size[arrIndex])) {
+            std::string message = "Inconsistent PARAMS array in summary file '" + file.inputFilename + "'";
+            OPM_THROW(std::runtime_error, message);
+        }
+
+        // PARAMS arrays of formatted and compressed files can not be read
+        // in place, they are decoded by EclFile
+
+        if (file.formatted || file.compressedInput()) {
+            file.loadData(arrIndex);
+            const auto& data = file.get<float>(arrIndex);
+
+            for (const auto& elm : elements) {
+                columns[elm.second][step] = data[elm.first];
+            }
+
+            file.clearData();
+
+        } else if (file.memoryMapped()) {
+            const auto data = file.getMapped<float>(arrIndex);
+
+            for (const auto& elm : elements) {
+                columns[elm.second][step] = data[elm.first];
+            }
+
+        } else {
+            if (!fileH.is_open()) {
+                fileH.open(file.inputFilename, std::ios::in | std::ios::binary);
+
+                if (!fileH) {
+                    std::string message="Could not open file: '" + file.inputFilename +"'";
+                    OPM_THROW(std::runtime_error, message);
                 }
             }
 
-            if (reportStepNumber >= toReportStepNumber) {
-                i = arraySourceList.size();
+            const unsigned long start = file.ifStreamPos[arrIndex];
+
+            size_t first = 0;
+            while (first < elements.size()) {
+                size_t last = first;
+
+                while ((last + 1 < elements.size()) &&
+                       (offset(elements[last + 1].first) - offset(elements[last].first) < maxGap)) {
+                    last++;
+                }
+
+                const unsigned long begin = offset(elements[first].first);
+                const unsigned long end = offset(elements[last].first) + sizeOfReal;
+
+                buffer.resize(end - begin);
+
+                fileH.seekg(start + begin, std::ios_base::beg);
+                fileH.read(buffer.data(), end - begin);
+
+                if (!fileH) {
+                    std::string message="Error reading summary data from file: '" + file.inputFilename +"'";
+                    OPM_THROW(std::runtime_error, message);
+                }
+
+                for (size_t e = first; e <= last; e++) {
+                    float value;
+                    std::memcpy(&value, buffer.data() + (offset(elements[e].first) - begin), sizeof(value));
+                    columns[elements[e].second][step] = flipEndianFloat(value);
+                }
+
+                first = last + 1;
             }
+        }
+    }
+}
+
+
+bool ESmry::openCacheFile(const OpenOptions& options)
+{
+    if (!Opm::filesystem::exists(cachePath)) {
+        return false;
+    }
+
+    // a cache file not matching the source files, e.g. from an earlier
+    // run or only partly written, is ignored
 
-            step++;
+    try {
+        auto file = std::make_unique<EclFile>(cachePath.string(), options);
+
+        if (!file->hasKey("CACHEHD") || (file->size() != static_cast<std::size_t>(cacheFirstVector + nVect))) {
+            return false;
         }
 
-        fromReportStepNumber = toReportStepNumber;
+        const std::vector<int> header = file->get<int>("CACHEHD");
 
-        n--;
+        if ((header.size() != 5) || (header != cacheHeader(nVect, header[2], sourceKey))) {
+            return false;
+        }
+
+        seqIndex = file->get<int>("SEQINDEX");
+        seqTime = file->get<float>("SEQTIME");
+
+        file->clearData();
+        cacheFile = std::move(file);
     }
+    catch (const std::exception&) {
+        return false;
+    }
+
+    return true;
+}
 
-    nVect = keywList.size();
 
-    for (const auto& keyw : keywList){
-        keyword.push_back(keyw);
+void ESmry::writeCacheFile() const
+{
+    if (cacheFile) {
+        return;
+    }
+
+    const int nSteps = static_cast<int>(timeStepList.size());
+
+    // written under a unique name and renamed, such that concurrent writers
+    // and readers of the same case never see a partially written file
+
+    const std::string tmpFile = cachePath.string() + Opm::unique_path(".%%%%-%%%%.tmp");
+
+    try {
+        {
+            EclOutput outFile(tmpFile, false);
+
+            outFile.write<int>("CACHEHD", cacheHeader(nVect, nSteps, sourceKey));
+            outFile.write<int>("SEQINDEX", seqIndex);
+            outFile.write<float>("SEQTIME", seqTime);
+
+            // vectors are loaded in chunks of limited size to bound memory use
+
+            const std::size_t maxValues = 64 * 1024 * 1024;
+            const int chunkSize = std::max(1, static_cast<int>(maxValues / std::max(nSteps, 1)));
+
+            for (int first = 0; first < nVect; first += chunkSize) {
+                const int last = std::min(first + chunkSize, nVect);
+
+                std::vector<bool> wasLoaded(arrayLoaded.begin() + first, arrayLoaded.begin() + last);
+
+                this->loadData(std::vector<std::string>(keyword.begin() + first, keyword.begin() + last));
+
+                for (int ind = first; ind < last; ind++) {
+                    outFile.write<float>("COLUMN", param[ind]);
+
+                    if (!wasLoaded[ind - first]) {
+                        param[ind] = std::vector<float>();
+                        arrayLoaded[ind] = false;
+                    }
+                }
+            }
+        }
+
+        Opm::filesystem::rename(tmpFile, cachePath);
+    }
+    catch (...) {
+        std::error_code ec;
+        Opm::filesystem::remove(tmpFile, ec);
+        throw;
     }
 }
 
 
+void ESmry::loadData() const
+{
+    this->loadData(keyword);
+}
+
+
+void ESmry::loadData(const std::vector<std::string>& vectList) const
+{
+    std::vector<int> requested;
+
+    for (const auto& name : vectList) {
+        const int ind = getKeywordIndex(name);
+
+        if (std::find(requested.begin(), requested.end(), ind) == requested.end()) {
+            requested.push_back(ind);
+        }
+    }
+
+    // vectors being loaded by another thread are waited for, the remaining
+    // vectors which are not loaded yet are claimed by this thread
+
+    std::vector<int> keyIndices;
+
+    {
+        std::unique_lock<std::mutex> lock(loadMutex);
+
+        loadDone.wait(lock, [this, &requested]() {
+            return std::none_of(requested.begin(), requested.end(),
+                                [this](int ind) { return loading[ind]; });
+        });
+
+        for (int ind : requested) {
+            if (!arrayLoaded[ind]) {
+                loading[ind] = true;
+                keyIndices.push_back(ind);
+            }
+        }
+    }
+
+    if (keyIndices.empty()) {
+        return;
+    }
+
+    std::vector<std::vector<float>> columns;
+
+    try {
+        std::lock_guard<std::mutex> readLock(readMutex);
+        columns = readVectors(keyIndices);
+    }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(loadMutex);
+
+            for (int ind : keyIndices) {
+                loading[ind] = false;
+            }
+        }
+
+        loadDone.notify_all();
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+
+        for (size_t c = 0; c < keyIndices.size(); c++) {
+            param[keyIndices[c]] = std::move(columns[c]);
+            arrayLoaded[keyIndices[c]] = true;
+            loading[keyIndices[c]] = false;
+        }
+    }
+
+    loadDone.notify_all();
+}
+
+
+std::vector<std::vector<float>> ESmry::readVectors(const std::vector<int>& keyIndices) const
+{
+    if (cacheFile) {
+        std::vector<int> arrIndices;
+
+        for (int ind : keyIndices) {
+            arrIndices.push_back(cacheFirstVector + ind);
+        }
+
+        cacheFile->loadData(arrIndices);
+
+        std::vector<std::vector<float>> columns;
+
+        for (int ind : keyIndices) {
+            columns.push_back(cacheFile->get<float>(cacheFirstVector + ind));
+        }
+
+        cacheFile->clearData();
+
+        return columns;
+    }
+
+    std::vector<std::vector<int>> columnPos(paramsPos.size(), std::vector<int>(keyIndices.size()));
+
+    for (size_t run = 0; run < paramsPos.size(); run++) {
+        for (size_t c = 0; c < keyIndices.size(); c++) {
+            columnPos[run][c] = paramsPos[run][keyIndices[c]];
+        }
+    }
+
+    return readColumns(columnPos);
+}
+
+
 std::vector<std::string> ESmry::checkForMultipleResultFiles(const Opm::filesystem::path& rootN, bool formatted) const {
 
     std::vector<std::string> fileList;
@@ -421,7 +908,7 @@ void ESmry::updatePathAndRootName(Opm::filesystem::path& dir, Opm::filesystem::p
 
 bool ESmry::hasKey(const std::string &key) const
 {
-    return std::find(keyword.begin(), keyword.end(), key) != keyword.end();
+    return std::binary_search(keyword.begin(), keyword.end(), key);
 }
 
 
@@ -495,23 +982,39 @@ std::string ESmry::makeKeyString(const std::string& keywordArg, const std::strin
 }
 
 
-const std::vector<float>& ESmry::get(const std::string& name) const
+int ESmry::getKeywordIndex(const std::string& name) const
 {
-    auto it = std::find(keyword.begin(), keyword.end(), name);
+    auto it = std::lower_bound(keyword.begin(), keyword.end(), name);
 
-    if (it == keyword.end()) {
+    if ((it == keyword.end()) || (*it != name)) {
         const std::string message="keyword " + name + " not found ";
         OPM_THROW(std::invalid_argument, message);
     }
 
-    int ind = std::distance(keyword.begin(), it);
+    return std::distance(keyword.begin(), it);
+}
+
+
+const std::vector<float>& ESmry::get(const std::string& name) const
+{
+    const int ind = getKeywordIndex(name);
+
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+
+        if (arrayLoaded[ind]) {
+            return param[ind];
+        }
+    }
+
+    loadData({name});
 
     return param[ind];
 }
 
 std::vector<float> ESmry::get_at_rstep(const std::string& name) const
 {
-    const std::vector<float> full_vector= this->get(name);
+    const std::vector<float>& full_vector= this->get(name);
 
     std::vector<float> rstep_vector;
     rstep_vector.reserve(seqIndex.size());
@@ -16,13 +16,24 @@
    along with OPM.  If not, see <http://www.gnu.org/licenses/>.
    */
 
+#include "config.h"
+
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/common/utility/FileSystem.hpp>
+
+#include "Compression.hpp"
+#include "MappedFile.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <fstream>
 #include <iomanip>
@@ -30,6 +41,8 @@
 #include <sstream>
 #include <string>
 #include <numeric>
+#include <system_error>
+#include <utility>
 #include <cmath>
 
 #include <iostream>
@@ -54,6 +67,114 @@ bool isFormatted(const std::string& filename)
 }
 
 
+// Minimal stream interface on top of a memory mapped file, or any other
+// range of memory, providing the subset of std::fstream used by the binary
+// readers below.  Reads beyond
+// the end of the mapping throw rather than returning garbage.
+
+class MappedStream
+{
+public:
+    explicit MappedStream(const Opm::EclIO::MappedFile& file)
+        : base(file.data()), length(static_cast<std::streamoff>(file.size()))
+    {}
+
+    MappedStream(const char* data, std::size_t size)
+        : base(data), length(static_cast<std::streamoff>(size))
+    {}
+
+    void read(char* dst, std::streamsize num)
+    {
+        if (num > length - pos) {
+            OPM_THROW(std::runtime_error, "Error reading binary data, unexpected end of file");
+        }
+
+        std::memcpy(dst, base + pos, num);
+        pos += num;
+    }
+
+    std::streamoff tellg() const { return pos; }
+
+    void seekg(std::streamoff off, std::ios_base::seekdir dir = std::ios_base::beg)
+    {
+        if (dir == std::ios_base::beg)
+            pos = off;
+        else if (dir == std::ios_base::cur)
+            pos += off;
+        else
+            pos = length + off;
+    }
+
+    std::streamoff remaining() const { return length - pos; }
+
+    // errors are reported by exceptions, the stream itself is always good
+    void clear() {}
+    explicit operator bool() const { return true; }
+
+private:
+    const char* base;
+    std::streamoff length;
+    std::streamoff pos = 0;
+};
+
+
+// Stream interface on top of positioned reads (pread) from a file shared
+// with other threads.  Each stream keeps its own position.
+
+class PositionedStream
+{
+public:
+    explicit PositionedStream(const Opm::EclIO::PositionedFile& file)
+        : source(file), length(static_cast<std::streamoff>(file.size()))
+    {}
+
+    void read(char* dst, std::streamsize num)
+    {
+        if (num > length - pos) {
+            OPM_THROW(std::runtime_error, "Error reading binary data, unexpected end of file");
+        }
+
+        source.read(dst, num, pos);
+        pos += num;
+    }
+
+    std::streamoff tellg() const { return pos; }
+
+    void seekg(std::streamoff off, std::ios_base::seekdir dir = std::ios_base::beg)
+    {
+        if (dir == std::ios_base::beg)
+            pos = off;
+        else if (dir == std::ios_base::cur)
+            pos += off;
+        else
+            pos = length + off;
+    }
+
+    std::streamoff remaining() const { return length - pos; }
+
+    // errors are reported by exceptions, the stream itself is always good
+    void clear() {}
+    explicit operator bool() const { return true; }
+
+private:
+    const Opm::EclIO::PositionedFile& source;
+    std::streamoff length;
+    std::streamoff pos = 0;
+};
+
+
+bool isEOF(MappedStream* fileH)
+{
+    return fileH->remaining() < static_cast<std::streamoff>(sizeof(int));
+}
+
+
+bool isEOF(PositionedStream* fileH)
+{
+    return fileH->remaining() < static_cast<std::streamoff>(sizeof(int));
+}
+
+
 bool isEOF(std::fstream* fileH)
 {
     int num;
@@ -69,7 +190,8 @@ bool isEOF(std::fstream* fileH)
 }
 
 
-void readBinaryHeader(std::fstream& fileH, std::string& tmpStrName,
+template <typename Stream>
+void readBinaryHeader(Stream& fileH, std::string& tmpStrName,
                       int& tmpSize, std::string& tmpStrType)
 {
     int bhead;
@@ -98,7 +220,8 @@ void readBinaryHeader(std::fstream& fileH, std::string& tmpStrName,
     }
 }
 
-void readBinaryHeader(std::fstream& fileH, std::string& arrName,
+template <typename Stream>
+void readBinaryHeader(Stream& fileH, std::string& arrName,
                       long int& size, Opm::EclIO::eclArrType &arrType)
 {
     std::string tmpStrName(8,' ');
@@ -222,19 +345,19 @@ unsigned long int sizeOnDiskFormatted(const long int num, Opm::EclIO::eclArrType
 }
 
 
-template<typename T, typename T2>
-std::vector<T> readBinaryArray(std::fstream& fileH, const long int size, Opm::EclIO::eclArrType type,
-                               std::function<T(T2)>& flip)
-{
-    std::vector<T> arr;
+// Iterate over the Fortran records holding the data of an array with size
+// elements.  Record markers are validated here while readBlock(fileH, num)
+// consumes the num elements of each record with a single read call.
 
+template<typename Stream, typename ReadBlock>
+void readBinaryBlocks(Stream& fileH, const long int size, Opm::EclIO::eclArrType type,
+                      ReadBlock&& readBlock)
+{
     auto sizeData = block_size_data_binary(type);
     int sizeOfElement = std::get<0>(sizeData);
     int maxBlockSize = std::get<1>(sizeData);
     int maxNumberOfElements = maxBlockSize / sizeOfElement;
 
-    arr.reserve(size);
-
     long int rest = size;
     while (rest > 0) {
         int dhead;
@@ -247,20 +370,15 @@ std::vector<T> readBinaryArray(std::fstream& fileH, const long int size, Opm::Ec
             OPM_THROW(std::runtime_error, "Error reading binary data, inconsistent header data or incorrect number of elements");
         }
 
-        for (int i = 0; i < num; i++) {
-            T2 value;
-            fileH.read(reinterpret_cast<char*>(&value), sizeOfElement);
-            arr.push_back(flip(value));
-        }
-
-        rest -= num;
-
-        if (( num < maxNumberOfElements && rest != 0) ||
-            (num == maxNumberOfElements && rest < 0)) {
+        if (( num < maxNumberOfElements && rest != num) || (num > rest)) {
             std::string message = "Error reading binary data, incorrect number of elements";
             OPM_THROW(std::runtime_error, message);
         }
 
+        readBlock(fileH, num);
+
+        rest -= num;
+
         int dtail;
         fileH.read(reinterpret_cast<char*>(&dtail), sizeof(dtail));
         dtail = Opm::EclIO::flipEndianInt(dtail);
@@ -269,59 +387,121 @@ std::vector<T> readBinaryArray(std::fstream& fileH, const long int size, Opm::Ec
             OPM_THROW(std::runtime_error, "Error reading binary data, tail not matching header.");
         }
     }
+}
+
+
+// INTE, REAL and DOUB records are read directly into the result vector
+// and converted in place.
+
+template<typename T, typename Stream>
+std::vector<T> readBinaryNumericArray(Stream& fileH, const long int size, Opm::EclIO::eclArrType type)
+{
+    std::vector<T> arr(size);
+    T* dst = arr.data();
+
+    readBinaryBlocks(fileH, size, type, [&dst](Stream& stream, int num)
+                                        {
+                                            stream.read(reinterpret_cast<char*>(dst), num * sizeof(T));
+                                            Opm::EclIO::flipEndian(dst, num);
+                                            dst += num;
+                                        });
 
     return arr;
 }
 
 
-std::vector<int> readBinaryInteArray(std::fstream &fileH, const long int size)
+template <typename Stream>
+std::vector<int> readBinaryInteArray(Stream& fileH, const long int size)
+{
+    return readBinaryNumericArray<int>(fileH, size, Opm::EclIO::INTE);
+}
+
+
+template <typename Stream>
+std::vector<float> readBinaryRealArray(Stream& fileH, const long int size)
 {
-    std::function<int(int)> f = Opm::EclIO::flipEndianInt;
-    return readBinaryArray<int,int>(fileH, size, Opm::EclIO::INTE, f);
+    return readBinaryNumericArray<float>(fileH, size, Opm::EclIO::REAL);
 }
 
 
-std::vector<float> readBinaryRealArray(std::fstream& fileH, const long int size)
+template <typename Stream>
+std::vector<double> readBinaryDoubArray(Stream& fileH, const long int size)
 {
-    std::function<float(float)> f = Opm::EclIO::flipEndianFloat;
-    return readBinaryArray<float,float>(fileH, size, Opm::EclIO::REAL, f);
+    return readBinaryNumericArray<double>(fileH, size, Opm::EclIO::DOUB);
 }
 
 
-std::vector<double> readBinaryDoubArray(std::fstream& fileH, const long int size)
+template <typename Stream>
+std::vector<bool> readBinaryLogiArray(Stream& fileH, const long int size)
 {
-    std::function<double(double)> f = Opm::EclIO::flipEndianDouble;
-    return readBinaryArray<double,double>(fileH, size, Opm::EclIO::DOUB, f);
+    std::vector<bool> arr;
+    arr.reserve(size);
+
+    std::vector<unsigned int> buffer(Opm::EclIO::MaxBlockSizeLogi / Opm::EclIO::sizeOfLogi);
+
+    // true_value and false_value are byte order invariant, no conversion needed
+
+    readBinaryBlocks(fileH, size, Opm::EclIO::LOGI, [&arr, &buffer](Stream& stream, int num)
+                                                    {
+                                                        stream.read(reinterpret_cast<char*>(buffer.data()), num * sizeof(unsigned int));
+
+                                                        for (int i = 0; i < num; i++) {
+                                                            if (buffer[i] == Opm::EclIO::true_value) {
+                                                                arr.push_back(true);
+                                                            } else if (buffer[i] == Opm::EclIO::false_value) {
+                                                                arr.push_back(false);
+                                                            } else {
+                                                                OPM_THROW(std::runtime_error, "Error reading logi value");
+                                                            }
+                                                        }
+                                                    });
+
+    return arr;
 }
 
-std::vector<bool> readBinaryLogiArray(std::fstream &fileH, const long int size)
+
+template <typename Stream>
+std::vector<std::string> readBinaryCharArray(Stream& fileH, const long int size)
 {
-    std::function<bool(unsigned int)> f = [](unsigned int intVal)
-                                          {
-                                              bool value;
-                                              if (intVal == Opm::EclIO::true_value) {
-                                                  value = true;
-                                              } else if (intVal == Opm::EclIO::false_value) {
-                                                  value = false;
-                                              } else {
-                                                  OPM_THROW(std::runtime_error, "Error reading logi value");
-                                              }
+    std::vector<std::string> arr;
+    arr.reserve(size);
+
+    std::vector<char> buffer(Opm::EclIO::MaxBlockSizeChar);
 
-                                              return value;
-                                          };
-    return readBinaryArray<bool,unsigned int>(fileH, size, Opm::EclIO::LOGI, f);
+    readBinaryBlocks(fileH, size, Opm::EclIO::CHAR, [&arr, &buffer](Stream& stream, int num)
+                                                    {
+                                                        stream.read(buffer.data(), num * Opm::EclIO::sizeOfChar);
+
+                                                        for (int i = 0; i < num; i++) {
+                                                            std::string res(buffer.data() + i * Opm::EclIO::sizeOfChar, Opm::EclIO::sizeOfChar);
+                                                            arr.push_back(Opm::EclIO::trimr(res));
+                                                        }
+                                                    });
+
+    return arr;
 }
 
 
-std::vector<std::string> readBinaryCharArray(std::fstream& fileH, const long int size)
+// data records of an array in a compressed file, the stream is positioned
+// at the chunk descriptor following the array header
+
+template <typename Stream>
+std::vector<char> readCompressedRecords(Stream& fileH)
 {
-    using Char8 = std::array<char, 8>;
-    std::function<std::string(Char8)> f = [](const Char8& val)
-                                          {
-                                              std::string res(val.begin(), val.end());
-                                              return Opm::EclIO::trimr(res);
-                                          };
-    return readBinaryArray<std::string,Char8>(fileH, size, Opm::EclIO::CHAR, f);
+    char descriptor[Opm::EclIO::chunkDescriptorSize];
+    fileH.read(descriptor, sizeof(descriptor));
+
+    std::uint64_t chunkSize, rawSize;
+    Opm::EclIO::readChunkDescriptor(descriptor, chunkSize, rawSize);
+
+    std::vector<char> chunk(chunkSize);
+    fileH.read(chunk.data(), chunkSize);
+
+    if (!fileH) {
+        OPM_THROW(std::runtime_error, "Error reading compressed binary data, unexpected end of file");
+    }
+
+    return Opm::EclIO::decompressChunk(chunk.data(), chunkSize, rawSize);
 }
 
 
@@ -367,119 +547,349 @@ void readFormattedHeader(std::fstream& fileH, std::string& arrName,
 }
 
 
-template<typename T>
-std::vector<T> readFormattedArray(const std::string& file_str, const int size, long int fromPos,
-                                 std::function<T(const std::string&)>& process)
+void readArrayHeader(std::fstream& fileH, bool formatted, std::string& arrName,
+                     long int& num, Opm::EclIO::eclArrType& arrType)
+{
+    if (formatted) {
+        readFormattedHeader(fileH, arrName, num, arrType);
+    } else {
+        readBinaryHeader(fileH, arrName, num, arrType);
+    }
+}
+
+
+void readArrayHeader(MappedStream& fileH, bool /* formatted */, std::string& arrName,
+                     long int& num, Opm::EclIO::eclArrType& arrType)
 {
-    std::vector<T> arr;
+    readBinaryHeader(fileH, arrName, num, arrType);
+}
+
+
+void readArrayHeader(PositionedStream& fileH, bool /* formatted */, std::string& arrName,
+                     long int& num, Opm::EclIO::eclArrType& arrType)
+{
+    readBinaryHeader(fileH, arrName, num, arrType);
+}
+
+
+// Formatted arrays are decoded directly from the text read from file.
+// Values are located with a pointer scan and converted with from_chars, no
+// strings are created for the individual values.
+
+bool isSpace(char c)
+{
+    return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t');
+}
 
-    arr.reserve(size);
 
-    long int p1=fromPos;
+class FormattedTokens
+{
+public:
+    FormattedTokens(const char* first, const char* last)
+        : pos(first), end(last)
+    {}
+
+    // next white space separated value as range [first, last)
+    std::pair<const char*, const char*> next()
+    {
+        while ((pos != end) && isSpace(*pos))
+            ++pos;
+
+        if (pos == end) {
+            OPM_THROW(std::runtime_error, "Unexpected end of data reading formatted array");
+        }
 
-    for (int i=0; i< size; i++) {
-        p1 = file_str.find_first_not_of(' ',p1);
-        long int p2 = file_str.find_first_of(' ', p1);
+        const char* first = pos;
 
-        arr.push_back(process(file_str.substr(p1, p2-p1)));
+        while ((pos != end) && !isSpace(*pos))
+            ++pos;
 
-        p1 = file_str.find_first_not_of(' ',p2);
+        return {first, pos};
     }
 
-    return arr;
+private:
+    const char* pos;
+    const char* end;
+};
+
+
+// the whole of [first, last) must be a number
+template <typename T>
+bool convertNumber(const char* first, const char* last, T& value)
+{
+#if !HAVE_FLOATING_POINT_CHARCONV
+    // std::from_chars for floating point values needs GCC 11
+    if constexpr (std::is_floating_point<T>::value) {
+        char buffer[64];
+        const auto len = static_cast<std::size_t>(last - first);
+
+        if ((len == 0) || (len >= sizeof(buffer)) || isSpace(*first) || (*first == '+'))
+            return false;
+
+        std::memcpy(buffer, first, len);
+        buffer[len] = '\0';
+
+        char* end = nullptr;
+        errno = 0;
+
+        if constexpr (std::is_same<T, float>::value) {
+            value = std::strtof(buffer, &end);
+        } else {
+            value = std::strtod(buffer, &end);
+        }
+
+        // ERANGE is also set for subnormal values, only overflow is an error
+        return (end == buffer + len) && !((errno == ERANGE) && std::isinf(value));
+    }
+#endif
+
+    const auto result = std::from_chars(first, last, value);
+    return (result.ec == std::errc()) && (result.ptr == last);
+}
+
+
+template <typename T>
+T parseFormattedNumber(const char* first, const char* last)
+{
+    const char* start = first;
+
+    if ((first != last) && (*first == '+'))
+        ++first;
+
+    T value;
+
+    if (!convertNumber(first, last, value)) {
+        std::string message = "Could not convert '" + std::string(start, last) + "' to a numeric value";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    return value;
+}
+
+
+// Fortran style double precision values use D as exponent character, and
+// exponents with three digits are written without exponent character
+// (e.g. 0.12345678901234-100).  Such values are rewritten to standard form
+// in a local buffer before conversion.
+
+double parseFormattedDouble(const char* first, const char* last)
+{
+    bool rewrite = false;
+
+    for (const char* p = first + 1; p < last; ++p) {
+        if ((*p == 'D') || (*p == 'd') ||
+            (((*p == '-') || (*p == '+')) && (p[-1] != 'E') && (p[-1] != 'e'))) {
+            rewrite = true;
+            break;
+        }
+    }
+
+    if (!rewrite)
+        return parseFormattedNumber<double>(first, last);
+
+    char buffer[64];
+    std::size_t n = 0;
+
+    for (const char* p = first; (p < last) && (n < sizeof(buffer) - 1); ++p) {
+        if ((*p == 'D') || (*p == 'd')) {
+            buffer[n++] = 'E';
+        } else if ((p != first) && ((*p == '-') || (*p == '+')) && (p[-1] != 'E') && (p[-1] != 'e') &&
+                   (p[-1] != 'D') && (p[-1] != 'd')) {
+            buffer[n++] = 'E';
+            buffer[n++] = *p;
+        } else {
+            buffer[n++] = *p;
+        }
+    }
 
+    return parseFormattedNumber<double>(buffer, buffer + n);
 }
 
 
-std::vector<int> readFormattedInteArray(const std::string& file_str, const long int size, long int fromPos)
+std::vector<int> readFormattedInteArray(const char* first, const char* last, const long int size)
 {
+    std::vector<int> arr(size);
+    FormattedTokens tokens(first, last);
 
-    std::function<int(const std::string&)> f = [](const std::string& val)
-                                               {
-                                                   return std::stoi(val);
-                                               };
+    for (long int i = 0; i < size; i++) {
+        const auto token = tokens.next();
+        arr[i] = parseFormattedNumber<int>(token.first, token.second);
+    }
 
-    return readFormattedArray(file_str, size, fromPos, f);
+    return arr;
 }
 
 
-std::vector<std::string> readFormattedCharArray(const std::string& file_str, const long int size, long int fromPos)
+std::vector<std::string> readFormattedCharArray(const char* first, const char* last, const long int size)
 {
     std::vector<std::string> arr;
     arr.reserve(size);
 
-    long int p1=fromPos;
+    const char* p = first;
+
+    for (long int i = 0; i < size; i++) {
+        p = std::find(p, last, '\'');
+
+        if (last - p < 10) {
+            OPM_THROW(std::runtime_error, "Unexpected end of data reading formatted array");
+        }
+
+        // value is 8 characters enclosed in quotes, trailing blanks removed
+
+        const char* valueEnd = p + 9;
+        while ((valueEnd > p + 1) && (valueEnd[-1] == ' '))
+            --valueEnd;
+
+        arr.emplace_back(p + 1, valueEnd);
+
+        p = p + 10;
+    }
+
+    return arr;
+}
+
+
+std::vector<float> readFormattedRealArray(const char* first, const char* last, const long int size)
+{
+    std::vector<float> arr(size);
+    FormattedTokens tokens(first, last);
+
+    for (long int i = 0; i < size; i++) {
+        const auto token = tokens.next();
+
+        // OPM flow writes numbers that are outside valid range for float,
+        // values are therefore converted as double and then narrowed
+        arr[i] = static_cast<float>(parseFormattedDouble(token.first, token.second));
+    }
+
+    return arr;
+}
+
+
+std::vector<bool> readFormattedLogiArray(const char* first, const char* last, const long int size)
+{
+    std::vector<bool> arr(size);
+    FormattedTokens tokens(first, last);
 
-    for (int i=0; i< size; i++) {
-        p1 = file_str.find_first_of('\'',p1);
-        std::string value = file_str.substr(p1 + 1, 8);
+    for (long int i = 0; i < size; i++) {
+        const auto token = tokens.next();
 
-        if (value == "        ") {
-            arr.push_back("");
+        if (*token.first == 'T') {
+            arr[i] = true;
+        } else if (*token.first == 'F') {
+            arr[i] = false;
         } else {
-            arr.push_back(Opm::EclIO::trimr(value));
+            std::string message="Could not convert '" + std::string(token.first, token.second) + "' to a bool value ";
+            OPM_THROW(std::invalid_argument, message);
         }
+    }
+
+    return arr;
+}
+
+
+std::vector<double> readFormattedDoubArray(const char* first, const char* last, const long int size)
+{
+    std::vector<double> arr(size);
+    FormattedTokens tokens(first, last);
 
-        p1 = p1+10;
+    for (long int i = 0; i < size; i++) {
+        const auto token = tokens.next();
+        arr[i] = parseFormattedDouble(token.first, token.second);
     }
 
     return arr;
 }
 
 
-std::vector<float> readFormattedRealArray(const std::string& file_str, const long int size, long int fromPos)
+// Layout of the header index file, native byte order:
+//
+//   magic (8 bytes), file size (uint64), modification time (int64),
+//   formatted flag (uint64), number of arrays (uint64)
+//
+// followed by one entry per array:
+//
+//   name (8 bytes, blank padded), type (int64), size (int64), position (uint64)
+
+const char indexMagic[8] = {'E', 'C', 'L', 'I', 'D', 'X', '0', '1'};
+
+constexpr std::size_t indexHeaderSize = 8 + 4 * sizeof(std::uint64_t);
+constexpr std::size_t indexEntrySize = 8 + 3 * sizeof(std::uint64_t);
+
+// size of binary array header record, including record markers
+constexpr long int binaryHeaderSize = 16 + 2 * sizeof(int);
+
+std::string indexFileName(const std::string& filename)
 {
+    return filename + ".idx";
+}
+
+std::int64_t modificationTime(const std::string& filename)
+{
+    return Opm::filesystem::last_write_time(filename).time_since_epoch().count();
+}
 
-    std::function<float(const std::string&)> f = [](const std::string& val)
-                                                 {
-                                                     // tskille: temporary fix, need to be discussed. OPM flow writes numbers
-                                                     // that are outside valid range for float, and function stof will fail
-                                                     double dtmpv = std::stod(val);
-                                                     return dtmpv;
-                                                 };
+template <typename T>
+T readIndexValue(const char*& ptr)
+{
+    T value;
+    std::memcpy(&value, ptr, sizeof(value));
+    ptr += sizeof(value);
+    return value;
+}
 
-    return readFormattedArray<float>(file_str, size, fromPos, f);
+template <typename T>
+void writeIndexValue(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
 }
 
+// true if the binary array header at pos matches the indexed name, size and type
 
-std::vector<bool> readFormattedLogiArray(const std::string& file_str, const long int size, long int fromPos)
+template <typename Stream>
+bool verifyBinaryHeader(Stream& fileH, unsigned long pos, const std::string& name,
+                        long int size, Opm::EclIO::eclArrType type)
 {
+    try {
+        std::string arrName(8,' ');
+        long int num;
+        Opm::EclIO::eclArrType arrType;
 
-    std::function<bool(const std::string&)> f = [](const std::string& val)
-                                                {
-                                                    if (val[0] == 'T') {
-                                                        return true;
-                                                    } else if (val[0] == 'F') {
-                                                        return false;
-                                                    } else {
-                                                        std::string message="Could not convert '" + val + "' to a bool value ";
-                                                        OPM_THROW(std::invalid_argument, message);
-                                                    }
-                                                };
+        fileH.seekg(pos, std::ios_base::beg);
+        readArrayHeader(fileH, false, arrName, num, arrType);
 
-    return readFormattedArray<bool>(file_str, size, fromPos, f);
+        return fileH && (Opm::EclIO::trimr(arrName) == name) && (num == size) && (arrType == type);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
 }
 
-std::vector<double> readFormattedDoubArray(const std::string& file_str, const long int size, long int fromPos)
+
+// approximate memory held by a loaded array
+
+template <typename T>
+std::size_t memoryUsage(const std::vector<T>& data)
 {
+    return data.capacity() * sizeof(T);
+}
 
-    std::function<double(const std::string&)> f = [](std::string val)
-                                                  {
-                                                      auto p1 = val.find_first_of("D");
+std::size_t memoryUsage(const std::vector<bool>& data)
+{
+    return (data.capacity() + 7) / 8;
+}
 
-                                                      if (p1 == std::string::npos) {
-                                                          auto p2 = val.find_first_of("-+", 1);
-                                                          if (p2 != std::string::npos) {
-                                                              val = val.insert(p2,"E");
-                                                          }
-                                                      } else {
-                                                          val.replace(p1,1,"E");
-                                                      }
+std::size_t memoryUsage(const std::vector<std::string>& data)
+{
+    std::size_t bytes = data.capacity() * sizeof(std::string);
 
-                                                      return std::stod(val);
-                                                  };
+    for (const auto& str : data) {
+        if (str.capacity() > 15) {
+            bytes += str.capacity() + 1;
+        }
+    }
 
-    return readFormattedArray<double>(file_str, size, fromPos, f);
+    return bytes;
 }
 
 } // anonymous namespace
@@ -488,39 +898,94 @@ std::vector<double> readFormattedDoubArray(const std::string& file_str, const lo
 
 namespace Opm { namespace EclIO {
 
-EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(filename)
+EclFile::EclFile(const std::string& filename, bool preload)
+    : EclFile(filename, OpenOptions{}, preload)
+{
+}
+
+
+EclFile::EclFile(const std::string& filename, const OpenOptions& options, bool preload)
+    : inputFilename(filename)
 {
     if (!fileExists(filename)){
         std::string message="Could not open EclFile: " + filename;
         OPM_THROW(std::invalid_argument, message);
     }
 
-    std::fstream fileH;
-
     formatted = isFormatted(filename);
+    compressed = !formatted && isCompressedFile(filename);
 
-    if (formatted) {
-        fileH.open(filename, std::ios::in);
+    // compressed files are decompressed array by array, they are never
+    // memory mapped
+
+    if (options.memoryMap && !formatted && !compressed) {
+        mappedFile = std::make_shared<MappedFile>(filename);
+
+        MappedStream fileH(*mappedFile);
+
+        if (options.useIndexFile) {
+            scanHeadersIndexed(fileH);
+        } else {
+            scanHeaders(fileH);
+        }
+    } else if (options.keepOpen && !formatted) {
+        positionedFile = std::make_shared<PositionedFile>(filename);
+
+        PositionedStream fileH(*positionedFile);
+        fileH.seekg(firstArrayPosition());
+
+        if (options.useIndexFile) {
+            scanHeadersIndexed(fileH);
+        } else {
+            scanHeaders(fileH);
+        }
     } else {
-        fileH.open(filename, std::ios::in |  std::ios::binary);
-    }
+        std::fstream fileH;
 
-    if (!fileH) {
-        std::string message="Could not open file: " + filename;
-        OPM_THROW(std::runtime_error, message);
+        if (formatted) {
+            fileH.open(filename, std::ios::in);
+        } else {
+            fileH.open(filename, std::ios::in |  std::ios::binary);
+        }
+
+        if (!fileH) {
+            std::string message="Could not open file: " + filename;
+            OPM_THROW(std::runtime_error, message);
+        }
+
+        fileH.seekg(firstArrayPosition());
+
+        if (options.useIndexFile) {
+            scanHeadersIndexed(fileH);
+        } else {
+            scanHeaders(fileH);
+        }
+
+        fileH.close();
     }
 
-    int n = 0;
+    cache.budget = options.cacheBudget;
+    cache.lastUse.assign(array_name.size(), 0);
+    cache.arrayBytes.assign(array_name.size(), 0);
+    cache.loading.assign(array_name.size(), false);
+
+    if (preload)
+        this->loadData();
+}
+
+
+template <typename Stream>
+void EclFile::scanHeaders(Stream& fileH)
+{
+    // scan starts at the current stream position, arrays found are appended
+    int n = static_cast<int>(array_name.size());
+
     while (!isEOF(&fileH)) {
         std::string arrName(8,' ');
         eclArrType arrType;
         long int num;
-        
-        if (formatted) {
-            readFormattedHeader(fileH,arrName,num,arrType);
-        } else {
-            readBinaryHeader(fileH,arrName,num,arrType);
-        }
+
+        readArrayHeader(fileH, formatted, arrName, num, arrType);
 
         array_size.push_back(num);
         array_type.push_back(arrType);
@@ -533,239 +998,586 @@ EclFile::EclFile(const std::string& filename, bool preload) : inputFilename(file
 
         arrayLoaded.push_back(false);
 
-        if (num > 0){ 
+        if (num > 0){
             if (formatted) {
                 unsigned long int sizeOfNextArray = sizeOnDiskFormatted(num, arrType);
                 fileH.seekg(static_cast<std::streamoff>(sizeOfNextArray), std::ios_base::cur);
+            } else if (compressed) {
+                char descriptor[chunkDescriptorSize];
+                fileH.read(descriptor, sizeof(descriptor));
+
+                std::uint64_t chunkSize, rawSize;
+                readChunkDescriptor(descriptor, chunkSize, rawSize);
+
+                fileH.seekg(static_cast<std::streamoff>(chunkSize), std::ios_base::cur);
             } else {
                 unsigned long int sizeOfNextArray = sizeOnDiskBinary(num, arrType);
                 fileH.seekg(static_cast<std::streamoff>(sizeOfNextArray), std::ios_base::cur);
             }
         }
 
-
         n++;
     };
 
     fileH.seekg(0, std::ios_base::end);
     this->ifStreamPos.push_back(static_cast<unsigned long>(fileH.tellg()));
-    fileH.close();
+}
 
-    if (preload)
-        this->loadData();
+
+template <typename Stream>
+void EclFile::scanHeadersIndexed(Stream& fileH)
+{
+    const IndexStatus status = readIndexFile(fileH);
+
+    if (status == IndexStatus::Current)
+        return;
+
+    if (status == IndexStatus::Appended) {
+        // resume scanning at the end of the indexed part of the file
+        const unsigned long indexedSize = ifStreamPos.back();
+        ifStreamPos.pop_back();
+
+        fileH.clear();
+        fileH.seekg(indexedSize, std::ios_base::beg);
+    } else {
+        fileH.clear();
+        fileH.seekg(firstArrayPosition(), std::ios_base::beg);
+    }
+
+    scanHeaders(fileH);
+    writeIndexFile();
 }
 
 
-void EclFile::loadBinaryArray(std::fstream& fileH, std::size_t arrIndex)
+template <typename Stream>
+EclFile::IndexStatus EclFile::readIndexFile(Stream& fileH)
 {
-    fileH.seekg (ifStreamPos[arrIndex], fileH.beg);
+    std::ifstream indexH(indexFileName(inputFilename), std::ios::in | std::ios::binary);
 
-    switch (array_type[arrIndex]) {
-    case INTE:
-        inte_array[arrIndex] = readBinaryInteArray(fileH, array_size[arrIndex]);
-        break;
-    case REAL:
-        real_array[arrIndex] = readBinaryRealArray(fileH, array_size[arrIndex]);
-        break;
-    case DOUB:
-        doub_array[arrIndex] = readBinaryDoubArray(fileH, array_size[arrIndex]);
-        break;
-    case LOGI:
-        logi_array[arrIndex] = readBinaryLogiArray(fileH, array_size[arrIndex]);
-        break;
-    case CHAR:
-        char_array[arrIndex] = readBinaryCharArray(fileH, array_size[arrIndex]);
-        break;
-    case MESS:
-        break;
-    default:
-        OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
-        break;
+    if (!indexH)
+        return IndexStatus::Missing;
+
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(indexH)), std::istreambuf_iterator<char>());
+
+    if ((buffer.size() < indexHeaderSize) || (std::memcmp(buffer.data(), indexMagic, sizeof(indexMagic)) != 0))
+        return IndexStatus::Missing;
+
+    const char* ptr = buffer.data() + sizeof(indexMagic);
+
+    const auto indexedSize = readIndexValue<std::uint64_t>(ptr);
+    const auto indexedTime = readIndexValue<std::int64_t>(ptr);
+    const auto indexedFormatted = readIndexValue<std::uint64_t>(ptr);
+    const auto numArrays = readIndexValue<std::uint64_t>(ptr);
+
+    if ((indexedFormatted != static_cast<std::uint64_t>(formatted)) ||
+        (buffer.size() != indexHeaderSize + numArrays * indexEntrySize))
+        return IndexStatus::Missing;
+
+    const std::uint64_t fileSize = Opm::filesystem::file_size(inputFilename);
+
+    const bool current = (fileSize == indexedSize) && (modificationTime(inputFilename) == indexedTime);
+
+    // a formatted file can only be reused if unchanged, a binary file also if
+    // new arrays have been appended after the indexed ones
+
+    if (!current && (formatted || (fileSize < indexedSize)))
+        return IndexStatus::Missing;
+
+    for (std::uint64_t n = 0; n < numArrays; n++) {
+        std::string name(ptr, 8);
+        ptr += 8;
+
+        const auto type = readIndexValue<std::int64_t>(ptr);
+        const auto size = readIndexValue<std::int64_t>(ptr);
+        const auto pos = readIndexValue<std::uint64_t>(ptr);
+
+        array_name.push_back(trimr(name));
+        array_type.push_back(static_cast<eclArrType>(type));
+        array_size.push_back(size);
+        ifStreamPos.push_back(pos);
+        array_index[array_name.back()] = static_cast<int>(n);
+        arrayLoaded.push_back(false);
+    }
+
+    ifStreamPos.push_back(indexedSize);
+
+    if (current)
+        return IndexStatus::Current;
+
+    // the file has grown, only reuse index if the first and last indexed
+    // headers are still found at the same positions
+
+    if (numArrays > 0) {
+        const std::size_t last = numArrays - 1;
+
+        if (!verifyBinaryHeader(fileH, ifStreamPos[0] - binaryHeaderSize, array_name[0], array_size[0], array_type[0]) ||
+            !verifyBinaryHeader(fileH, ifStreamPos[last] - binaryHeaderSize, array_name[last], array_size[last], array_type[last])) {
+
+            clearHeaders();
+            return IndexStatus::Missing;
+        }
+    }
+
+    return IndexStatus::Appended;
+}
+
+
+void EclFile::writeIndexFile() const
+{
+    // the index is an optional optimisation, failure to write it (e.g. in
+    // a read-only directory) is not an error
+
+    // several processes may open the same file at once, each writes its
+    // index under a unique name and the last rename wins
+
+    const std::string indexFile = indexFileName(inputFilename);
+    const std::string tmpFile = indexFile + Opm::unique_path(".%%%%-%%%%.tmp");
+
+    try {
+        std::ofstream indexH(tmpFile, std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!indexH)
+            return;
+
+        indexH.write(indexMagic, sizeof(indexMagic));
+
+        writeIndexValue<std::uint64_t>(indexH, ifStreamPos.back());
+        writeIndexValue<std::int64_t>(indexH, modificationTime(inputFilename));
+        writeIndexValue<std::uint64_t>(indexH, formatted);
+        writeIndexValue<std::uint64_t>(indexH, array_name.size());
+
+        for (std::size_t n = 0; n < array_name.size(); n++) {
+            std::string name = array_name[n];
+            name.resize(8, ' ');
+
+            indexH.write(name.data(), 8);
+            writeIndexValue<std::int64_t>(indexH, array_type[n]);
+            writeIndexValue<std::int64_t>(indexH, array_size[n]);
+            writeIndexValue<std::uint64_t>(indexH, ifStreamPos[n]);
+        }
+
+        indexH.close();
+
+        if (indexH) {
+            Opm::filesystem::rename(tmpFile, indexFile);
+        } else {
+            Opm::filesystem::remove(tmpFile);
+        }
     }
+    catch (const Opm::filesystem::filesystem_error&) {
+        std::error_code ec;
+        Opm::filesystem::remove(tmpFile, ec);
+    }
+}
+
+
+void EclFile::loadOnce(int arrIndex) const
+{
+    std::unique_lock<std::mutex> lock(loadGuard.mutex);
+
+    // other threads asking for the same array wait here until it is loaded
 
-    arrayLoaded[arrIndex] = true;
+    loadGuard.loaded.wait(lock, [this, arrIndex]() { return !cache.loading[arrIndex]; });
+
+    if (arrayLoaded[arrIndex])
+        return;
+
+    cache.loading[arrIndex] = true;
+    lock.unlock();
+
+    try {
+        this->loadArrays({arrIndex});
+    }
+    catch (...) {
+        lock.lock();
+        cache.loading[arrIndex] = false;
+        loadGuard.loaded.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    cache.loading[arrIndex] = false;
+    loadGuard.loaded.notify_all();
 }
 
-void EclFile::loadFormattedArray(const std::string& fileStr, std::size_t arrIndex, long int fromPos)
+
+template <typename T>
+void EclFile::storeArray(ArrayMap<T>& array, int arrIndex, std::vector<T>&& data) const
 {
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
+
+    // arrays already loaded are not replaced, references to them may be
+    // held by other threads
+
+    if (!arrayLoaded[arrIndex]) {
+        const std::size_t bytes = memoryUsage(data);
+
+        array[arrIndex] = std::make_shared<const std::vector<T>>(std::move(data));
+        arrayLoaded[arrIndex] = true;
+
+        registerArray(arrIndex, bytes);
+    }
+}
+
+
+void EclFile::touchArray(int arrIndex, bool hit) const
+{
+    if (hit) {
+        cache.stats.hits++;
+    } else {
+        cache.stats.misses++;
+    }
+
+    cache.lru.erase({cache.lastUse[arrIndex], arrIndex});
+    cache.lastUse[arrIndex] = ++cache.tick;
+    cache.lru.emplace(cache.lastUse[arrIndex], arrIndex);
+}
+
+
+void EclFile::registerArray(int arrIndex, std::size_t bytes) const
+{
+    cache.lastUse[arrIndex] = ++cache.tick;
+    cache.arrayBytes[arrIndex] = bytes;
+    cache.lru.emplace(cache.lastUse[arrIndex], arrIndex);
+    cache.stats.bytesResident += bytes;
+
+    // the array just loaded is the most recently used and is never released
+    // here
+
+    while ((cache.budget > 0) && (cache.stats.bytesResident > cache.budget) && (cache.lru.size() > 1)) {
+        releaseArray(cache.lru.begin()->second);
+        cache.stats.evictions++;
+    }
+}
+
+
+void EclFile::releaseArray(int arrIndex) const
+{
+    if (!arrayLoaded[arrIndex])
+        return;
 
     switch (array_type[arrIndex]) {
     case INTE:
-        inte_array[arrIndex] = readFormattedInteArray(fileStr, array_size[arrIndex], fromPos);
+        inte_array.erase(arrIndex);
         break;
     case REAL:
-        real_array[arrIndex] = readFormattedRealArray(fileStr, array_size[arrIndex], fromPos);
+        real_array.erase(arrIndex);
         break;
     case DOUB:
-        doub_array[arrIndex] = readFormattedDoubArray(fileStr, array_size[arrIndex], fromPos);
+        doub_array.erase(arrIndex);
         break;
     case LOGI:
-        logi_array[arrIndex] = readFormattedLogiArray(fileStr, array_size[arrIndex], fromPos);
+        logi_array.erase(arrIndex);
         break;
     case CHAR:
-        char_array[arrIndex] = readFormattedCharArray(fileStr, array_size[arrIndex], fromPos);
-        break;
-    case MESS:
+        char_array.erase(arrIndex);
         break;
     default:
-        OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
         break;
     }
 
-    arrayLoaded[arrIndex] = true;
+    arrayLoaded[arrIndex] = false;
+
+    cache.lru.erase({cache.lastUse[arrIndex], arrIndex});
+    cache.stats.bytesResident -= cache.arrayBytes[arrIndex];
+    cache.arrayBytes[arrIndex] = 0;
 }
 
 
-void EclFile::loadData()
+void EclFile::clearData()
 {
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
 
-    if (formatted) {
+    inte_array.clear();
+    real_array.clear();
+    doub_array.clear();
+    logi_array.clear();
+    char_array.clear();
 
-        std::vector<int> arrIndices(array_name.size());
-        std::iota(arrIndices.begin(), arrIndices.end(), 0);
+    std::fill(arrayLoaded.begin(), arrayLoaded.end(), false);
+    std::fill(cache.arrayBytes.begin(), cache.arrayBytes.end(), 0);
 
-        this->loadData(arrIndices);
+    cache.lru.clear();
+    cache.stats.bytesResident = 0;
+}
 
-    } else {
 
-        std::fstream fileH;
-        fileH.open(inputFilename, std::ios::in |  std::ios::binary);
+void EclFile::unloadData(int arrIndex)
+{
+    if ((arrIndex < 0) || (arrIndex >= static_cast<int>(array_name.size()))) {
+        std::string message = "Array index " + std::to_string(arrIndex) + " out of range";
+        OPM_THROW(std::invalid_argument, message);
+    }
 
-        if (!fileH) {
-            std::string message="Could not open file: '" + inputFilename +"'";
-            OPM_THROW(std::runtime_error, message);
-        }
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
+    releaseArray(arrIndex);
+}
 
-        for (size_t i = 0; i < array_name.size(); i++) {
-            loadBinaryArray(fileH, i);
-        }
 
-        fileH.close();
+void EclFile::unloadData(const std::vector<int>& arrIndex)
+{
+    for (int ind : arrIndex) {
+        unloadData(ind);
     }
 }
 
 
-void EclFile::loadData(const std::string& name)
+CacheStatistics EclFile::cacheStatistics() const
 {
+    std::lock_guard<std::mutex> lock(loadGuard.mutex);
+    return cache.stats;
+}
 
-    if (formatted) {
 
-        std::ifstream inFile(inputFilename);
+void EclFile::clearHeaders()
+{
+    array_name.clear();
+    array_type.clear();
+    array_size.clear();
+    ifStreamPos.clear();
+    array_index.clear();
+    arrayLoaded.clear();
+}
 
-        for (unsigned int arrIndex = 0; arrIndex < array_name.size(); arrIndex++) {
 
-            if (array_name[arrIndex] == name) {
+std::streamoff EclFile::firstArrayPosition() const
+{
+    return compressed ? static_cast<std::streamoff>(compressedFileHeaderSize) : 0;
+}
 
-                inFile.seekg(ifStreamPos[arrIndex]);
 
-                char* buffer;
-                size_t size = sizeOnDiskFormatted(array_size[arrIndex], array_type[arrIndex])+1;
-                buffer = new char [size];
-                inFile.read (buffer, size);
+template <typename Stream>
+void EclFile::loadBinaryArray(Stream& fileH, std::size_t arrIndex) const
+{
+    fileH.seekg (ifStreamPos[arrIndex], std::ios_base::beg);
 
-                std::string fileStr = std::string(buffer, size);
+    if (compressed && (array_size[arrIndex] > 0)) {
+        const std::vector<char> records = readCompressedRecords(fileH);
 
-                loadFormattedArray(fileStr, arrIndex, 0);
+        MappedStream recordsH(records.data(), records.size());
+        decodeBinaryArray(recordsH, arrIndex);
+    } else {
+        decodeBinaryArray(fileH, arrIndex);
+    }
+}
 
-                delete[] buffer;
-            }
+
+template <typename Stream>
+void EclFile::decodeBinaryArray(Stream& fileH, std::size_t arrIndex) const
+{
+    switch (array_type[arrIndex]) {
+    case INTE:
+        storeArray(inte_array, arrIndex, readBinaryInteArray(fileH, array_size[arrIndex]));
+        break;
+    case REAL:
+        storeArray(real_array, arrIndex, readBinaryRealArray(fileH, array_size[arrIndex]));
+        break;
+    case DOUB:
+        storeArray(doub_array, arrIndex, readBinaryDoubArray(fileH, array_size[arrIndex]));
+        break;
+    case LOGI:
+        storeArray(logi_array, arrIndex, readBinaryLogiArray(fileH, array_size[arrIndex]));
+        break;
+    case CHAR:
+        storeArray(char_array, arrIndex, readBinaryCharArray(fileH, array_size[arrIndex]));
+        break;
+    case MESS:
+        {
+            std::lock_guard<std::mutex> lock(loadGuard.mutex);
+            arrayLoaded[arrIndex] = true;
         }
+        break;
+    default:
+        OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
+        break;
+    }
+}
 
-    } else {
 
-        std::fstream fileH;
-        fileH.open(inputFilename, std::ios::in |  std::ios::binary);
+void EclFile::loadBinaryArrays(const std::vector<int>& arrIndex) const
+{
+    if (mappedFile) {
+        MappedStream fileH(*mappedFile);
 
-        if (!fileH) {
-            std::string message="Could not open file: '" + inputFilename +"'";
-            OPM_THROW(std::runtime_error, message);
+        for (int ind : arrIndex) {
+            loadBinaryArray(fileH, ind);
         }
 
-        for (size_t i = 0; i < array_name.size(); i++) {
-            if (array_name[i] == name) {
-                loadBinaryArray(fileH, i);
-            }
+        return;
+    }
+
+    if (positionedFile) {
+        PositionedStream fileH(*positionedFile);
+
+        for (int ind : arrIndex) {
+            loadBinaryArray(fileH, ind);
         }
 
-        fileH.close();
+        return;
     }
+
+    std::fstream fileH;
+    fileH.open(inputFilename, std::ios::in |  std::ios::binary);
+
+    if (!fileH) {
+        std::string message="Could not open file: '" + inputFilename +"'";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    for (int ind : arrIndex) {
+        loadBinaryArray(fileH, ind);
+    }
+
+    fileH.close();
 }
 
+void EclFile::loadFormattedArray(const char* first, const char* last, std::size_t arrIndex) const
+{
 
-void EclFile::loadData(const std::vector<int>& arrIndex)
+    switch (array_type[arrIndex]) {
+    case INTE:
+        storeArray(inte_array, arrIndex, readFormattedInteArray(first, last, array_size[arrIndex]));
+        break;
+    case REAL:
+        storeArray(real_array, arrIndex, readFormattedRealArray(first, last, array_size[arrIndex]));
+        break;
+    case DOUB:
+        storeArray(doub_array, arrIndex, readFormattedDoubArray(first, last, array_size[arrIndex]));
+        break;
+    case LOGI:
+        storeArray(logi_array, arrIndex, readFormattedLogiArray(first, last, array_size[arrIndex]));
+        break;
+    case CHAR:
+        storeArray(char_array, arrIndex, readFormattedCharArray(first, last, array_size[arrIndex]));
+        break;
+    case MESS:
+        {
+            std::lock_guard<std::mutex> lock(loadGuard.mutex);
+            arrayLoaded[arrIndex] = true;
+        }
+        break;
+    default:
+        OPM_THROW(std::runtime_error, "Asked to read unexpected array type");
+        break;
+    }
+}
+
+
+void EclFile::loadData()
 {
 
     if (formatted) {
 
-        std::ifstream inFile(inputFilename);
+        std::vector<int> arrIndices(array_name.size());
+        std::iota(arrIndices.begin(), arrIndices.end(), 0);
 
-        for (int ind : arrIndex) {
+        this->loadData(arrIndices);
 
-            inFile.seekg(ifStreamPos[ind]);
+    } else {
 
-            char* buffer;
-            size_t size = sizeOnDiskFormatted(array_size[ind], array_type[ind])+1;
-            buffer = new char [size];
-            inFile.read (buffer, size);
+        std::vector<int> arrIndices(array_name.size());
+        std::iota(arrIndices.begin(), arrIndices.end(), 0);
 
-            std::string fileStr = std::string(buffer, size);
+        this->loadBinaryArrays(arrIndices);
+    }
+}
 
-            loadFormattedArray(fileStr, ind, 0);
 
-            delete[] buffer;
+void EclFile::loadData(const std::string& name)
+{
+    std::vector<int> arrIndices;
+
+    for (size_t i = 0; i < array_name.size(); i++) {
+        if (array_name[i] == name) {
+            arrIndices.push_back(i);
         }
+    }
 
-    } else {
-        std::fstream fileH;
-        fileH.open(inputFilename, std::ios::in |  std::ios::binary);
+    this->loadData(arrIndices);
+}
 
-        if (!fileH) {
-            std::string message="Could not open file: '" + inputFilename +"'";
-            OPM_THROW(std::runtime_error, message);
-        }
 
-        for (int ind : arrIndex) {
-            loadBinaryArray(fileH, ind);
-        }
+void EclFile::loadData(const std::vector<int>& arrIndex)
+{
+    this->loadArrays(arrIndex);
+}
 
-        fileH.close();
+
+void EclFile::loadArrays(const std::vector<int>& arrIndex) const
+{
+    if (formatted) {
+        this->loadFormattedArrays(arrIndex);
+    } else {
+        this->loadBinaryArrays(arrIndex);
     }
 }
 
 
 void EclFile::loadData(int arrIndex)
 {
+    this->loadData(std::vector<int>{arrIndex});
+}
 
-    if (formatted) {
 
-        std::ifstream inFile(inputFilename);
+void EclFile::loadFormattedArrays(const std::vector<int>& arrIndex) const
+{
+    // text of the arrays is read in batches of limited size, the arrays of
+    // a batch are then decoded concurrently
 
-            inFile.seekg(ifStreamPos[arrIndex]);
+    const std::size_t maxBatchSize = 64 * 1024 * 1024;
 
-            char* buffer;
-            size_t size = sizeOnDiskFormatted(array_size[arrIndex], array_type[arrIndex])+1;
-            buffer = new char [size];
-            inFile.read (buffer, size);
+    std::ifstream inFile(inputFilename, std::ios::in | std::ios::binary);
 
-            std::string fileStr = std::string(buffer, size);
+    if (!inFile) {
+        std::string message="Could not open file: '" + inputFilename +"'";
+        OPM_THROW(std::runtime_error, message);
+    }
 
-            loadFormattedArray(fileStr, arrIndex, 0);
+    std::size_t next = 0;
 
-            delete[] buffer;
+    while (next < arrIndex.size()) {
+        std::vector<int> batch;
+        std::vector<std::vector<char>> text;
+        std::size_t batchSize = 0;
 
+        while ((next < arrIndex.size()) && (batch.empty() || (batchSize < maxBatchSize))) {
+            const int ind = arrIndex[next++];
+            const std::size_t size = sizeOnDiskFormatted(array_size[ind], array_type[ind]) + 1;
 
-    } else {
-        std::fstream fileH;
-        fileH.open(inputFilename, std::ios::in |  std::ios::binary);
+            text.emplace_back(size);
 
-        if (!fileH) {
-            std::string message="Could not open file: '" + inputFilename +"'";
-            OPM_THROW(std::runtime_error, message);
+            inFile.clear();
+            inFile.seekg(ifStreamPos[ind]);
+            inFile.read(text.back().data(), size);
+            text.back().resize(inFile.gcount());
+
+            batch.push_back(ind);
+            batchSize += size;
         }
 
-        loadBinaryArray(fileH, arrIndex);
+        std::exception_ptr error;
 
-        fileH.close();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (batch.size() > 1)
+#endif
+        for (int b = 0; b < static_cast<int>(batch.size()); b++) {
+            try {
+                const char* first = text[b].data();
+                loadFormattedArray(first, first + text[b].size(), batch[b]);
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
     }
 }
 
@@ -817,6 +1629,97 @@ const std::vector<std::string>& EclFile::get<std::string>(int arrIndex)
 }
 
 
+template <typename T>
+MappedArray<T> EclFile::getMappedImpl(int arrIndex, eclArrType type, const std::string& typeStr) const
+{
+    if (!mappedFile) {
+        OPM_THROW(std::runtime_error, "File '" + inputFilename + "' is not memory mapped");
+    }
+
+    if ((arrIndex < 0) || (arrIndex >= static_cast<int>(array_name.size()))) {
+        std::string message = "Array index " + std::to_string(arrIndex) + " out of range";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    if (array_type[arrIndex] != type) {
+        std::string message = "Array with index " + std::to_string(arrIndex) + " is not of type " + typeStr;
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    const auto pos = ifStreamPos[arrIndex];
+
+    if (pos + sizeOnDiskBinary(array_size[arrIndex], type) > mappedFile->size()) {
+        std::string message = "Array with index " + std::to_string(arrIndex) + " extends beyond end of file";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    return MappedArray<T>(mappedFile, mappedFile->data() + pos, array_size[arrIndex]);
+}
+
+
+template<>
+MappedArray<int> EclFile::getMapped<int>(int arrIndex) const
+{
+    return getMappedImpl<int>(arrIndex, INTE, "integer");
+}
+
+
+template<>
+MappedArray<float> EclFile::getMapped<float>(int arrIndex) const
+{
+    return getMappedImpl<float>(arrIndex, REAL, "float");
+}
+
+
+template<>
+MappedArray<double> EclFile::getMapped<double>(int arrIndex) const
+{
+    return getMappedImpl<double>(arrIndex, DOUB, "double");
+}
+
+
+template<>
+MappedArray<int> EclFile::getMapped<int>(const std::string& name) const
+{
+    auto search = array_index.find(name);
+
+    if (search == array_index.end()) {
+        std::string message="key '"+name + "' not found";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    return getMappedImpl<int>(search->second, INTE, "integer");
+}
+
+
+template<>
+MappedArray<float> EclFile::getMapped<float>(const std::string& name) const
+{
+    auto search = array_index.find(name);
+
+    if (search == array_index.end()) {
+        std::string message="key '"+name + "' not found";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    return getMappedImpl<float>(search->second, REAL, "float");
+}
+
+
+template<>
+MappedArray<double> EclFile::getMapped<double>(const std::string& name) const
+{
+    auto search = array_index.find(name);
+
+    if (search == array_index.end()) {
+        std::string message="key '"+name + "' not found";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    return getMappedImpl<double>(search->second, DOUB, "double");
+}
+
+
 bool EclFile::hasKey(const std::string &name) const
 {
     auto search = array_index.find(name);
@@ -947,6 +1850,57 @@ const std::vector<std::string>& EclFile::get<std::string>(const std::string &nam
 }
 
 
+template<>
+std::shared_ptr<const std::vector<int>> EclFile::getShared<int>(int arrIndex) const
+{
+    return getSharedImpl(arrIndex, INTE, inte_array, "integer");
+}
+
+template<>
+std::shared_ptr<const std::vector<float>> EclFile::getShared<float>(int arrIndex) const
+{
+    return getSharedImpl(arrIndex, REAL, real_array, "float");
+}
+
+template<>
+std::shared_ptr<const std::vector<double>> EclFile::getShared<double>(int arrIndex) const
+{
+    return getSharedImpl(arrIndex, DOUB, doub_array, "double");
+}
+
+template<>
+std::shared_ptr<const std::vector<bool>> EclFile::getShared<bool>(int arrIndex) const
+{
+    return getSharedImpl(arrIndex, LOGI, logi_array, "bool");
+}
+
+template<>
+std::shared_ptr<const std::vector<std::string>> EclFile::getShared<std::string>(int arrIndex) const
+{
+    return getSharedImpl(arrIndex, CHAR, char_array, "string");
+}
+
+
+template <typename T>
+std::shared_ptr<const std::vector<T>> EclFile::getShared(const std::string& name) const
+{
+    auto search = array_index.find(name);
+
+    if (search == array_index.end()) {
+        std::string message="key '"+name + "' not found";
+        OPM_THROW(std::invalid_argument, message);
+    }
+
+    return getShared<T>(search->second);
+}
+
+template std::shared_ptr<const std::vector<int>> EclFile::getShared<int>(const std::string&) const;
+template std::shared_ptr<const std::vector<float>> EclFile::getShared<float>(const std::string&) const;
+template std::shared_ptr<const std::vector<double>> EclFile::getShared<double>(const std::string&) const;
+template std::shared_ptr<const std::vector<bool>> EclFile::getShared<bool>(const std::string&) const;
+template std::shared_ptr<const std::vector<std::string>> EclFile::getShared<std::string>(const std::string&) const;
+
+
 std::size_t EclFile::size() const {
     return this->array_name.size();
 }
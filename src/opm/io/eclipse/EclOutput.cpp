@@ -16,33 +16,96 @@
    along with OPM.  If not, see <http://www.gnu.org/licenses/>.
    */
 
+#include "config.h"
+
 #include <opm/io/eclipse/EclOutput.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
 
+#include "Compression.hpp"
+#include "FormattedNumbers.hpp"
+
 #include <opm/common/ErrorMacros.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iterator>
-#include <iomanip>
-#include <iostream>
 #include <ios>
-#include <sstream>
+#include <limits>
 #include <stdexcept>
-#include <typeinfo>
+#include <type_traits>
+
+namespace {
+
+namespace Formatted = Opm::EclIO::Formatted;
+using Formatted::copyText;
+
+// right justify the text [first, last) in a field of width characters
+char* justify(const char* first, const char* last, int width, char* out)
+{
+    const int len = static_cast<int>(last - first);
+
+    if (len < width) {
+        std::memset(out, ' ', width - len);
+        out += width - len;
+    }
+
+    std::memcpy(out, first, len);
+    return out + len;
+}
+
+template <typename T>
+char* encodeFormatted(const T& value, int columnWidth, char* out)
+{
+    char text[32];
+    char* last = text;
+
+    if constexpr (std::is_same<T, int>::value) {
+        last = std::to_chars(text, text + sizeof(text), value).ptr;
+    } else if constexpr (std::is_same<T, float>::value) {
+        last = Formatted::encodeReal(value, text);
+    } else if constexpr (std::is_same<T, double>::value) {
+        last = Formatted::encodeDoub(value, text);
+    } else {
+        return copyText(value ? "  T" : "  F", out);
+    }
+
+    return justify(text, last, columnWidth, out);
+}
+
+bool hasContents(const std::string& filename)
+{
+    std::ifstream fileH(filename, std::ios::in | std::ios::binary);
+    return fileH && (fileH.peek() != std::ifstream::traits_type::eof());
+}
+
+} // anonymous namespace
 
 namespace Opm { namespace EclIO {
 
 EclOutput::EclOutput(const std::string&            filename,
                      const bool                    formatted,
-                     const std::ios_base::openmode mode)
+                     const std::ios_base::openmode mode,
+                     const bool                    compressed)
     : isFormatted{formatted}
+    , isCompressed{compressed && !formatted}
 {
     const auto binmode = mode | std::ios_base::binary;
+    const bool append = ((mode & std::ios_base::app) != 0) && hasContents(filename);
+
+    if (!isFormatted && append && (isCompressedFile(filename) != isCompressed)) {
+        std::string message = "Cannot append " + std::string(isCompressed ? "compressed" : "uncompressed")
+            + " output to file '" + filename + "' with different compression";
+        OPM_THROW(std::invalid_argument, message);
+    }
 
     this->ofileH.open(filename, this->isFormatted ? mode : binmode);
+
+    if (isCompressed && !append)
+        writeCompressedFileHeader(this->ofileH);
 }
 
 
@@ -59,6 +122,7 @@ void EclOutput::write<std::string>(const std::string& name,
     {
         writeBinaryHeader(name, data.size(), CHAR);
         writeBinaryCharArray(data);
+        endBinaryArray();
     }
 }
 
@@ -74,9 +138,53 @@ void EclOutput::write<PaddedOutputString<8>>
     else {
         writeBinaryHeader(name, data.size(), CHAR);
         writeBinaryCharArray(data);
+        endBinaryArray();
+    }
+}
+
+template <typename T>
+void EclOutput::writeBlocks(const std::string& name, std::size_t size,
+                            const std::function<void(std::size_t, std::size_t, T*)>& fill)
+{
+    constexpr eclArrType arrType = arrayType<T>();
+
+    static_assert((arrType == REAL) || (arrType == DOUB), "writeBlocks supports float and double only");
+
+    // chunks are a multiple of the 1000 elements in binary records and in
+    // blocks of formatted output, each chunk is therefore written exactly
+    // as the corresponding part of the complete array
+
+    constexpr std::size_t chunkSize = 64 * 1000;
+
+    if (isFormatted)
+        writeFormattedHeader(name, size, arrType);
+    else
+        writeBinaryHeader(name, size, arrType);
+
+    std::vector<T> chunk;
+    chunk.reserve(std::min(size, chunkSize));
+
+    for (std::size_t first = 0; first < size; first += chunkSize) {
+        const std::size_t num = std::min(chunkSize, size - first);
+
+        chunk.resize(num);
+        fill(first, num, chunk.data());
+
+        if (isFormatted)
+            writeFormattedArray(chunk);
+        else
+            writeBinaryArray(chunk);
     }
+
+    if (!isFormatted)
+        endBinaryArray();
 }
 
+template void EclOutput::writeBlocks<float>(const std::string&, std::size_t,
+                                            const std::function<void(std::size_t, std::size_t, float*)>&);
+template void EclOutput::writeBlocks<double>(const std::string&, std::size_t,
+                                             const std::function<void(std::size_t, std::size_t, double*)>&);
+
 void EclOutput::message(const std::string& msg)
 {
     // Generate message, i.e., output vector of type eclArrType::MESS,
@@ -93,382 +201,293 @@ void EclOutput::flushStream()
 
 void EclOutput::writeBinaryHeader(const std::string&arrName, long int size, eclArrType arrType)
 {
-    int bhead = flipEndianInt(16);
-    std::string name = arrName + std::string(8 - arrName.size(),' ');
+    // header records, including the X231 record if the size is larger than
+    // the limit for 4 byte integers, are composed here and written at once
+
+    char buffer[48];
+    char* out = buffer;
+
+    const int bhead = flipEndianInt(16);
+    const std::string name = arrName + std::string(8 - arrName.size(),' ');
+
+    auto addRecord = [&out, &bhead, &name](int value, const char* typeStr)
+    {
+        const int flipped = flipEndianInt(value);
+
+        std::memcpy(out, &bhead, sizeof(bhead));
+        std::memcpy(out + 4, name.c_str(), 8);
+        std::memcpy(out + 12, &flipped, sizeof(flipped));
+        std::memcpy(out + 16, typeStr, 4);
+        std::memcpy(out + 20, &bhead, sizeof(bhead));
+
+        out += 24;
+    };
 
-    // write X231 header if size larger that limits for 4 byte integers
     if (size > std::numeric_limits<int>::max()) {
         long int val231 = std::pow(2,31);
         long int x231 = size / val231;
 
-        int flippedx231 = flipEndianInt(static_cast<int>( (-1)*x231 ));
-        
-        ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
-        ofileH.write(name.c_str(), 8);
-        ofileH.write(reinterpret_cast<char*>(&flippedx231), sizeof(flippedx231));
-        ofileH.write("X231", 4);
-        ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
-        
+        addRecord(static_cast<int>( (-1)*x231 ), "X231");
+
         size = size - (x231 * val231);
     }
 
-    int flippedSize = flipEndianInt(size);
-
-    ofileH.write(reinterpret_cast<char*>(&bhead), sizeof(bhead));
-
-    ofileH.write(name.c_str(), 8);
-    ofileH.write(reinterpret_cast<char*>(&flippedSize), sizeof(flippedSize));
-
     switch(arrType) {
     case INTE:
-        ofileH.write("INTE", 4);
+        addRecord(size, "INTE");
         break;
     case REAL:
-        ofileH.write("REAL", 4);
+        addRecord(size, "REAL");
         break;
     case DOUB:
-        ofileH.write("DOUB", 4);
+        addRecord(size, "DOUB");
         break;
     case LOGI:
-        ofileH.write("LOGI", 4);
+        addRecord(size, "LOGI");
         break;
     case CHAR:
-        ofileH.write("CHAR", 4);
+        addRecord(size, "CHAR");
         break;
     case MESS:
-        ofileH.write("MESS", 4);
+        addRecord(size, "MESS");
         break;
     }
 
-    ofileH.write(reinterpret_cast<char *>(&bhead), sizeof(bhead));
+    ofileH.write(buffer, out - buffer);
 }
 
-template <typename T>
-void EclOutput::writeBinaryArray(const std::vector<T>& data)
+
+// Data records are written directly to binary files, and collected for
+// compression in compressed files.
+
+void EclOutput::writeBinaryData(const char* data, std::size_t size)
 {
-    int num, rval;
-    long int rest;
-    int dhead;
-    float value_f;
-    double value_d;
-    int intVal;
-
-    long int n = 0;
-    long int size = data.size();
-
-    eclArrType arrType = MESS;
-
-    if (typeid(std::vector<T>) == typeid(std::vector<int>)) {
-        arrType = INTE;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<float>)) {
-        arrType = REAL;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<double>)) {
-        arrType = DOUB;
-    } else if (typeid(std::vector<T>) == typeid(std::vector<bool>)) {
-        arrType = LOGI;
-    }
+    if (isCompressed)
+        pendingRecords.insert(pendingRecords.end(), data, data + size);
+    else
+        ofileH.write(data, size);
+}
 
-    auto sizeData = block_size_data_binary(arrType);
 
-    int sizeOfElement = std::get<0>(sizeData);
-    int maxBlockSize = std::get<1>(sizeData);
-    int maxNumberOfElements = maxBlockSize / sizeOfElement;
+void EclOutput::endBinaryArray()
+{
+    if (!isCompressed || pendingRecords.empty())
+        return;
 
-    if (!ofileH.is_open()) {
-        OPM_THROW(std::runtime_error, "fstream fileH not open for writing");
-    }
+    writeCompressedChunk(ofileH, pendingRecords);
+    pendingRecords.clear();
+}
 
-    rest = size * static_cast<long int>(sizeOfElement);
-    while (rest > 0) {
-        if (rest > maxBlockSize) {
-            rest -= maxBlockSize;
-            num = maxNumberOfElements;
-        } else {
-            num = static_cast<int>(rest) / sizeOfElement;
-            rest = 0;
-        }
 
-        dhead = flipEndianInt(num * sizeOfElement);
-
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
-
-        for (int i = 0; i < num; i++) {
-            if (arrType == INTE) {
-                rval = flipEndianInt(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&rval), sizeof(rval));
-            } else if (arrType == REAL) {
-                value_f = flipEndianFloat(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&value_f), sizeof(value_f));
-            } else if (arrType == DOUB) {
-                value_d = flipEndianDouble(data[n]);
-                ofileH.write(reinterpret_cast<char*>(&value_d), sizeof(value_d));
-            } else if (arrType == LOGI) {
-                intVal = data[n] ? true_value : false_value;
-                ofileH.write(reinterpret_cast<char*>(&intVal), sizeOfElement);
-            } else {
-                std::cerr << "type not supported in write binaryarray\n";
-                std::exit(EXIT_FAILURE);
-            }
+// Encodes the array in Fortran records of at most the maximum block size,
+// each record framed by its length markers.  Records are collected in the
+// staging buffer which is written with a single call when full, so the
+// number of stream writes does not depend on the number of elements.
+// encode(dst, first, num) stores elements first, ..., first+num-1 at dst.
 
-            n++;
-        }
+template <typename Encode>
+void EclOutput::writeBinaryRecords(std::size_t size, eclArrType arrType, Encode&& encode)
+{
+    constexpr std::size_t stageBytes = 1024 * 1024;
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+    if (!ofileH.is_open()) {
+        OPM_THROW(std::runtime_error, "fstream fileH not open for writing");
     }
-}
 
+    const auto sizeData = block_size_data_binary(arrType);
 
-template void EclOutput::writeBinaryArray<int>(const std::vector<int>& data);
-template void EclOutput::writeBinaryArray<float>(const std::vector<float>& data);
-template void EclOutput::writeBinaryArray<double>(const std::vector<double>& data);
-template void EclOutput::writeBinaryArray<bool>(const std::vector<bool>& data);
-template void EclOutput::writeBinaryArray<char>(const std::vector<char>& data);
+    const std::size_t sizeOfElement = std::get<0>(sizeData);
+    const std::size_t maxBlockSize = std::get<1>(sizeData);
+    const std::size_t maxNumberOfElements = maxBlockSize / sizeOfElement;
+    const std::size_t recordBytes = maxBlockSize + 2 * sizeof(int);
 
+    const std::size_t totalBytes = size * sizeOfElement
+        + ((size + maxNumberOfElements - 1) / maxNumberOfElements) * 2 * sizeof(int);
 
-void EclOutput::writeBinaryCharArray(const std::vector<std::string>& data)
-{
-    int num,dhead;
+    const std::size_t bufferBytes = std::min(totalBytes, std::max(stageBytes, recordBytes));
 
-    int n = 0;
-    int size = data.size();
+    if (stage.size() < bufferBytes)
+        stage.resize(bufferBytes);
 
-    auto sizeData = block_size_data_binary(CHAR);
+    char* const begin = stage.data();
+    char* const end = begin + stage.size();
+    char* out = begin;
 
-    int sizeOfElement = std::get<0>(sizeData);
-    int maxBlockSize = std::get<1>(sizeData);
-    int maxNumberOfElements = maxBlockSize / sizeOfElement;
+    std::size_t n = 0;
 
-    int rest = size * sizeOfElement;
+    while (n < size) {
+        const std::size_t num = std::min(maxNumberOfElements, size - n);
+        const int dhead = flipEndianInt(static_cast<int>(num * sizeOfElement));
 
-    if (!ofileH.is_open()) {
-        OPM_THROW(std::runtime_error,"fstream fileH not open for writing");
-    }
-
-    while (rest > 0) {
-        if (rest > maxBlockSize) {
-            rest -= maxBlockSize;
-            num = maxNumberOfElements;
-        } else {
-            num = rest / sizeOfElement;
-            rest = 0;
+        if (static_cast<std::size_t>(end - out) < num * sizeOfElement + 2 * sizeof(int)) {
+            writeBinaryData(begin, out - begin);
+            out = begin;
         }
 
-        dhead = flipEndianInt(num * sizeOfElement);
+        std::memcpy(out, &dhead, sizeof(dhead));
+        out += sizeof(dhead);
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        encode(out, n, num);
+        out += num * sizeOfElement;
 
-        for (int i = 0; i < num; i++) {
-            std::string tmpStr = data[n] + std::string(8 - data[n].size(),' ');
-            ofileH.write(tmpStr.c_str(), sizeOfElement);
-            n++;
-        }
+        std::memcpy(out, &dhead, sizeof(dhead));
+        out += sizeof(dhead);
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+        n += num;
     }
-}
 
-void EclOutput::writeBinaryCharArray(const std::vector<PaddedOutputString<8>>& data)
-{
-    const auto size = data.size();
+    if (out != begin)
+        writeBinaryData(begin, out - begin);
+}
 
-    const auto sizeData = block_size_data_binary(CHAR);
 
-    const int sizeOfElement       = std::get<0>(sizeData);
-    const int maxBlockSize        = std::get<1>(sizeData);
-    const int maxNumberOfElements = maxBlockSize / sizeOfElement;
+template <typename T>
+void EclOutput::writeBinaryArray(const std::vector<T>& data)
+{
+    constexpr eclArrType arrType = arrayType<T>();
 
-    int rest = size * sizeOfElement;
+    static_assert(arrType != MESS, "Unsupported element type in writeBinaryArray");
 
-    if (!ofileH.is_open()) {
-        OPM_THROW(std::runtime_error,"fstream fileH not open for writing");
-    }
+    writeBinaryRecords(data.size(), arrType, [&data](char* dst, std::size_t first, std::size_t num)
+    {
+        if constexpr (std::is_same<T, bool>::value) {
+            for (std::size_t i = 0; i < num; i++) {
+                const unsigned int value = data[first + i] ? true_value : false_value;
+                std::memcpy(dst + i * sizeof(value), &value, sizeof(value));
+            }
+        } else {
+            flipEndian(data.data() + first, dst, num);
+        }
+    });
+}
 
-    auto elm = data.begin();
-    while (rest > 0) {
-        const auto numElm = (rest > maxBlockSize)
-            ? maxNumberOfElements
-            : rest / sizeOfElement;
 
-        rest = (rest > maxBlockSize) ? rest - maxBlockSize : 0;
+template void EclOutput::writeBinaryArray<int>(const std::vector<int>& data);
+template void EclOutput::writeBinaryArray<float>(const std::vector<float>& data);
+template void EclOutput::writeBinaryArray<double>(const std::vector<double>& data);
+template void EclOutput::writeBinaryArray<bool>(const std::vector<bool>& data);
 
-        auto dhead = flipEndianInt(numElm * sizeOfElement);
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
+void EclOutput::writeBinaryCharArray(const std::vector<std::string>& data)
+{
+    writeBinaryRecords(data.size(), CHAR, [&data](char* dst, std::size_t first, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++) {
+            const auto& str = data[first + i];
+            const std::size_t len = std::min(str.size(), std::size_t{8});
 
-        for (auto i = 0*numElm; i < numElm; ++i, ++elm) {
-            ofileH.write(elm->c_str(), sizeOfElement);
+            std::memcpy(dst + i * 8, str.data(), len);
+            std::memset(dst + i * 8 + len, ' ', 8 - len);
         }
+    });
+}
 
-        ofileH.write(reinterpret_cast<char*>(&dhead), sizeof(dhead));
-    }
+void EclOutput::writeBinaryCharArray(const std::vector<PaddedOutputString<8>>& data)
+{
+    writeBinaryRecords(data.size(), CHAR, [&data](char* dst, std::size_t first, std::size_t num)
+    {
+        for (std::size_t i = 0; i < num; i++) {
+            std::memcpy(dst + i * 8, data[first + i].c_str(), 8);
+        }
+    });
 }
 
 void EclOutput::writeFormattedHeader(const std::string& arrName, int size, eclArrType arrType)
 {
-    std::string name = arrName + std::string(8 - arrName.size(),' ');
+    char buffer[64];
+    char* out = buffer;
+
+    const std::string name = arrName + std::string(8 - arrName.size(),' ');
+
+    out = copyText(" '", out);
+    out = copyText(name.c_str(), out);
+    out = copyText("' ", out);
 
-    ofileH << " '" << name << "' " << std::setw(11) << size;
+    char sizeStr[16];
+    out = justify(sizeStr, std::to_chars(sizeStr, sizeStr + sizeof(sizeStr), size).ptr, 11, out);
 
     switch (arrType) {
     case INTE:
-        ofileH << " 'INTE'" <<  std::endl;
+        out = copyText(" 'INTE'\n", out);
         break;
     case REAL:
-        ofileH << " 'REAL'" <<  std::endl;
+        out = copyText(" 'REAL'\n", out);
         break;
     case DOUB:
-        ofileH << " 'DOUB'" <<  std::endl;
+        out = copyText(" 'DOUB'\n", out);
         break;
     case LOGI:
-        ofileH << " 'LOGI'" <<  std::endl;
+        out = copyText(" 'LOGI'\n", out);
         break;
     case CHAR:
-        ofileH << " 'CHAR'" <<  std::endl;
+        out = copyText(" 'CHAR'\n", out);
         break;
     case MESS:
-        ofileH << " 'MESS'" <<  std::endl;
+        out = copyText(" 'MESS'\n", out);
         break;
     }
-}
-
-
-std::string EclOutput::make_real_string(float value) const
-{
-    char buffer [15];
-    std::sprintf (buffer, "%10.7E", value);
-
-    if (value == 0.0) {
-        return "0.00000000E+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
 
-        int exp =  value < 0.0 ? std::stoi(tmpstr.substr(11, 3)) :  std::stoi(tmpstr.substr(10, 3));
+    ofileH.write(buffer, out - buffer);
 
-        if (value < 0.0) {
-            tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 7) + "E";
-        } else {
-            tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 7) +"E";
-        }
-
-        std::sprintf (buffer, "%+03i", exp+1);
-        tmpstr = tmpstr+buffer;
-
-        return tmpstr;
-    }
+    // no data follows a message, flushed as a complete array
+    if (arrType == MESS)
+        ofileH.flush();
 }
 
 
-std::string EclOutput::make_doub_string(double value) const
-{
-    char buffer [21];
-    std::sprintf (buffer, "%19.13E", value);
+// The lines of a block of values are composed in the staging buffer and
+// written to the stream when the block is complete.  The stream is flushed
+// once the array is written, not for every line.
 
-    if (value == 0.0) {
-        return "0.00000000000000D+00";
-    } else {
-        if (std::isnan(value))
-            return "NAN";
-
-        if (std::isinf(value)) {
-            if (value > 0)
-                return "INF";
-            else
-                return "-INF";
-        }
-
-        std::string tmpstr(buffer);
-        int exp = value < 0.0 ? std::stoi(tmpstr.substr(17, 4)) : std::stoi(tmpstr.substr(16, 4));
+template <typename T>
+void EclOutput::writeFormattedArray(const std::vector<T>& data)
+{
+    constexpr eclArrType arrType = arrayType<T>();
 
-        if (value < 0.0) {
-            if (std::abs(exp) < 100) {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13) + "D";
-            } else {
-                tmpstr = "-0." + tmpstr.substr(1, 1) + tmpstr.substr(3, 13);
-            }
-        } else {
-            if (std::abs(exp) < 100) {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13) + "D";
-            } else {
-                tmpstr = "0." + tmpstr.substr(0, 1) + tmpstr.substr(2, 13);
-            }
-        }
+    static_assert(arrType != MESS, "Unsupported element type in writeFormattedArray");
 
-        std::sprintf(buffer, "%+03i", exp + 1);
-        tmpstr = tmpstr + buffer;
-        return tmpstr;
-    }
-}
+    const auto sizeData = block_size_data_formatted(arrType);
 
+    const int maxBlockSize = std::get<0>(sizeData);
+    const int nColumns = std::get<1>(sizeData);
+    const int columnWidth = std::get<2>(sizeData);
 
-template <typename T>
-void EclOutput::writeFormattedArray(const std::vector<T>& data)
-{
-    int size = data.size();
-    int n = 0;
+    // longest encoded value is 21 characters ("-0.12345678901234-100")
+    const std::size_t maxBlockBytes = maxBlockSize * (std::max(columnWidth, 21) + 1) + 1;
 
-    eclArrType arrType = MESS;
-    if (typeid(T) == typeid(int)) {
-        arrType = INTE;
-    } else if (typeid(T) == typeid(float)) {
-        arrType = REAL;
-    } else if (typeid(T) == typeid(double)) {
-        arrType = DOUB;
-    } else if (typeid(T) == typeid(bool)) {
-        arrType = LOGI;
-    }
+    if (stage.size() < maxBlockBytes)
+        stage.resize(maxBlockBytes);
 
-    auto sizeData = block_size_data_formatted(arrType);
+    char* const begin = stage.data();
+    char* out = begin;
 
-    int maxBlockSize = std::get<0>(sizeData);
-    int nColumns = std::get<1>(sizeData);
-    int columnWidth = std::get<2>(sizeData);
+    const int size = data.size();
+    int n = 0;
 
     for (int i = 0; i < size; i++) {
         n++;
 
-        switch (arrType) {
-        case INTE:
-            ofileH << std::setw(columnWidth) << data[i];
-            break;
-        case REAL:
-            ofileH << std::setw(columnWidth) << make_real_string(data[i]);
-            break;
-        case DOUB:
-            ofileH << std::setw(columnWidth) << make_doub_string(data[i]);
-            break;
-        case LOGI:
-            if (data[i]) {
-                ofileH << "  T";
-            } else {
-                ofileH << "  F";
-            }
-            break;
-        default:
-            break;
-        }
+        out = encodeFormatted<T>(data[i], columnWidth, out);
 
         if ((n % nColumns) == 0 || (n % maxBlockSize) == 0) {
-            ofileH << std::endl;
+            *out++ = '\n';
         }
 
         if ((n % maxBlockSize) == 0) {
+            ofileH.write(begin, out - begin);
+            out = begin;
             n=0;
         }
     }
 
     if ((n % nColumns) != 0 && (n % maxBlockSize) != 0) {
-        ofileH << std::endl;
+        *out++ = '\n';
     }
+
+    if (out != begin)
+        ofileH.write(begin, out - begin);
+
+    ofileH.flush();
 }
 
 
@@ -476,52 +495,70 @@ template void EclOutput::writeFormattedArray<int>(const std::vector<int>& data);
 template void EclOutput::writeFormattedArray<float>(const std::vector<float>& data);
 template void EclOutput::writeFormattedArray<double>(const std::vector<double>& data);
 template void EclOutput::writeFormattedArray<bool>(const std::vector<bool>& data);
-template void EclOutput::writeFormattedArray<char>(const std::vector<char>& data);
 
 
-void EclOutput::writeFormattedCharArray(const std::vector<std::string>& data)
+template <typename Encode>
+void EclOutput::writeFormattedCharRecords(std::size_t size, Encode&& encode)
 {
-    auto sizeData = block_size_data_formatted(CHAR);
+    const auto sizeData = block_size_data_formatted(CHAR);
 
-    int nColumns = std::get<1>(sizeData);
+    const std::size_t nColumns = std::get<1>(sizeData);
 
-    int size = data.size();
+    // each line holds nColumns values of 11 characters: " 'xxxxxxxx'"
+    const std::size_t lineBytes = nColumns * 11 + 1;
+    const std::size_t linesPerWrite = 1024;
 
-    for (int i = 0; i < size; i++) {
-        std::string str1(8,' ');
-        str1 = data[i] + std::string(8 - data[i].size(),' ');
+    if (stage.size() < lineBytes * linesPerWrite)
+        stage.resize(lineBytes * linesPerWrite);
+
+    char* const begin = stage.data();
+    char* const end = begin + stage.size();
+    char* out = begin;
 
-        ofileH << " '" << str1 << "'";
+    for (std::size_t i = 0; i < size; i++) {
+        *out++ = ' ';
+        *out++ = '\'';
+        encode(i, out);
+        out += 8;
+        *out++ = '\'';
 
         if ((i+1) % nColumns == 0) {
-            ofileH  << std::endl;
+            *out++ = '\n';
+
+            if (static_cast<std::size_t>(end - out) < lineBytes) {
+                ofileH.write(begin, out - begin);
+                out = begin;
+            }
         }
     }
 
     if ((size % nColumns) != 0) {
-        ofileH  << std::endl;
+        *out++ = '\n';
     }
-}
 
-void EclOutput::writeFormattedCharArray(const std::vector<PaddedOutputString<8>>& data)
-{
-    const auto sizeData = block_size_data_formatted(CHAR);
+    if (out != begin)
+        ofileH.write(begin, out - begin);
 
-    const int nColumns = std::get<1>(sizeData);
-
-    const auto size = data.size();
+    ofileH.flush();
+}
 
-    for (auto i = 0*size; i < size; ++i) {
-        ofileH << " '" << data[i].c_str() << '\'';
+void EclOutput::writeFormattedCharArray(const std::vector<std::string>& data)
+{
+    writeFormattedCharRecords(data.size(), [&data](std::size_t i, char* dst)
+    {
+        const std::size_t len = std::min(data[i].size(), std::size_t{8});
 
-        if ((i+1) % nColumns == 0) {
-            ofileH << '\n';
-        }
-    }
+        std::memcpy(dst, data[i].data(), len);
+        std::memset(dst + len, ' ', 8 - len);
+    });
+}
 
-    if ((size % nColumns) != 0) {
-        ofileH << '\n';
-    }
+void EclOutput::writeFormattedCharArray(const std::vector<PaddedOutputString<8>>& data)
+{
+    writeFormattedCharRecords(data.size(), [&data](std::size_t i, char* dst)
+    {
+        std::memcpy(dst, data[i].c_str(), 8);
+    });
 }
 
 }} // namespace Opm::EclIO
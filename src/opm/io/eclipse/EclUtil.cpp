@@ -21,8 +21,111 @@
 #include <opm/common/ErrorMacros.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define OPM_ECLIO_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// anonymous namespace for block wise endian conversion kernels. N is the
+// size of each element in bytes (4 or 8), num the number of elements.
+
+namespace {
+
+using BlockFlip = void (*)(const char* src, char* dst, std::size_t num);
+
+template <std::size_t N>
+void flipScalar(const char* src, char* dst, std::size_t num)
+{
+    for (std::size_t i = 0; i < num; i++) {
+        if constexpr (N == 4) {
+            std::uint32_t value;
+            std::memcpy(&value, src + i*N, N);
+            value = __builtin_bswap32(value);
+            std::memcpy(dst + i*N, &value, N);
+        } else {
+            std::uint64_t value;
+            std::memcpy(&value, src + i*N, N);
+            value = __builtin_bswap64(value);
+            std::memcpy(dst + i*N, &value, N);
+        }
+    }
+}
+
+#if defined(OPM_ECLIO_X86_SIMD)
+
+template <std::size_t N>
+__attribute__((target("ssse3")))
+void flipSSSE3(const char* src, char* dst, std::size_t num)
+{
+    const __m128i mask = (N == 4)
+        ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    const std::size_t nBytes = num * N;
+    std::size_t i = 0;
+
+    for (; i + 16 <= nBytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(v, mask));
+    }
+
+    flipScalar<N>(src + i, dst + i, (nBytes - i) / N);
+}
+
+template <std::size_t N>
+__attribute__((target("avx2")))
+void flipAVX2(const char* src, char* dst, std::size_t num)
+{
+    // the shuffle works within each 128 bit lane, the mask is repeated
+    const __m256i mask = (N == 4)
+        ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                           7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+    const std::size_t nBytes = num * N;
+    std::size_t i = 0;
+
+    for (; i + 32 <= nBytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+
+    flipScalar<N>(src + i, dst + i, (nBytes - i) / N);
+}
+
+#endif // OPM_ECLIO_X86_SIMD
+
+template <std::size_t N>
+BlockFlip selectFlip()
+{
+#if defined(OPM_ECLIO_X86_SIMD)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+        return &flipAVX2<N>;
+
+    if (__builtin_cpu_supports("ssse3"))
+        return &flipSSSE3<N>;
+#endif
+
+    return &flipScalar<N>;
+}
+
+template <std::size_t N>
+void flipBlock(const void* src, void* dst, std::size_t num)
+{
+    static const BlockFlip flip = selectFlip<N>();
+
+    flip(static_cast<const char*>(src), static_cast<char*>(dst), num);
+}
+
+} // anonymous namespace
+
 
 int Opm::EclIO::flipEndianInt(int num)
 {
@@ -58,6 +161,52 @@ double Opm::EclIO::flipEndianDouble(double num)
 }
 
 
+void Opm::EclIO::flipEndian(const int* src, int* dst, std::size_t num)
+{
+    flipBlock<sizeof(int)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(const float* src, float* dst, std::size_t num)
+{
+    flipBlock<sizeof(float)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(const double* src, double* dst, std::size_t num)
+{
+    flipBlock<sizeof(double)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(const int* src, char* dst, std::size_t num)
+{
+    flipBlock<sizeof(int)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(const float* src, char* dst, std::size_t num)
+{
+    flipBlock<sizeof(float)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(const double* src, char* dst, std::size_t num)
+{
+    flipBlock<sizeof(double)>(src, dst, num);
+}
+
+void Opm::EclIO::flipEndian(int* data, std::size_t num)
+{
+    flipBlock<sizeof(int)>(data, data, num);
+}
+
+void Opm::EclIO::flipEndian(float* data, std::size_t num)
+{
+    flipBlock<sizeof(float)>(data, data, num);
+}
+
+void Opm::EclIO::flipEndian(double* data, std::size_t num)
+{
+    flipBlock<sizeof(double)>(data, data, num);
+}
+
+
 std::tuple<int, int> Opm::EclIO::block_size_data_binary(eclArrType arrType)
 {
     using BlockSizeTuple = std::tuple<int, int>;
@@ -0,0 +1,160 @@
+/*
+   Copyright 2020 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#ifndef OPM_IO_FORMATTED_NUMBERS_HPP
+#define OPM_IO_FORMATTED_NUMBERS_HPP
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Encoders of the numbers of formatted files.  Each encoder stores the text
+// of one value at out and returns the position following it.  The numeric
+// formats are those of ECLIPSE, e.g. 0.12345678E+03 for REAL and
+// 0.12345678901234D+03 for DOUB values.  DOUB values with three digit
+// exponents are written without exponent character, e.g. 0.12345678901234-100.
+//
+// Needs config.h (HAVE_FLOATING_POINT_CHARCONV) to be included first.
+
+namespace Opm { namespace EclIO { namespace Formatted {
+
+// conversion of floating point values to decimal scientific notation
+enum class Conversion { Charconv, Printf };
+
+#if HAVE_FLOATING_POINT_CHARCONV
+constexpr Conversion defaultConversion = Conversion::Charconv;
+#else
+// std::to_chars for floating point values needs GCC 11
+constexpr Conversion defaultConversion = Conversion::Printf;
+#endif
+
+inline char* copyText(const char* text, char* out)
+{
+    const std::size_t len = std::strlen(text);
+    std::memcpy(out, text, len);
+    return out + len;
+}
+
+// exponent with sign and at least two digits, as printf("%+03i")
+inline char* encodeExponent(int exp, char* out)
+{
+    *out++ = (exp < 0) ? '-' : '+';
+
+    const int absExp = std::abs(exp);
+
+    if (absExp < 10)
+        *out++ = '0';
+
+    return std::to_chars(out, out + 4, absExp).ptr;
+}
+
+inline char* encodeNonFinite(double value, char* out)
+{
+    if (std::isnan(value))
+        return copyText("NAN", out);
+
+    return copyText((value > 0) ? "INF" : "-INF", out);
+}
+
+// value as [-]d.ddd...e[+-]xx with precision digits after the decimal point
+template <Conversion conversion>
+char* scientific(double value, int precision, char* first, char* last)
+{
+    return first + std::snprintf(first, last - first, "%.*e", precision, value);
+}
+
+#if HAVE_FLOATING_POINT_CHARCONV
+template <>
+inline char* scientific<Conversion::Charconv>(double value, int precision, char* first, char* last)
+{
+    return std::to_chars(first, last, value, std::chars_format::scientific, precision).ptr;
+}
+#endif
+
+// mantissa 0.dddd... with numDigits digits and the decimal exponent of the
+// value in scientific notation
+template <int numDigits, Conversion conversion>
+char* encodeMantissa(double value, char* out, int& exp)
+{
+    char sci[40];
+    const char* sciEnd = scientific<conversion>(value, numDigits - 1, sci, sci + sizeof(sci));
+
+    // sci is [-]d.ddd...e[+-]xx
+
+    const char* p = sci;
+
+    if (*p == '-')
+        *out++ = *p++;
+
+    *out++ = '0';
+    *out++ = '.';
+    *out++ = p[0];
+
+    std::memcpy(out, p + 2, numDigits - 1);
+    out += numDigits - 1;
+
+    p += numDigits + 2;   // past digits, decimal point and 'e'
+
+    if (*p == '+')
+        ++p;
+
+    std::from_chars(p, sciEnd, exp);
+
+    return out;
+}
+
+template <Conversion conversion = defaultConversion>
+char* encodeReal(float value, char* out)
+{
+    if (value == 0.0)
+        return copyText("0.00000000E+00", out);
+
+    if (!std::isfinite(value))
+        return encodeNonFinite(value, out);
+
+    int exp = 0;
+    out = encodeMantissa<8, conversion>(value, out, exp);
+
+    *out++ = 'E';
+    return encodeExponent(exp + 1, out);
+}
+
+template <Conversion conversion = defaultConversion>
+char* encodeDoub(double value, char* out)
+{
+    if (value == 0.0)
+        return copyText("0.00000000000000D+00", out);
+
+    if (!std::isfinite(value))
+        return encodeNonFinite(value, out);
+
+    int exp = 0;
+    out = encodeMantissa<14, conversion>(value, out, exp);
+
+    if (std::abs(exp) < 100)
+        *out++ = 'D';
+
+    return encodeExponent(exp + 1, out);
+}
+
+}}} // namespace Opm::EclIO::Formatted
+
+#endif // OPM_IO_FORMATTED_NUMBERS_HPP
@@ -0,0 +1,124 @@
+/*
+   Copyright 2020 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#include "MappedFile.hpp"
+
+#include <opm/common/ErrorMacros.hpp>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Opm { namespace EclIO {
+
+MappedFile::MappedFile(const std::string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        std::string message="Could not open file for memory mapping: '" + filename + "'";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        std::string message="Could not determine size of file: '" + filename + "'";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    length = static_cast<std::size_t>(st.st_size);
+
+    // mmap() of zero bytes is an error, an empty file is represented by
+    // an empty range instead.
+
+    if (length > 0) {
+        void* ptr = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (ptr == MAP_FAILED) {
+            ::close(fd);
+            std::string message="Could not memory map file: '" + filename + "'";
+            OPM_THROW(std::runtime_error, message);
+        }
+
+        addr = static_cast<const char*>(ptr);
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (addr != nullptr) {
+        ::munmap(const_cast<char*>(addr), length);
+    }
+}
+
+
+PositionedFile::PositionedFile(const std::string& filename)
+{
+    fd = ::open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        std::string message="Could not open file: '" + filename + "'";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        std::string message="Could not determine size of file: '" + filename + "'";
+        OPM_THROW(std::runtime_error, message);
+    }
+
+    length = static_cast<std::size_t>(st.st_size);
+}
+
+
+PositionedFile::~PositionedFile()
+{
+    ::close(fd);
+}
+
+
+void PositionedFile::read(char* dst, std::size_t num, std::size_t offset) const
+{
+    while (num > 0) {
+        const ssize_t n = ::pread(fd, dst, num, static_cast<off_t>(offset));
+
+        if (n < 0 && errno == EINTR)
+            continue;
+
+        if (n <= 0) {
+            OPM_THROW(std::runtime_error, "Error reading binary data, unexpected end of file");
+        }
+
+        dst += n;
+        offset += n;
+        num -= n;
+    }
+}
+
+}} // namespace Opm::EclIO
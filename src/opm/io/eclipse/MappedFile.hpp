@@ -0,0 +1,75 @@
+/*
+   Copyright 2020 Equinor ASA.
+
+   This file is part of the Open Porous Media project (OPM).
+
+   OPM is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   OPM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+   */
+
+#ifndef OPM_IO_MAPPEDFILE_HPP
+#define OPM_IO_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Opm { namespace EclIO {
+
+// Read-only memory mapping of an entire file.  The mapping is created in
+// the constructor and released in the destructor.  Pages are faulted in
+// by the operating system when they are first touched, so the cost of
+// reading a single array is proportional to the size of that array rather
+// than the size of the file.
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return addr; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* addr = nullptr;
+    std::size_t length = 0;
+};
+
+// Read-only file descriptor supporting positioned reads (pread).  Reads do
+// not use or modify a shared file offset, so one instance can serve any
+// number of threads concurrently.
+
+class PositionedFile
+{
+public:
+    explicit PositionedFile(const std::string& filename);
+    ~PositionedFile();
+
+    PositionedFile(const PositionedFile&) = delete;
+    PositionedFile& operator=(const PositionedFile&) = delete;
+
+    // read exactly num bytes starting at offset, throws on short reads
+    void read(char* dst, std::size_t num, std::size_t offset) const;
+
+    std::size_t size() const { return length; }
+
+private:
+    int fd = -1;
+    std::size_t length = 0;
+};
+
+}} // namespace Opm::EclIO
+
+#endif // OPM_IO_MAPPEDFILE_HPP
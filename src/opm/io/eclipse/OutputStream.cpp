@@ -145,22 +145,24 @@ namespace {
 
             std::unique_ptr<Opm::EclIO::EclOutput>
             writeNew(const std::string& filename,
-                     const bool         isFmt)
+                     const bool         isFmt,
+                     const bool         isCompressed)
             {
                 return std::unique_ptr<Opm::EclIO::EclOutput> {
                     new Opm::EclIO::EclOutput {
-                        filename, isFmt, std::ios_base::out
+                        filename, isFmt, std::ios_base::out, isCompressed
                     }
                 };
             }
 
             std::unique_ptr<Opm::EclIO::EclOutput>
             writeExisting(const std::string& filename,
-                          const bool         isFmt)
+                          const bool         isFmt,
+                          const bool         isCompressed)
             {
                 return std::unique_ptr<Opm::EclIO::EclOutput> {
                     new Opm::EclIO::EclOutput {
-                        filename, isFmt, std::ios_base::app
+                        filename, isFmt, std::ios_base::app, isCompressed
                     }
                 };
             }
@@ -293,6 +295,15 @@ Restart(const ResultSet& rset,
         const int        seqnum,
         const Formatted& fmt,
         const Unified&   unif)
+    : Restart(rset, seqnum, fmt, unif, Compressed{ false })
+{}
+
+Opm::EclIO::OutputStream::Restart::
+Restart(const ResultSet&  rset,
+        const int         seqnum,
+        const Formatted&  fmt,
+        const Unified&    unif,
+        const Compressed& comp)
 {
     const auto ext = FileExtension::
         restart(seqnum, fmt.set, unif.set);
@@ -301,7 +312,7 @@ Restart(const ResultSet& rset,
 
     if (unif.set) {
         // Run uses unified restart files.
-        this->openUnified(fname, fmt.set, seqnum);
+        this->openUnified(fname, fmt.set, comp.set, seqnum);
 
         // Write SEQNUM value to stream to start new output sequence.
         this->stream_->write("SEQNUM", std::vector<int>{ seqnum });
@@ -309,7 +320,7 @@ Restart(const ResultSet& rset,
     else {
         // Run uses separate, not unified, restart files.  Create a
         // new output file and open an output stream on it.
-        this->openNew(fname, fmt.set);
+        this->openNew(fname, fmt.set, comp.set);
     }
 }
 
@@ -376,10 +387,29 @@ write(const std::string&                        kw,
     this->writeImpl(kw, data);
 }
 
+void
+Opm::EclIO::OutputStream::Restart::
+write(const std::string&      kw,
+      const std::size_t       size,
+      const BlockFill<float>& fill)
+{
+    this->stream().writeBlocks(kw, size, fill);
+}
+
+void
+Opm::EclIO::OutputStream::Restart::
+write(const std::string&       kw,
+      const std::size_t        size,
+      const BlockFill<double>& fill)
+{
+    this->stream().writeBlocks(kw, size, fill);
+}
+
 void
 Opm::EclIO::OutputStream::Restart::
 openUnified(const std::string& fname,
             const bool         formatted,
+            const bool         compressed,
             const int          seqnum)
 {
     // Determine if we're creating a new output/restart file or
@@ -389,7 +419,7 @@ openUnified(const std::string& fname,
 
     if (rst == nullptr) {
         // No such unified restart file exists.  Create new file.
-        this->openNew(fname, formatted);
+        this->openNew(fname, formatted, compressed);
     }
     else if (! rst->hasKey("SEQNUM")) {
         // File with correct filename exists but does not appear
@@ -403,8 +433,8 @@ openUnified(const std::string& fname,
     else {
         // Restart file exists and appears to be a unified restart
         // resource.  Open writable restart stream backed by the
-        // specific file.
-        this->openExisting(fname, formatted,
+        // specific file, continuing with that file's compression.
+        this->openExisting(fname, formatted, rst->compressedInput(),
                            rst->restartStepWritePosition(seqnum));
     }
 }
@@ -412,18 +442,20 @@ openUnified(const std::string& fname,
 void
 Opm::EclIO::OutputStream::Restart::
 openNew(const std::string& fname,
-        const bool         formatted)
+        const bool         formatted,
+        const bool         compressed)
 {
-    this->stream_ = Open::Restart::writeNew(fname, formatted);
+    this->stream_ = Open::Restart::writeNew(fname, formatted, compressed);
 }
 
 void
 Opm::EclIO::OutputStream::Restart::
 openExisting(const std::string&   fname,
              const bool           formatted,
+             const bool           compressed,
              const std::streampos writePos)
 {
-    this->stream_ = Open::Restart::writeExisting(fname, formatted);
+    this->stream_ = Open::Restart::writeExisting(fname, formatted, compressed);
 
     if (writePos == std::streampos(-1)) {
         // No specified initial write position.  Typically the case if
@@ -60,6 +60,10 @@ void data::Solution::convertToSI( const UnitSystem& units ) {
     this->si = true;
 }
 
+bool data::Solution::isSI() const {
+    return this->si;
+}
+
 void data::Solution::convertFromSI( const UnitSystem& units ) {
     if (!this->si) return;
 
@@ -53,14 +53,21 @@ namespace {
         return inteHead[VI::intehead::NCWMAX];
     }
 
+    // Wells are processed as OpenMP tasks, see wellLoop() in
+    // AggregateWellData.cpp.
     template <class ConnOp>
     void connectionLoop(const std::vector<Opm::Well>& wells,
                         const Opm::EclipseGrid&        grid,
                         ConnOp&&                       connOp)
     {
-        for (auto nWell = wells.size(), wellID = 0*nWell;
-             wellID < nWell; ++wellID)
-        {
+        const auto numWells = static_cast<long>(wells.size());
+        std::exception_ptr failure;
+
+#ifdef _OPENMP
+#pragma omp taskloop grainsize(16) shared(wells, grid, connOp, failure)
+#endif
+        for (long wellID = 0; wellID < numWells; ++wellID)
+        try {
             const auto& well = wells[wellID];
             std::vector<const Opm::Connection*> connSI;
             for (const auto& conn : well.getConnections()) {
@@ -87,9 +94,19 @@ namespace {
             for (auto nConn = connSI.size(), connID = 0*nConn;
                  connID < nConn; ++connID)
             {
-                connOp(well, wellID, *(connSI[connID]), connID);
+                connOp(well, static_cast<std::size_t>(wellID), *(connSI[connID]), connID);
             }
         }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (! failure)
+                failure = std::current_exception();
+        }
+
+        if (failure)
+            std::rethrow_exception(failure);
     }
 
     namespace IConn {
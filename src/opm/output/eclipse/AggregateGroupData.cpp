@@ -56,18 +56,35 @@ int nwgmax(const std::vector<int>& inteHead)
 }
 
 
+// Groups are processed as OpenMP tasks, see wellLoop() in
+// AggregateWellData.cpp.
 template <typename GroupOp>
 void groupLoop(const std::vector<const Opm::Group*>& groups,
                GroupOp&&                             groupOp)
 {
-    auto groupID = std::size_t{0};
-    for (const auto* group : groups) {
-        groupID += 1;
+    const auto numGroups = static_cast<long>(groups.size());
+    std::exception_ptr failure;
 
-        if (group == nullptr) { continue; }
+#ifdef _OPENMP
+#pragma omp taskloop grainsize(16) shared(groups, groupOp, failure)
+#endif
+    for (long groupID = 0; groupID < numGroups; ++groupID) {
+        if (groups[groupID] == nullptr) { continue; }
 
-        groupOp(*group, groupID - 1);
+        try {
+            groupOp(*groups[groupID], static_cast<std::size_t>(groupID));
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (! failure)
+                failure = std::current_exception();
+        }
     }
+
+    if (failure)
+        std::rethrow_exception(failure);
 }
 
 
@@ -130,7 +147,7 @@ void staticContrib(const Opm::Schedule&     sched,
                    const int                ngmaxz,
                    const std::size_t        simStep,
                    const Opm::SummaryState& sumState,
-                   const std::map<Opm::Group::InjectionCMode, int> cmodeToNum,
+                   const std::map<Opm::Group::InjectionCMode, int>& cmodeToNum,
                    IGrpArray&               iGrp)
 {
     if (group.wellgroup()) {
@@ -522,7 +539,7 @@ captureDeclaredGroupData(const Opm::Schedule&                 sched,
         curGroups[ind] = std::addressof(group);
     }
 
-    groupLoop(curGroups, [&sched, simStep, sumState, this]
+    groupLoop(curGroups, [&sched, simStep, &sumState, this]
               (const Group& group, const std::size_t groupID) -> void
                          {
                              auto ig = this->iGroup_[groupID];
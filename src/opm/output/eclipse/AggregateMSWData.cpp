@@ -382,18 +382,35 @@ namespace {
         return (inFlowSegInd == -1) ? 0 : inFlowSegInd;
     }
 
+    // Wells are processed as OpenMP tasks, see wellLoop() in
+    // AggregateWellData.cpp.
     template <typename MSWOp>
     void MSWLoop(const std::vector<const Opm::Well*>& wells,
                  MSWOp&&                              mswOp)
     {
-        auto mswID = std::size_t{0};
-        for (const auto* well : wells) {
-            mswID += 1;
+        const auto numWells = static_cast<long>(wells.size());
+        std::exception_ptr failure;
 
-            if (well == nullptr) { continue; }
+#ifdef _OPENMP
+#pragma omp taskloop grainsize(4) shared(wells, mswOp, failure)
+#endif
+        for (long mswID = 0; mswID < numWells; ++mswID) {
+            if (wells[mswID] == nullptr) { continue; }
 
-            mswOp(*well, mswID - 1);
+            try {
+                mswOp(*wells[mswID], static_cast<std::size_t>(mswID));
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (! failure)
+                    failure = std::current_exception();
+            }
         }
+
+        if (failure)
+            std::rethrow_exception(failure);
     }
 
     namespace ISeg {
@@ -80,14 +80,34 @@ namespace {
         return s.substr(b, e - b + 1);
     }
 
+    // The wells write to disjoint windows of the arrays and are processed
+    // as OpenMP tasks, which run concurrently when the loop is encountered
+    // inside a parallel region (see RestartIO::save()).
     template <typename WellOp>
     void wellLoop(const std::vector<Opm::Well>& wells,
                   WellOp&&                      wellOp)
     {
-        auto wellID = 0*wells.size();
-        for (const auto& well : wells) {
-            wellOp(well, wellID++);
+        const auto numWells = static_cast<long>(wells.size());
+        std::exception_ptr failure;
+
+#ifdef _OPENMP
+#pragma omp taskloop grainsize(16) shared(wells, wellOp, failure)
+#endif
+        for (long wellID = 0; wellID < numWells; ++wellID) {
+            try {
+                wellOp(wells[wellID], static_cast<std::size_t>(wellID));
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (! failure)
+                    failure = std::current_exception();
+            }
         }
+
+        if (failure)
+            std::rethrow_exception(failure);
     }
 
     namespace IWell {
@@ -890,15 +910,20 @@ captureDeclaredWellData(const Schedule&   sched,
     {
         //const auto grpNames = groupNames(sched.getGroups());
         const auto groupMapNameIndex = IWell::currentGroupMapNameIndex(sched, sim_step, inteHead);
-        auto msWellID       = std::size_t{0};
+
+        // 1-based index of the most recent multi-segment well.
+        auto msWellID = std::vector<std::size_t>(wells.size(), 0);
+        for (auto nWell = wells.size(), wellID = 0*nWell; wellID < nWell; ++wellID) {
+            msWellID[wellID] = ((wellID > 0) ? msWellID[wellID - 1] : 0)
+                + wells[wellID].isMultiSegment();
+        }
 
         wellLoop(wells, [&groupMapNameIndex, &msWellID, &smry, this]
             (const Well& well, const std::size_t wellID) -> void
         {
-            msWellID += well.isMultiSegment();  // 1-based index.
             auto iw   = this->iWell_[wellID];
 
-            IWell::staticContrib(well, smry, msWellID, groupMapNameIndex, iw);
+            IWell::staticContrib(well, smry, msWellID[wellID], groupMapNameIndex, iw);
         });
     }
 
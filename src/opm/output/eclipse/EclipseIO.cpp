@@ -44,18 +44,31 @@
 
 #include <opm/io/eclipse/OutputStream.hpp>
 
+#include <opm/parser/eclipse/EclipseState/Schedule/SummaryState.hpp>
+
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <cctype>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>     // unique_ptr
+#include <mutex>
 #include <stdexcept>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 #include <utility>    // move
 
 #include <opm/common/utility/FileSystem.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace {
 
 inline std::string uppercase( std::string x ) {
@@ -90,6 +103,144 @@ void ensure_directory_exists( const Opm::filesystem::path& odir )
     }
 }
 
+/*
+  Bounded FIFO of output jobs executed by a single writer thread.  After a
+  job has failed the remaining jobs are discarded and the exception is
+  rethrown to the producer on the next push() or wait().
+*/
+
+class OutputQueue
+{
+public:
+    explicit OutputQueue(std::size_t maxQueued)
+        : capacity(std::max(maxQueued, std::size_t{1}))
+        , writer([this]() { this->run(); })
+    {}
+
+    ~OutputQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stop = true;
+        }
+
+        this->changed.notify_all();
+        this->writer.join();
+    }
+
+    OutputQueue(const OutputQueue&) = delete;
+    OutputQueue& operator=(const OutputQueue&) = delete;
+
+    void push(std::function<void()> job)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->rethrow();
+
+        if (this->jobs.size() >= this->capacity) {
+            const auto start = std::chrono::steady_clock::now();
+
+            this->changed.wait(lock, [this]() { return (this->jobs.size() < this->capacity) || this->error; });
+
+            const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+
+            this->stats.stalls += 1;
+            this->stats.stallSeconds += waited.count();
+
+            this->rethrow();
+        }
+
+        this->jobs.push_back(std::move(job));
+
+        this->stats.submitted += 1;
+        this->stats.maxQueued = std::max(this->stats.maxQueued, this->jobs.size());
+
+        this->changed.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->changed.wait(lock, [this]() { return this->jobs.empty() && !this->busy; });
+        this->rethrow();
+    }
+
+    Opm::EclipseIO::AsyncOutputStatistics statistics() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->stats;
+    }
+
+private:
+    std::size_t capacity;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::function<void()>> jobs;
+    bool busy = false;
+    bool stop = false;
+    std::exception_ptr error;
+    Opm::EclipseIO::AsyncOutputStatistics stats;
+
+    std::thread writer;
+
+    // caller must hold mutex
+    void rethrow()
+    {
+        if (this->error) {
+            auto e = this->error;
+            this->error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void run()
+    {
+#ifdef _OPENMP
+        // the writer runs next to the simulator, which keeps its own
+        // threads busy, parallel regions of the output code (such as the
+        // capture of the restart aggregates) run with a single thread here
+        omp_set_num_threads(1);
+#endif
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (true) {
+            this->changed.wait(lock, [this]() { return this->stop || !this->jobs.empty(); });
+
+            if (this->jobs.empty())
+                return;
+
+            auto job = std::move(this->jobs.front());
+            this->jobs.pop_front();
+            this->busy = true;
+
+            lock.unlock();
+            this->changed.notify_all();
+
+            std::exception_ptr failure;
+
+            try {
+                job();
+            }
+            catch (...) {
+                failure = std::current_exception();
+            }
+
+            lock.lock();
+            this->busy = false;
+
+            if (failure) {
+                this->error = failure;
+                this->jobs.clear();
+            } else {
+                this->stats.completed += 1;
+            }
+
+            this->changed.notify_all();
+        }
+    }
+};
+
 }
 
 namespace Opm {
@@ -99,6 +250,8 @@ class EclipseIO::Impl {
         void writeINITFile( const data::Solution& simProps, std::map<std::string, std::vector<int> > int_data, const NNC& nnc) const;
         void writeEGRIDFile( const NNC& nnc );
         bool wantRFTOutput( const int report_step, const bool isSubstep ) const;
+        void writeTimeStep( const SummaryState& st, int report_step, bool isSubstep,
+                            double secs_elapsed, const RestartValue& value, bool write_double );
 
         const EclipseState& es;
         EclipseGrid grid;
@@ -107,6 +260,8 @@ class EclipseIO::Impl {
         std::string baseName;
         out::Summary summary;
         bool output_enabled;
+        bool compressRestart = false;
+        std::unique_ptr<OutputQueue> outputQueue;
 };
 
 EclipseIO::Impl::Impl( const EclipseState& eclipseState,
@@ -182,20 +337,13 @@ void EclipseIO::writeInitial( data::Solution simProps, std::map<std::string, std
 }
 
 // implementation of the writeTimeStep method
-void EclipseIO::writeTimeStep(const SummaryState& st,
-                              int report_step,
-                              bool  isSubstep,
-                              double secs_elapsed,
-                              RestartValue value,
-                              const bool write_double)
+void EclipseIO::Impl::writeTimeStep(const SummaryState& st,
+                                    int report_step,
+                                    bool  isSubstep,
+                                    double secs_elapsed,
+                                    const RestartValue& value,
+                                    const bool write_double)
  {
-    if (! this->impl->output_enabled) {
-        return;
-    }
-
-    const auto& es = this->impl->es;
-    const auto& grid = this->impl->grid;
-    const auto& schedule = this->impl->schedule;
     const auto& ioConfig = es.cfg().io();
 
     /*
@@ -203,9 +351,9 @@ void EclipseIO::writeTimeStep(const SummaryState& st,
       very intial report_step==0 call, which is only garbage.
     */
     if (report_step > 0) {
-        this->impl->summary.add_timestep( st,
-                                          report_step);
-        this->impl->summary.write();
+        this->summary.add_timestep( st,
+                                    report_step);
+        this->summary.write(!isSubstep);
     }
 
     /*
@@ -216,11 +364,12 @@ void EclipseIO::writeTimeStep(const SummaryState& st,
     if(!isSubstep && schedule.restart().getWriteRestartFile(report_step))
     {
         EclIO::OutputStream::Restart rstFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
+            EclIO::OutputStream::ResultSet { this->outputDir,
+                                             this->baseName },
             report_step,
             EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
-            EclIO::OutputStream::Unified   { ioConfig.getUNIFOUT() }
+            EclIO::OutputStream::Unified   { ioConfig.getUNIFOUT() },
+            EclIO::OutputStream::Compressed{ this->compressRestart }
         };
 
         RestartIO::save(rstFile, report_step, secs_elapsed, value,
@@ -228,7 +377,7 @@ void EclipseIO::writeTimeStep(const SummaryState& st,
     }
 
     // RFT file written only if requested and never for substeps.
-    if (this->impl->wantRFTOutput(report_step, isSubstep)) {
+    if (this->wantRFTOutput(report_step, isSubstep)) {
         // Open existing RFT file if report step is after first RFT event.
         const auto openExisting = EclIO::OutputStream::RFT::OpenExisting {
             static_cast<std::size_t>(report_step)
@@ -236,8 +385,8 @@ void EclipseIO::writeTimeStep(const SummaryState& st,
         };
 
         EclIO::OutputStream::RFT rftFile {
-            EclIO::OutputStream::ResultSet { this->impl->outputDir,
-                                             this->impl->baseName },
+            EclIO::OutputStream::ResultSet { this->outputDir,
+                                             this->baseName },
             EclIO::OutputStream::Formatted { ioConfig.getFMTOUT() },
             openExisting
         };
@@ -248,6 +397,80 @@ void EclipseIO::writeTimeStep(const SummaryState& st,
  }
 
 
+void EclipseIO::writeTimeStep(const SummaryState& st,
+                              int report_step,
+                              bool  isSubstep,
+                              double secs_elapsed,
+                              RestartValue value,
+                              const bool write_double)
+{
+    if (! this->impl->output_enabled) {
+        return;
+    }
+
+    if (! this->impl->outputQueue) {
+        this->impl->writeTimeStep(st, report_step, isSubstep, secs_elapsed, value, write_double);
+        return;
+    }
+
+    auto* impl_ptr = this->impl.get();
+
+    this->impl->outputQueue->push(
+        [impl_ptr, st_copy = st, report_step, isSubstep, secs_elapsed,
+         value = std::move(value), write_double]()
+        {
+            impl_ptr->writeTimeStep(st_copy, report_step, isSubstep,
+                                    secs_elapsed, value, write_double);
+        });
+}
+
+
+void EclipseIO::enableAsyncOutput(std::size_t maxQueued) {
+    if (this->impl->outputQueue)
+        this->impl->outputQueue->wait();
+
+    this->impl->outputQueue.reset();
+
+    if (maxQueued > 0)
+        this->impl->outputQueue = std::make_unique<OutputQueue>(maxQueued);
+}
+
+
+bool EclipseIO::asyncOutput() const {
+    return static_cast<bool>(this->impl->outputQueue);
+}
+
+
+void EclipseIO::flush() {
+    // pending ministeps may still be in queued requests, the summary is
+    // flushed when the writer thread is idle
+    if (this->impl->outputQueue)
+        this->impl->outputQueue->wait();
+
+    this->impl->summary.flush();
+}
+
+
+void EclipseIO::setSummaryFlushPolicy(const out::Summary::FlushPolicy& policy) {
+    this->flush();
+    this->impl->summary.setFlushPolicy(policy);
+}
+
+
+void EclipseIO::enableCompressedRestart(bool enable) {
+    this->flush();
+    this->impl->compressRestart = enable;
+}
+
+
+EclipseIO::AsyncOutputStatistics EclipseIO::asyncOutputStatistics() const {
+    if (this->impl->outputQueue)
+        return this->impl->outputQueue->statistics();
+
+    return {};
+}
+
+
 RestartValue EclipseIO::loadRestart(SummaryState& summary_state, const std::vector<RestartKey>& solution_keys, const std::vector<RestartKey>& extra_keys) const {
     const auto& es                       = this->impl->es;
     const auto& grid                     = this->impl->grid;
@@ -276,10 +499,20 @@ EclipseIO::EclipseIO( const EclipseState& es,
 }
 
 const out::Summary& EclipseIO::summary() {
+    this->flush();
     return this->impl->summary;
 }
 
 
-EclipseIO::~EclipseIO() {}
+EclipseIO::~EclipseIO() {
+    // pending output is written, errors can not be reported from here
+    if (this->impl->outputQueue) {
+        try {
+            this->impl->outputQueue->wait();
+        }
+        catch (...) {
+        }
+    }
+}
 
 } // namespace Opm
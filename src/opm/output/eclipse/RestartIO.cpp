@@ -52,15 +52,22 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <initializer_list>
 #include <iomanip>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <unordered_set>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Opm { namespace RestartIO {
 
 namespace {
@@ -84,11 +91,16 @@ namespace {
         return extra_solution.count(vector) > 0;
     }
 
-    double nextStepSize(const Opm::RestartValue& rst_value)
+    double nextStepSize(const Opm::RestartValue& rst_value,
+                        const Opm::UnitSystem&   units)
     {
-        return rst_value.hasExtra("OPMEXTRA")
-            ? rst_value.getExtra("OPMEXTRA")[0]
-            : 0.0;
+        for (const auto& extra_value : rst_value.extra) {
+            if (extra_value.first.key == "OPMEXTRA") {
+                return units.from_si(extra_value.first.dim, extra_value.second[0]);
+            }
+        }
+
+        return 0.0;
     }
 
     std::vector<int>
@@ -233,19 +245,142 @@ namespace {
         return ih;
     }
 
-    void writeGroup(int                           sim_step,
-                    const UnitSystem&             units,
-                    const Schedule&               schedule,
-                    const Opm::SummaryState&      sumState,
-                    const std::vector<int>&       ih,
-                    EclIO::OutputStream::Restart& rstFile)
+    // Group, well, connection, segment, UDQ and ACTIONX arrays.  These are
+    // independent of one another and are captured concurrently, as OpenMP
+    // tasks, before they are written in the usual order.
+    struct Aggregates
     {
-        // write IGRP to restart file
-        const size_t simStep = static_cast<size_t> (sim_step);
+        std::unique_ptr<Helpers::AggregateGroupData>      groupData;
+        std::unique_ptr<Helpers::AggregateMSWData>        mswData;
+        std::unique_ptr<Helpers::AggregateWellData>       wellData;
+        std::unique_ptr<Helpers::AggregateConnectionData> connectionData;
+        std::vector<int>                                  opmIWel;
+        std::vector<double>                               opmXWel;
+        std::vector<int>                                  udqDims;
+        std::unique_ptr<Helpers::AggregateUDQData>        udqData;
+        std::vector<int>                                  actDims;
+        std::unique_ptr<Helpers::AggregateActionxData>    actionxData;
+    };
+
+    Aggregates captureAggregates(int                           sim_step,
+                                 const bool                    ecl_compatible_rst,
+                                 const EclipseState&           es,
+                                 const EclipseGrid&            grid,
+                                 const Schedule&               schedule,
+                                 const data::Wells&            wells,
+                                 const Opm::SummaryState&      sumState,
+                                 const std::vector<int>&       ih)
+    {
+        const auto  simStep = static_cast<std::size_t>(sim_step);
+        const auto& units   = es.getUnits();
+
+        // Well and MSW data only when applicable (i.e., when present)
+        const auto sched_wells = schedule.getWells(sim_step);
+        const auto haveMSW =
+            std::any_of(std::begin(sched_wells), std::end(sched_wells),
+                [](const Well& well)
+        {
+            return well.isMultiSegment();
+        });
+
+        auto agg   = Aggregates{};
+        auto tasks = std::vector<std::function<void()>>{};
+
+        tasks.emplace_back([&]()
+        {
+            agg.groupData = std::make_unique<Helpers::AggregateGroupData>(ih);
+            agg.groupData->captureDeclaredGroupData(schedule, units, simStep, sumState, ih);
+        });
+
+        if (haveMSW) {
+            tasks.emplace_back([&]()
+            {
+                agg.mswData = std::make_unique<Helpers::AggregateMSWData>(ih);
+                agg.mswData->captureDeclaredMSWData(schedule, simStep, units,
+                                                    ih, grid, sumState, wells);
+            });
+        }
 
-        auto  groupData = Helpers::AggregateGroupData(ih);
+        if (! sched_wells.empty()) {
+            tasks.emplace_back([&]()
+            {
+                agg.wellData = std::make_unique<Helpers::AggregateWellData>(ih);
+                agg.wellData->captureDeclaredWellData(schedule, units, sim_step, sumState, ih);
+                agg.wellData->captureDynamicWellData(schedule, sim_step, wells, sumState);
+            });
 
-        groupData.captureDeclaredGroupData(schedule, units, simStep, sumState, ih);
+            // Extended set of OPM well vectors
+            if (! ecl_compatible_rst) {
+                tasks.emplace_back([&]()
+                {
+                    agg.opmXWel = serialize_OPM_XWEL(wells, sched_wells,
+                                                     es.runspec().phases(), grid);
+                    agg.opmIWel = serialize_OPM_IWEL(wells, schedule.wellNames(sim_step));
+                });
+            }
+
+            tasks.emplace_back([&]()
+            {
+                agg.connectionData = std::make_unique<Helpers::AggregateConnectionData>(ih);
+                agg.connectionData->captureDeclaredConnData(schedule, grid, units,
+                                                            wells, sim_step);
+            });
+        }
+
+        tasks.emplace_back([&]()
+        {
+            agg.udqDims = Helpers::createUdqDims(schedule, simStep, ih);
+            agg.udqData = std::make_unique<Helpers::AggregateUDQData>(agg.udqDims);
+            agg.udqData->captureDeclaredUDQData(schedule, simStep, sumState, ih);
+        });
+
+        tasks.emplace_back([&]()
+        {
+            agg.actDims = Helpers::createActionxDims(es.runspec(), schedule, simStep);
+            agg.actionxData = std::make_unique<Helpers::AggregateActionxData>(agg.actDims);
+            agg.actionxData->captureDeclaredActionxData(schedule, sumState, agg.actDims, simStep);
+        });
+
+        // Failures are reported in task order, as if run sequentially.
+        auto failures = std::vector<std::exception_ptr>(tasks.size());
+        const auto numTasks = static_cast<long>(tasks.size());
+
+        // The team is no larger than the number of tasks, the taskloops of
+        // the aggregators spread wells and groups over the same threads.
+        // On the writer thread of asynchronous output the team is a single
+        // thread (see EclipseIO).
+
+#ifdef _OPENMP
+        const int numThreads = std::max(1, std::min(static_cast<int>(numTasks), omp_get_max_threads()));
+
+#pragma omp parallel num_threads(numThreads)
+#pragma omp single
+#endif
+        for (long task = 0; task < numTasks; ++task) {
+#ifdef _OPENMP
+#pragma omp task shared(tasks, failures)
+#endif
+            try {
+                tasks[task]();
+            }
+            catch (...) {
+                failures[task] = std::current_exception();
+            }
+        }
+
+        for (const auto& failure : failures) {
+            if (failure)
+                std::rethrow_exception(failure);
+        }
+
+        return agg;
+    }
+
+    void writeGroup(const Aggregates&             agg,
+                    EclIO::OutputStream::Restart& rstFile)
+    {
+        // write IGRP to restart file
+        const auto& groupData = *agg.groupData;
 
         rstFile.write("IGRP", groupData.getIGroup());
         rstFile.write("SGRP", groupData.getSGroup());
@@ -253,21 +388,11 @@ namespace {
         rstFile.write("ZGRP", groupData.getZGroup());
     }
 
-    void writeMSWData(int                           sim_step,
-                      const UnitSystem&             units,
-                      const Schedule&               schedule,
-                      const EclipseGrid&            grid,
-                      const Opm::SummaryState&      sumState,
-                      const Opm::data::Wells&       wells,
-                      const std::vector<int>&       ih,
+    void writeMSWData(const Aggregates&             agg,
                       EclIO::OutputStream::Restart& rstFile)
     {
         // write ISEG, RSEG, ILBS and ILBR to restart file
-        const auto simStep = static_cast<std::size_t> (sim_step);
-
-        auto  MSWData = Helpers::AggregateMSWData(ih);
-        MSWData.captureDeclaredMSWData(schedule, simStep, units,
-                                       ih, grid, sumState, wells);
+        const auto& MSWData = *agg.mswData;
 
         rstFile.write("ISEG", MSWData.getISeg());
         rstFile.write("ILBS", MSWData.getILBs());
@@ -275,19 +400,13 @@ namespace {
         rstFile.write("RSEG", MSWData.getRSeg());
     }
 
-    void writeUDQ(int                           sim_step,
-                  const Schedule&               schedule,
-                  const SummaryState&           sum_state,
-                  const std::vector<int>&       ih,
+    void writeUDQ(const Aggregates&             agg,
                   EclIO::OutputStream::Restart& rstFile)
     {
         // write UDQ - data to restart file
-        const std::size_t simStep = static_cast<size_t> (sim_step);
+        const auto& udqDims = agg.udqDims;
+        const auto& udqData = *agg.udqData;
 
-        const auto udqDims = Helpers::createUdqDims(schedule, simStep, ih);
-        auto  udqData = Helpers::AggregateUDQData(udqDims);
-        udqData.captureDeclaredUDQData(schedule, simStep, sum_state, ih);
-        
         if (udqDims[0] >= 1) {
             rstFile.write("ZUDN", udqData.getZUDN());
             rstFile.write("ZUDL", udqData.getZUDL());
@@ -301,19 +420,13 @@ namespace {
         }
     }
 
-    void writeActionx(int                       sim_step,
-                  const EclipseState&           es,
-                  const Schedule&               schedule,
-                  const SummaryState&           sum_state,
-                  EclIO::OutputStream::Restart& rstFile)
+    void writeActionx(const Aggregates&             agg,
+                      EclIO::OutputStream::Restart& rstFile)
     {
         // write ACTIONX - data to restart file
-        const std::size_t simStep = static_cast<size_t> (sim_step);
-        
-        const auto actDims = Opm::RestartIO::Helpers::createActionxDims(es.runspec(), schedule, simStep);
-        auto  actionxData = Opm::RestartIO::Helpers::AggregateActionxData(actDims);
-        actionxData.captureDeclaredActionxData(schedule, sum_state, actDims, simStep);
-        
+        const auto& actDims     = agg.actDims;
+        const auto& actionxData = *agg.actionxData;
+
         if (actDims[0] >= 1) {
             rstFile.write("IACT", actionxData.getIACT());
             rstFile.write("SACT", actionxData.getSACT());
@@ -325,21 +438,11 @@ namespace {
         }
     }
 
-    void writeWell(int                           sim_step,
-                   const bool                    ecl_compatible_rst,
-                   const Phases&                 phases,
-                   const UnitSystem&             units,
-                   const EclipseGrid&            grid,
-                   const Schedule&               schedule,
-                   const data::Wells&            wells,
-                   const Opm::SummaryState&      sumState,
-                   const std::vector<int>&       ih,
+    void writeWell(const bool                    ecl_compatible_rst,
+                   const Aggregates&             agg,
                    EclIO::OutputStream::Restart& rstFile)
     {
-        auto wellData = Helpers::AggregateWellData(ih);
-        wellData.captureDeclaredWellData(schedule, units, sim_step, sumState, ih);
-        wellData.captureDynamicWellData(schedule, sim_step,
-                                        wells, sumState);
+        const auto& wellData = *agg.wellData;
 
         rstFile.write("IWEL", wellData.getIWell());
         rstFile.write("SWEL", wellData.getSWell());
@@ -349,21 +452,11 @@ namespace {
         // Extended set of OPM well vectors
         if (!ecl_compatible_rst)
         {
-            const auto sched_wells = schedule.getWells(sim_step);
-            const auto sched_well_names = schedule.wellNames(sim_step);
-
-            const auto opm_xwel =
-                serialize_OPM_XWEL(wells, sched_wells, phases, grid);
-
-            const auto opm_iwel = serialize_OPM_IWEL(wells, sched_well_names);
-
-            rstFile.write("OPM_IWEL", opm_iwel);
-            rstFile.write("OPM_XWEL", opm_xwel);
+            rstFile.write("OPM_IWEL", agg.opmIWel);
+            rstFile.write("OPM_XWEL", agg.opmXWel);
         }
 
-        auto connectionData = Helpers::AggregateConnectionData(ih);
-        connectionData.captureDeclaredConnData(schedule, grid, units,
-                                               wells, sim_step);
+        const auto& connectionData = *agg.connectionData;
 
         rstFile.write("ICON", connectionData.getIConn());
         rstFile.write("SCON", connectionData.getSConn());
@@ -383,21 +476,29 @@ namespace {
 
     std::vector<double>
     convertedHysteresisSat(const RestartValue& value,
+                           const UnitSystem&   units,
                            const std::string&  primary,
                            const std::string&  fallback)
     {
         auto smax = std::vector<double>{};
 
-        if (value.solution.has(primary)) {
-            smax = value.solution.data(primary);
-        }
-        else if (value.solution.has(fallback)) {
-            smax = value.solution.data(fallback);
-        }
+        const auto pos = value.solution.has(primary)
+            ? value.solution.find(primary)
+            : value.solution.find(fallback);
+
+        if (pos != value.solution.end()) {
+            const auto dim = pos->second.dim;
+            const auto convert = value.solution.isSI()
+                && (dim != UnitSystem::measure::identity);
+
+            const auto& s = pos->second.data;
+            smax.resize(s.size());
 
-        if (! smax.empty()) {
-            std::transform(std::begin(smax), std::end(smax), std::begin(smax),
-                           [](const double s) { return 1.0 - s; });
+            std::transform(std::begin(s), std::end(s), std::begin(smax),
+                           [&units, dim, convert](const double x)
+            {
+                return 1.0 - (convert ? units.from_si(dim, x) : x);
+            });
         }
 
         return smax;
@@ -405,6 +506,7 @@ namespace {
 
     template <class OutputVector>
     void writeEclipseCompatHysteresis(const RestartValue& value,
+                                      const UnitSystem&   units,
                                       const bool          write_double,
                                       OutputVector&&      writeVector)
     {
@@ -413,10 +515,10 @@ namespace {
         // Sufficient for Norne.
         {
             const auto somax =
-                convertedHysteresisSat(value, "KRNSW_OW", "PCSWM_OW");
+                convertedHysteresisSat(value, units, "KRNSW_OW", "PCSWM_OW");
 
             if (! somax.empty()) {
-                writeVector("SOMAX", somax, write_double);
+                writeVector("SOMAX", somax, UnitSystem::measure::identity, write_double);
             }
         }
 
@@ -425,60 +527,92 @@ namespace {
         // Sufficient for Norne.
         {
             const auto sgmax =
-                convertedHysteresisSat(value, "KRNSW_GO", "PCSWM_GO");
+                convertedHysteresisSat(value, units, "KRNSW_GO", "PCSWM_GO");
 
             if (! sgmax.empty()) {
-                writeVector("SGMAX", sgmax, write_double);
+                writeVector("SGMAX", sgmax, UnitSystem::measure::identity, write_double);
             }
         }
     }
 
+    // Values are converted from SI to output units, unless dim is
+    // identity, and narrowed to float for REAL output block by block while
+    // the array is written.  No converted copy of the data is made.
+    template <typename T>
+    void writeConverted(const std::string&            key,
+                        const std::vector<double>&    data,
+                        const UnitSystem&             units,
+                        const UnitSystem::measure     dim,
+                        EclIO::OutputStream::Restart& rstFile)
+    {
+        const auto convert = dim != UnitSystem::measure::identity;
+
+        rstFile.write(key, data.size(), EclIO::OutputStream::Restart::BlockFill<T> {
+            [&data, &units, dim, convert](const std::size_t first, const std::size_t num, T* dst)
+        {
+            const double* src = data.data() + first;
+
+            if (convert) {
+                for (std::size_t i = 0; i < num; ++i)
+                    dst[i] = static_cast<T>(units.from_si(dim, src[i]));
+            }
+            else {
+                for (std::size_t i = 0; i < num; ++i)
+                    dst[i] = static_cast<T>(src[i]);
+            }
+        }});
+    }
+
     void writeSolution(const RestartValue&           value,
-                       const Schedule&               schedule,
-                       const SummaryState&           sum_state,
-                       int                           report_step,
+                       const UnitSystem&             units,
+                       const Aggregates&             agg,
                        const bool                    ecl_compatible_rst,
                        const bool                    write_double_arg,
-                       const std::vector<int>&       inteHD,
                        EclIO::OutputStream::Restart& rstFile)
     {
         rstFile.message("STARTSOL");
 
-        auto write = [&rstFile]
+        auto write = [&rstFile, &units]
             (const std::string&         key,
              const std::vector<double>& data,
+             const UnitSystem::measure  dim,
              const bool                 write_double) -> void
         {
             if (write_double) {
-                rstFile.write(key, data);
+                writeConverted<double>(key, data, units, dim, rstFile);
             }
             else {
-                rstFile.write(key, std::vector<float> {
-                    data.begin(), data.end()
-                });
+                writeConverted<float>(key, data, units, dim, rstFile);
             }
         };
 
+        // Solution fields already in output units are written unchanged.
+        auto solutionDim = [&value](const data::CellData& cell)
+        {
+            return value.solution.isSI()
+                ? cell.dim : UnitSystem::measure::identity;
+        };
+
         for (const auto& elm : value.solution) {
             if (elm.second.target == data::TargetType::RESTART_SOLUTION)
             {
-                write(elm.first, elm.second.data, write_double_arg);
+                write(elm.first, elm.second.data, solutionDim(elm.second), write_double_arg);
             }
         }
 
-        writeUDQ(report_step, schedule, sum_state, inteHD, rstFile);
+        writeUDQ(agg, rstFile);
         
         for (const auto& elm : value.extra) {
             const std::string& key = elm.first.key;
             if (extraInSolution(key)) {
                 // Observe that the extra data is unconditionally
                 // output as double precision.
-                write(key, elm.second, true);
+                write(key, elm.second, elm.first.dim, true);
             }
         }
 
         if (ecl_compatible_rst && haveHysteresis(value)) {
-            writeEclipseCompatHysteresis(value, write_double_arg, write);
+            writeEclipseCompatHysteresis(value, units, write_double_arg, write);
         }
 
         rstFile.message("ENDSOL");
@@ -489,19 +623,21 @@ namespace {
 
         for (const auto& elm : value.solution) {
             if (elm.second.target == data::TargetType::RESTART_AUXILIARY) {
-                write(elm.first, elm.second.data, write_double_arg);
+                write(elm.first, elm.second.data, solutionDim(elm.second), write_double_arg);
             }
         }
     }
 
     void writeExtraData(const RestartValue::ExtraVector& extra_data,
+                        const UnitSystem&                units,
                         EclIO::OutputStream::Restart&    rstFile)
     {
         for (const auto& extra_value : extra_data) {
             const std::string& key = extra_value.first.key;
 
             if (! extraInSolution(key)) {
-                rstFile.write(key, extra_value.second);
+                writeConverted<double>(key, extra_value.second, units,
+                                       extra_value.first.dim, rstFile);
             }
         }
     }
@@ -535,7 +671,7 @@ namespace {
 void save(EclIO::OutputStream::Restart& rstFile,
           int                           report_step,
           double                        seconds_elapsed,
-          RestartValue                  value,
+          const RestartValue&           value,
           const EclipseState&           es,
           const EclipseGrid&            grid,
           const Schedule&               schedule,
@@ -554,44 +690,32 @@ void save(EclIO::OutputStream::Restart& rstFile,
         write_double = false;
     }
 
-    // Convert solution fields and extra values from SI to user units.
-    value.convertFromSI(units);
-
+    // Solution fields and extra values are converted from SI to user
+    // units as they are written.
     const auto inteHD =
-        writeHeader(sim_step, nextStepSize(value), seconds_elapsed,
+        writeHeader(sim_step, nextStepSize(value, units), seconds_elapsed,
                     schedule, grid, es, rstFile);
 
-    writeGroup(sim_step, units, schedule, sumState, inteHD, rstFile);
+    const auto agg =
+        captureAggregates(sim_step, ecl_compatible_rst, es, grid, schedule,
+                          value.wells, sumState, inteHD);
 
-    // Write well and MSW data only when applicable (i.e., when present)
-    {
-        const auto& wells = schedule.getWells(sim_step);
+    writeGroup(agg, rstFile);
 
-        if (! wells.empty()) {
-            const auto haveMSW =
-                std::any_of(std::begin(wells), std::end(wells),
-                    [](const Well& well)
-            {
-                return well.isMultiSegment();
-            });
-
-            if (haveMSW) {
-                writeMSWData(sim_step, units, schedule, grid, sumState,
-                             value.wells, inteHD, rstFile);
-            }
+    if (agg.mswData) {
+        writeMSWData(agg, rstFile);
+    }
 
-            writeWell(sim_step, ecl_compatible_rst,
-                      es.runspec().phases(), units, grid, schedule,
-                      value.wells, sumState, inteHD, rstFile);
-        }
+    if (agg.wellData) {
+        writeWell(ecl_compatible_rst, agg, rstFile);
     }
-    
-    writeActionx(sim_step, es, schedule, sumState, rstFile);
-    
-    writeSolution(value, schedule, sumState, sim_step, ecl_compatible_rst, write_double, inteHD, rstFile);
+
+    writeActionx(agg, rstFile);
+
+    writeSolution(value, units, agg, ecl_compatible_rst, write_double, rstFile);
 
     if (! ecl_compatible_rst) {
-        writeExtraData(value.extra, rstFile);
+        writeExtraData(value.extra, units, rstFile);
     }
 
     logRestartOutput(report_step, schedule.getTimeMap().numTimesteps(), inteHD);
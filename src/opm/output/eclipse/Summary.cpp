@@ -55,10 +55,12 @@
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -326,7 +328,7 @@ struct fn_args {
     const Opm::data::Wells& wells;
     const Opm::out::RegionCache& regionCache;
     const Opm::EclipseGrid& grid;
-    const std::vector< std::pair< std::string, double > > eff_factors;
+    const std::vector< std::pair< std::string, double > >& eff_factors;
 };
 
 /* Since there are several enums in opm scattered about more-or-less
@@ -374,13 +376,15 @@ measure rate_unit< rt::well_potential_oil >() { return measure::liquid_surface_r
 template<> constexpr
 measure rate_unit< rt::well_potential_gas >() { return measure::gas_surface_rate; }
 
+// eff_factors is sorted on well name, see EfficiencyFactor::setFactors().
 double efac( const std::vector<std::pair<std::string,double>>& eff_factors, const std::string& name ) {
-    auto it = std::find_if( eff_factors.begin(), eff_factors.end(),
-                            [&] ( const std::pair< std::string, double > elem )
-                            { return elem.first == name; }
-                          );
+    auto it = std::lower_bound( eff_factors.begin(), eff_factors.end(), name,
+                                [] ( const std::pair< std::string, double >& elem,
+                                     const std::string& key )
+                                { return elem.first < key; }
+                              );
 
-    return (it != eff_factors.end()) ? it->second : 1;
+    return ((it != eff_factors.end()) && (it->first == name)) ? it->second : 1;
 }
 
 template< rt phase, bool injection = true, bool polymer = false >
@@ -1257,16 +1261,16 @@ void eval_udq(const Opm::Schedule& schedule, std::size_t sim_step, Opm::SummaryS
     }
 }
 
-void updateValue(const Opm::SummaryConfigNode& node, const double value, Opm::SummaryState& st)
+Opm::SummaryState::Handle nodeHandle(const Opm::SummaryConfigNode& node, Opm::SummaryState& st)
 {
     if (node.category() == Opm::SummaryConfigNode::Category::Well)
-        st.update_well_var(node.namedEntity(), node.keyword(), value);
+        return st.well_handle(node.namedEntity(), node.keyword());
 
     else if (node.category() == Opm::SummaryConfigNode::Category::Group)
-        st.update_group_var(node.namedEntity(), node.keyword(), value);
+        return st.group_handle(node.namedEntity(), node.keyword());
 
     else
-        st.update(node.uniqueNodeKey(), value);
+        return st.handle(node.uniqueNodeKey());
 }
 
 /*
@@ -1292,13 +1296,18 @@ struct EfficiencyFactor
 
     FacColl factors{};
 
-    void setFactors(const Opm::SummaryConfigNode&        node,
+    void setFactors(const Opm::SummaryConfigNode::Category cat,
+                    const std::string&             entity,
+                    const bool                     is_rate,
                     const Opm::Schedule&           schedule,
                     const std::vector<Opm::Well>& schedule_wells,
                     const int                      sim_step);
 };
 
-void EfficiencyFactor::setFactors(const Opm::SummaryConfigNode&        node,
+// The factors are sorted on well name for lookup in efac().
+void EfficiencyFactor::setFactors(const Opm::SummaryConfigNode::Category cat,
+                                  const std::string&             entity,
+                                  const bool                     is_rate,
                                   const Opm::Schedule&           schedule,
                                   const std::vector<Opm::Well>& schedule_wells,
                                   const int                      sim_step)
@@ -1307,15 +1316,13 @@ void EfficiencyFactor::setFactors(const Opm::SummaryConfigNode&        node,
 
     if (schedule_wells.empty()) { return; }
 
-    const auto cat = node.category();
     if(    cat != Opm::SummaryConfigNode::Category::Group
         && cat != Opm::SummaryConfigNode::Category::Field
         && cat != Opm::SummaryConfigNode::Category::Region
-           && (node.type() != Opm::SummaryConfigNode::Type::Total))
+           && is_rate)
         return;
 
     const bool is_group = (cat == Opm::SummaryConfigNode::Category::Group);
-    const bool is_rate = (node.type() != Opm::SummaryConfigNode::Type::Total);
 
     for( const auto& well : schedule_wells ) {
         if (!well.hasBeenDefined(sim_step))
@@ -1327,7 +1334,7 @@ void EfficiencyFactor::setFactors(const Opm::SummaryConfigNode&        node,
         while(true){
             if((   is_group
                 && is_rate
-                && group_ptr->name() == node.namedEntity() ))
+                && group_ptr->name() == entity ))
                 break;
             eff_factor *= group_ptr->getGroupEfficiencyFactor();
 
@@ -1338,6 +1345,114 @@ void EfficiencyFactor::setFactors(const Opm::SummaryConfigNode&        node,
 
         this->factors.emplace_back( well.name(), eff_factor );
     }
+
+    std::sort(this->factors.begin(), this->factors.end(),
+              [](const Factor& f1, const Factor& f2) { return f1.first < f2.first; });
+}
+
+/*
+ * Wells and efficiency factors of the wells, groups, field and regions
+ * referenced by summary vectors which need well information.  These depend
+ * on the schedule alone, which is constant within a report step, so they are
+ * compiled once per report step and shared by all vectors of an entity
+ * instead of being recomputed for every vector.  The plan is not modified
+ * while the vectors are evaluated.
+ */
+class EvaluationPlan
+{
+public:
+    using Key = std::tuple<Opm::SummaryConfigNode::Category, std::string, int>;
+
+    struct Entity
+    {
+        std::vector<Opm::Well>    wells{};
+        EfficiencyFactor::FacColl rateFactors{};
+        EfficiencyFactor::FacColl totalFactors{};
+    };
+
+    // Well, connection and segment vectors of one well share an entity.
+    static Key key(const Opm::SummaryConfigNode& node);
+
+    void addNode(const Opm::SummaryConfigNode& node);
+
+    bool compiledFor(const Opm::Schedule& schedule, const int sim_step) const
+    {
+        return (this->schedule_ == &schedule) && (this->sim_step_ == sim_step);
+    }
+
+    void compile(const Opm::Schedule&         schedule,
+                 const int                    sim_step,
+                 const Opm::out::RegionCache& regionCache);
+
+    const Entity& entity(const Key& key) const;
+
+private:
+    std::map<Key, Opm::SummaryConfigNode> nodes_{};
+    std::map<Key, Entity> entities_{};
+
+    const Opm::Schedule* schedule_{nullptr};
+    int sim_step_{-1};
+};
+
+EvaluationPlan::Key EvaluationPlan::key(const Opm::SummaryConfigNode& node)
+{
+    using Cat = Opm::SummaryConfigNode::Category;
+
+    switch (node.category()) {
+    case Cat::Well:
+    case Cat::Connection:
+    case Cat::Segment:
+        return Key { Cat::Well, node.namedEntity(), 0 };
+
+    case Cat::Group:
+        return Key { Cat::Group, node.namedEntity(), 0 };
+
+    case Cat::Region:
+        return Key { Cat::Region, "", node.number() };
+
+    default:
+        return Key { node.category(), "", 0 };
+    }
+}
+
+void EvaluationPlan::addNode(const Opm::SummaryConfigNode& node)
+{
+    this->nodes_.emplace(key(node), node);
+    this->schedule_ = nullptr;
+}
+
+void EvaluationPlan::compile(const Opm::Schedule&         schedule,
+                             const int                    sim_step,
+                             const Opm::out::RegionCache& regionCache)
+{
+    this->entities_.clear();
+
+    for (const auto& [key, node] : this->nodes_) {
+        auto& entity = this->entities_[key];
+
+        entity.wells = find_wells(schedule, node, sim_step, regionCache);
+
+        EfficiencyFactor efac{};
+        efac.setFactors(node.category(), node.namedEntity(), true,
+                        schedule, entity.wells, sim_step);
+        entity.rateFactors = std::move(efac.factors);
+
+        efac.setFactors(node.category(), node.namedEntity(), false,
+                        schedule, entity.wells, sim_step);
+        entity.totalFactors = std::move(efac.factors);
+    }
+
+    this->schedule_ = &schedule;
+    this->sim_step_ = sim_step;
+}
+
+const EvaluationPlan::Entity& EvaluationPlan::entity(const Key& key) const
+{
+    static const Entity noEntity{};
+
+    auto pos = this->entities_.find(key);
+
+    return (pos == this->entities_.end()) ? noEntity : pos->second;
 }
 
 namespace Evaluator {
@@ -1347,6 +1462,7 @@ namespace Evaluator {
         const Opm::Schedule& sched;
         const Opm::EclipseGrid& grid;
         const Opm::out::RegionCache& reg;
+        const EvaluationPlan& plan;
     };
 
     struct SimulatorResults
@@ -1362,59 +1478,84 @@ namespace Evaluator {
     public:
         virtual ~Base() {}
 
-        virtual void update(const std::size_t       sim_step,
-                            const double            stepSize,
-                            const InputData&        input,
-                            const SimulatorResults& simRes,
-                            Opm::SummaryState&      st) const = 0;
+        // Calculate the value of the parameter into 'value'.  Returns false
+        // if the parameter has no value at this step.  Must not modify any
+        // shared state, evaluate() may be called concurrently for different
+        // parameters.
+        virtual bool evaluate(const std::size_t        sim_step,
+                              const double             stepSize,
+                              const InputData&         input,
+                              const SimulatorResults&  simRes,
+                              const Opm::SummaryState& st,
+                              double&                  value) const = 0;
+
+        // Slot in 'st' which the value is stored in.
+        virtual Opm::SummaryState::Handle handle(Opm::SummaryState& st) const = 0;
+
+        // Register the entities whose wells are needed by update().
+        virtual void registerEntities(EvaluationPlan& /* plan */) const {}
     };
 
     class FunctionRelation : public Base
     {
     public:
         explicit FunctionRelation(Opm::SummaryConfigNode node, ofun fcn)
-            : node_(std::move(node))
-            , fcn_ (std::move(fcn))
+            : node_     (std::move(node))
+            , fcn_      (std::move(fcn))
+            , needWells_(need_wells(node_.category(), node_.keyword()))
+            , entityKey_(EvaluationPlan::key(node_))
         {}
 
-        void update(const std::size_t       sim_step,
-                    const double            stepSize,
-                    const InputData&        input,
-                    const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+        void registerEntities(EvaluationPlan& plan) const override
+        {
+            if (this->needWells_)
+                plan.addNode(this->node_);
+        }
+
+        bool evaluate(const std::size_t        sim_step,
+                      const double             stepSize,
+                      const InputData&         input,
+                      const SimulatorResults&  simRes,
+                      const Opm::SummaryState& st,
+                      double&                  value) const override
         {
-            const auto get_wells =
-                need_wells(this->node_.category(), this->node_.keyword());
+            static const EvaluationPlan::Entity noWells{};
 
-            const auto wells = get_wells
-                ? find_wells(input.sched, this->node_,
-                             static_cast<int>(sim_step), input.reg)
-                : std::vector<Opm::Well>{};
+            const auto& entity = this->needWells_
+                ? input.plan.entity(this->entityKey_) : noWells;
 
-            if (get_wells && wells.empty())
+            if (this->needWells_ && entity.wells.empty())
                 // Parameter depends on well information, but no active
                 // wells apply at this sim_step.  Nothing to do.
-                return;
+                return false;
 
-            EfficiencyFactor efac{};
-            efac.setFactors(this->node_, input.sched, wells, sim_step);
+            const auto is_total =
+                this->node_.type() == Opm::SummaryConfigNode::Type::Total;
 
             const fn_args args {
-                wells, stepSize, static_cast<int>(sim_step),
+                entity.wells, stepSize, static_cast<int>(sim_step),
                 std::max(0, this->node_.number()),
                 st, simRes.wellSol, input.reg, input.grid,
-                std::move(efac.factors)
+                is_total ? entity.totalFactors : entity.rateFactors
             };
 
             const auto& usys = input.es.getUnits();
             const auto  prm  = this->fcn_(args);
 
-            updateValue(this->node_, usys.from_si(prm.unit, prm.value), st);
+            value = usys.from_si(prm.unit, prm.value);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return nodeHandle(this->node_, st);
         }
 
     private:
         Opm::SummaryConfigNode node_;
         ofun             fcn_;
+        bool             needWells_;
+        EvaluationPlan::Key entityKey_;
     };
 
     class BlockValue : public Base
@@ -1426,19 +1567,26 @@ namespace Evaluator {
             , m_   (m)
         {}
 
-        void update(const std::size_t    /* sim_step */,
-                    const double         /* stepSize */,
-                    const InputData&        input,
-                    const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+        bool evaluate(const std::size_t     /* sim_step */,
+                      const double          /* stepSize */,
+                      const InputData&         input,
+                      const SimulatorResults&  simRes,
+                      const Opm::SummaryState& /* st */,
+                      double&                  value) const override
         {
             auto xPos = simRes.block.find(this->lookupKey());
             if (xPos == simRes.block.end()) {
-                return;
+                return false;
             }
 
             const auto& usys = input.es.getUnits();
-            updateValue(this->node_, usys.from_si(this->m_, xPos->second), st);
+            value = usys.from_si(this->m_, xPos->second);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return nodeHandle(this->node_, st);
         }
 
     private:
@@ -1460,27 +1608,34 @@ namespace Evaluator {
             , m_   (m)
         {}
 
-        void update(const std::size_t    /* sim_step */,
-                    const double         /* stepSize */,
-                    const InputData&        input,
-                    const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+        bool evaluate(const std::size_t     /* sim_step */,
+                      const double          /* stepSize */,
+                      const InputData&         input,
+                      const SimulatorResults&  simRes,
+                      const Opm::SummaryState& /* st */,
+                      double&                  value) const override
         {
             if (this->node_.number() < 0)
-                return;
+                return false;
 
             auto xPos = simRes.region.find(this->node_.keyword());
             if (xPos == simRes.region.end())
-                return;
+                return false;
 
             const auto ix = this->index();
             if (ix >= xPos->second.size())
-                return;
+                return false;
 
             const auto  val  = xPos->second[ix];
             const auto& usys = input.es.getUnits();
 
-            updateValue(this->node_, usys.from_si(this->m_, val), st);
+            value = usys.from_si(this->m_, val);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return nodeHandle(this->node_, st);
         }
 
     private:
@@ -1502,20 +1657,27 @@ namespace Evaluator {
             , m_   (m)
         {}
 
-        void update(const std::size_t    /* sim_step */,
-                    const double         /* stepSize */,
-                    const InputData&        input,
-                    const SimulatorResults& simRes,
-                    Opm::SummaryState&      st) const override
+        bool evaluate(const std::size_t     /* sim_step */,
+                      const double          /* stepSize */,
+                      const InputData&         input,
+                      const SimulatorResults&  simRes,
+                      const Opm::SummaryState& /* st */,
+                      double&                  value) const override
         {
             auto xPos = simRes.single.find(this->node_.keyword());
             if (xPos == simRes.single.end())
-                return;
+                return false;
 
             const auto  val  = xPos->second;
             const auto& usys = input.es.getUnits();
 
-            updateValue(this->node_, usys.from_si(this->m_, val), st);
+            value = usys.from_si(this->m_, val);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return nodeHandle(this->node_, st);
         }
 
     private:
@@ -1526,13 +1688,20 @@ namespace Evaluator {
     class UserDefinedValue : public Base
     {
     public:
-        void update(const std::size_t       /* sim_step */,
-                    const double            /* stepSize */,
-                    const InputData&        /* input */,
-                    const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&      /* st */) const override
+        bool evaluate(const std::size_t        /* sim_step */,
+                      const double             /* stepSize */,
+                      const InputData&         /* input */,
+                      const SimulatorResults&  /* simRes */,
+                      const Opm::SummaryState& /* st */,
+                      double&                  /* value */) const override
         {
             // No-op
+            return false;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& /* st */) const override
+        {
+            return Opm::SummaryState::invalid_handle;
         }
     };
 
@@ -1543,18 +1712,25 @@ namespace Evaluator {
             : saveKey_(std::move(saveKey))
         {}
 
-        void update(const std::size_t       /* sim_step */,
-                    const double               stepSize,
-                    const InputData&           input,
-                    const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+        bool evaluate(const std::size_t        /* sim_step */,
+                      const double                stepSize,
+                      const InputData&            input,
+                      const SimulatorResults&  /* simRes */,
+                      const Opm::SummaryState&    st,
+                      double&                     value) const override
         {
             const auto& usys = input.es.getUnits();
 
             const auto m   = ::Opm::UnitSystem::measure::time;
             const auto val = st.get_elapsed() + stepSize;
 
-            st.update(this->saveKey_, usys.from_si(m, val));
+            value = usys.from_si(m, val);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return st.handle(this->saveKey_);
         }
 
     private:
@@ -1568,17 +1744,24 @@ namespace Evaluator {
             : saveKey_(std::move(saveKey))
         {}
 
-        void update(const std::size_t       /* sim_step */,
-                    const double               stepSize,
-                    const InputData&        /* input */,
-                    const SimulatorResults& /* simRes */,
-                    Opm::SummaryState&         st) const override
+        bool evaluate(const std::size_t        /* sim_step */,
+                      const double                stepSize,
+                      const InputData&         /* input */,
+                      const SimulatorResults&  /* simRes */,
+                      const Opm::SummaryState&    st,
+                      double&                     value) const override
         {
             using namespace ::Opm::unit;
 
             const auto val = st.get_elapsed() + stepSize;
 
-            st.update(this->saveKey_, convert::to(val, year));
+            value = convert::to(val, year);
+            return true;
+        }
+
+        Opm::SummaryState::Handle handle(Opm::SummaryState& st) const override
+        {
+            return st.handle(this->saveKey_);
         }
 
     private:
@@ -2013,9 +2196,11 @@ public:
                                    const std::string&   basename);
 
     SummaryImplementation(const SummaryImplementation& rhs) = delete;
-    SummaryImplementation(SummaryImplementation&& rhs) = default;
+    SummaryImplementation(SummaryImplementation&& rhs) = delete;
     SummaryImplementation& operator=(const SummaryImplementation& rhs) = delete;
-    SummaryImplementation& operator=(SummaryImplementation&& rhs) = default;
+    SummaryImplementation& operator=(SummaryImplementation&& rhs) = delete;
+
+    ~SummaryImplementation();
 
     void eval(const EclipseState&            es,
               const Schedule&                sched,
@@ -2027,8 +2212,14 @@ public:
               const BlockValues&             block_values,
               SummaryState&                  st) const;
 
+    void enableParallelEvaluation(const bool enable);
+
     void internal_store(const SummaryState& st, const int report_step);
-    void write();
+    void write(const bool isReportStep);
+    void flush();
+
+    void setFlushPolicy(const FlushPolicy& policy);
+    const FlushStatistics& flushStatistics() const;
 
 private:
     struct MiniStep
@@ -2043,6 +2234,9 @@ private:
     std::reference_wrapper<const Opm::EclipseGrid> grid_;
     Opm::out::RegionCache regCache_;
 
+    // Compiled on first evaluation in each report step.
+    mutable EvaluationPlan plan_{};
+
     std::unique_ptr<SMSpecStreamDeferredCreation> deferredSMSpec_;
 
     Opm::EclIO::OutputStream::ResultSet rset_;
@@ -2054,9 +2248,28 @@ private:
     int prevReportStepID_{-1};
     std::vector<MiniStep>::size_type numUnwritten_{0};
 
+    // Number of unwritten ministeps that were passed to write() but held
+    // back by the flush policy.
+    std::vector<MiniStep>::size_type numDeferred_{0};
+
+    FlushPolicy flushPolicy_{};
+    FlushStatistics flushStats_{};
+    std::chrono::steady_clock::time_point lastFlush_{};
+
     SummaryOutputParameters  outputParameters_{};
     std::vector<EvalPtr>     requiredRestartParameters_{};
+
+    // All evaluators, output parameters first, and the per-evaluator state
+    // of eval().
+    std::vector<const Evaluator::Base*> evaluators_{};
+    bool parallelEval_{false};
+    mutable std::vector<double> evalValues_{};
+    mutable std::vector<char> evalDefined_{};
+    mutable std::vector<SummaryState::Handle> evalHandles_{};
+    mutable std::size_t evalHandlesLayout_{0};
     std::vector<std::string> valueKeys_{};
+    std::vector<SummaryState::Handle> valueHandles_{};
+    std::size_t valueHandlesLayout_{0};
     std::vector<MiniStep>    unwritten_{};
 
     std::unique_ptr<Opm::EclIO::OutputStream::SummarySpecification> smspec_{};
@@ -2075,6 +2288,7 @@ private:
     MiniStep& getNextMiniStep(const int report_step);
     const MiniStep& lastUnwritten() const;
 
+    bool flushDue(const bool isReportStep) const;
     void write(const MiniStep& ms);
 
     void createSMSpecIfNecessary();
@@ -2093,10 +2307,29 @@ SummaryImplementation(const EclipseState&  es,
     , rset_          (makeResultSet(es.cfg().io(), basename))
     , fmt_           { es.cfg().io().getFMTOUT() }
     , unif_          { es.cfg().io().getUNIFOUT() }
+    , lastFlush_     (std::chrono::steady_clock::now())
 {
     this->configureTimeVectors(es);
     this->configureSummaryInput(es, sumcfg, grid, sched);
     this->configureRequiredRestartParameters(sumcfg, sched);
+
+    for (const auto& evalPtr : this->outputParameters_.getEvaluators())
+        this->evaluators_.push_back(evalPtr.get());
+
+    for (const auto& evalPtr : this->requiredRestartParameters_)
+        this->evaluators_.push_back(evalPtr.get());
+}
+
+Opm::out::Summary::SummaryImplementation::~SummaryImplementation()
+{
+    // Ministeps held back by the flush policy are written, errors can not
+    // be reported from here.  Ministeps never passed to write() are not.
+    try {
+        this->numUnwritten_ = this->numDeferred_;
+        this->flush();
+    }
+    catch (...) {
+    }
 }
 
 void Opm::out::Summary::SummaryImplementation::
@@ -2106,13 +2339,26 @@ internal_store(const SummaryState& st, const int report_step)
 
     const auto nParam = this->valueKeys_.size();
 
+    if (this->valueHandlesLayout_ != st.layout()) {
+        // Keys registered in 'st' have changed since the handles were
+        // looked up.  Typically only happens in the first few steps.
+        this->valueHandles_.resize(nParam);
+
+        for (auto i = decltype(nParam){0}; i < nParam; ++i)
+            this->valueHandles_[i] = st.find_handle(this->valueKeys_[i]);
+
+        this->valueHandlesLayout_ = st.layout();
+    }
+
     for (auto i = decltype(nParam){0}; i < nParam; ++i) {
-        if (! st.has(this->valueKeys_[i]))
+        const auto handle = this->valueHandles_[i];
+
+        if ((handle == SummaryState::invalid_handle) || ! st.has(handle))
             // Parameter not yet evaluated (e.g., well/group not
             // yet active).  Nothing to do here.
             continue;
 
-        ms.params[i] = st.get(this->valueKeys_[i]);
+        ms.params[i] = st.get(handle);
     }
 }
 
@@ -2128,45 +2374,159 @@ eval(const EclipseState&            es,
      const BlockValues&             block_values,
      Opm::SummaryState&             st) const
 {
+    if (! this->plan_.compiledFor(sched, sim_step))
+        this->plan_.compile(sched, sim_step, this->regCache_);
+
     const Evaluator::InputData input {
-        es, sched, this->grid_, this->regCache_
+        es, sched, this->grid_, this->regCache_, this->plan_
     };
 
     const Evaluator::SimulatorResults simRes {
         well_solution, single_values, region_values, block_values
     };
 
-    for (auto& evalPtr : this->outputParameters_.getEvaluators()) {
-        evalPtr->update(sim_step, duration, input, simRes, st);
+    const auto numEval = this->evaluators_.size();
+
+    if (this->evalHandlesLayout_ != st.layout()) {
+        this->evalHandles_.resize(numEval);
+
+        for (auto i = decltype(numEval){0}; i < numEval; ++i)
+            this->evalHandles_[i] = this->evaluators_[i]->handle(st);
+
+        this->evalHandlesLayout_ = st.layout();
+    }
+
+    // Every parameter is evaluated into a slot of its own, possibly in
+    // parallel, and the values are then stored in 'st' in the order of the
+    // parameters.  Parameters accumulating into the same key are therefore
+    // summed in the same order whether or not the evaluation is parallel.
+    // If evaluations fail, the exception of the first failing parameter is
+    // rethrown after the values of the parameters preceding it are stored.
+
+    this->evalValues_.resize(numEval);
+    this->evalDefined_.assign(numEval, 0);
+
+    const auto n = static_cast<long>(numEval);
+    auto numStored = n;
+    std::exception_ptr failure;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16) if(this->parallelEval_)
+#endif
+    for (long i = 0; i < n; ++i) {
+        try {
+            this->evalDefined_[i] = this->evaluators_[i]->
+                evaluate(sim_step, duration, input, simRes, st, this->evalValues_[i]);
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (i < numStored) {
+                numStored = i;
+                failure = std::current_exception();
+            }
+        }
     }
 
-    for (auto& evalPtr : this->requiredRestartParameters_) {
-        evalPtr->update(sim_step, duration, input, simRes, st);
+    for (long i = 0; i < numStored; ++i) {
+        if (this->evalDefined_[i])
+            st.update(this->evalHandles_[i], this->evalValues_[i]);
     }
+
+    if (failure)
+        std::rethrow_exception(failure);
 }
 
-void Opm::out::Summary::SummaryImplementation::write()
+void Opm::out::Summary::SummaryImplementation::
+enableParallelEvaluation(const bool enable)
+{
+    this->parallelEval_ = enable;
+}
+
+void Opm::out::Summary::SummaryImplementation::write(const bool isReportStep)
+{
+    if (this->flushDue(isReportStep))
+        this->flush();
+    else
+        this->numDeferred_ = this->numUnwritten_;
+}
+
+void Opm::out::Summary::SummaryImplementation::flush()
 {
     const auto zero = std::vector<MiniStep>::size_type{0};
     if (this->numUnwritten_ == zero)
         // No unwritten data.  Nothing to do so return early.
         return;
 
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    const auto start = Clock::now();
+
     this->createSMSpecIfNecessary();
 
     if (this->prevReportStepID_ < this->lastUnwritten().seq) {
         this->smspec_->write(this->outputParameters_.summarySpecification());
     }
 
+    // Only complete SEQHDR/MINISTEP/PARAMS groups are handed to the
+    // stream, and the stream is flushed after the last of them.  The file
+    // on disk therefore ends at a ministep boundary after every flush, and
+    // a crash loses at most the ministeps that were still pending.
     for (auto i = 0*this->numUnwritten_; i < this->numUnwritten_; ++i)
         this->write(this->unwritten_[i]);
 
+    const auto written = Clock::now();
+
     // Eagerly output last set of parameters to permanent storage.
     this->stream_->flushStream();
 
+    this->lastFlush_ = Clock::now();
+
+    this->flushStats_.flushes += 1;
+    this->flushStats_.ministepsWritten += this->numUnwritten_;
+    this->flushStats_.writeSeconds += Seconds(written - start).count();
+    this->flushStats_.flushSeconds += Seconds(this->lastFlush_ - written).count();
+
     // Reset "unwritten" counter to reflect the fact that we've
     // output all stored ministeps.
     this->numUnwritten_ = zero;
+    this->numDeferred_ = zero;
+}
+
+bool
+Opm::out::Summary::SummaryImplementation::
+flushDue(const bool isReportStep) const
+{
+    const auto& policy = this->flushPolicy_;
+
+    if ((policy.ministeps > 0) && (this->numUnwritten_ >= policy.ministeps))
+        return true;
+
+    if (policy.reportSteps && isReportStep)
+        return true;
+
+    if (policy.seconds > 0.0) {
+        const auto since = std::chrono::duration<double>
+            { std::chrono::steady_clock::now() - this->lastFlush_ };
+
+        return since.count() >= policy.seconds;
+    }
+
+    return false;
+}
+
+void Opm::out::Summary::SummaryImplementation::
+setFlushPolicy(const FlushPolicy& policy)
+{
+    this->flushPolicy_ = policy;
+}
+
+const Opm::out::Summary::FlushStatistics&
+Opm::out::Summary::SummaryImplementation::flushStatistics() const
+{
+    return this->flushStats_;
 }
 
 void Opm::out::Summary::SummaryImplementation::write(const MiniStep& ms)
@@ -2252,6 +2612,8 @@ configureSummaryInput(const EclipseState&  es,
 
         // This keyword has a known evaluation method.
 
+        prmDescr.evaluator->registerEntities(this->plan_);
+
         this->valueKeys_.push_back(std::move(prmDescr.uniquekey));
 
         this->outputParameters_
@@ -2284,6 +2646,8 @@ configureRequiredRestartParameters(const SummaryConfig& sumcfg,
         auto eval = std::make_unique<
             Evaluator::FunctionRelation>(node, fcnPos->second);
 
+        eval->registerEntities(this->plan_);
+
         this->requiredRestartParameters_.push_back(std::move(eval));
     };
 
@@ -2421,6 +2785,11 @@ void Summary::eval(SummaryState&                  st,
     st.update_elapsed(duration);
 }
 
+void Summary::enableParallelEvaluation(const bool enable)
+{
+    this->pImpl_->enableParallelEvaluation(enable);
+}
+
 void Summary::add_timestep(const SummaryState& st, const int report_step)
 {
     this->pImpl_->internal_store(st, report_step);
@@ -2428,7 +2797,27 @@ void Summary::add_timestep(const SummaryState& st, const int report_step)
 
 void Summary::write() const
 {
-    this->pImpl_->write();
+    this->pImpl_->write(true);
+}
+
+void Summary::write(const bool isReportStep) const
+{
+    this->pImpl_->write(isReportStep);
+}
+
+void Summary::flush() const
+{
+    this->pImpl_->flush();
+}
+
+void Summary::setFlushPolicy(const FlushPolicy& policy)
+{
+    this->pImpl_->setFlushPolicy(policy);
+}
+
+Summary::FlushStatistics Summary::flushStatistics() const
+{
+    return this->pImpl_->flushStatistics();
 }
 
 Summary::~Summary() {}
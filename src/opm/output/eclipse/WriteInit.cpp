@@ -352,6 +352,8 @@ namespace {
         auto dz    = std::vector<float>{};  dz   .reserve(nAct);
         auto depth = std::vector<float>{};  depth.reserve(nAct);
 
+        const auto cellDepth = grid.getCellGeometry(::Opm::CellGeometry::Depths).depth;
+
         for (auto cell = 0*nAct; cell < nAct; ++cell) {
             const auto  globCell = grid.getGlobalIndex(cell);
             const auto& dims     = grid.getCellDims(globCell);
@@ -359,7 +361,7 @@ namespace {
             dx   .push_back(units.from_si(length, dims[0]));
             dy   .push_back(units.from_si(length, dims[1]));
             dz   .push_back(units.from_si(length, dims[2]));
-            depth.push_back(units.from_si(length, grid.getCellDepth(globCell)));
+            depth.push_back(units.from_si(length, cellDepth[cell]));
         }
 
         initFile.write("DEPTH", depth);
@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -149,6 +150,23 @@ namespace Opm {
         this->init(keywordList.begin(), keywordList.end());
     }
 
+    Deck::Deck(std::vector<DeckKeyword>&& keywords,
+               const UnitSystem& defUnits,
+               const UnitSystem* activeUnit,
+               const std::string& dataFile,
+               const std::string& inputPath,
+               size_t accessCount) :
+        keywordList(std::move(keywords)),
+        defaultUnits(defUnits),
+        m_dataFile(dataFile),
+        input_path(inputPath),
+        unit_system_access_count(accessCount)
+    {
+        if (activeUnit)
+            activeUnits.reset(new UnitSystem(*activeUnit));
+        this->init(keywordList.begin(), keywordList.end());
+    }
+
 
 
     /*
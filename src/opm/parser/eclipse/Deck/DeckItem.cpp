@@ -27,30 +27,33 @@
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
+#include <utility>
 
 namespace Opm {
 
-DeckItem::DeckItem(const std::vector<double>& dVec,
-                   const std::vector<int>& iVec,
-                   const std::vector<std::string>& sVec,
-                   const std::vector<UDAValue>& uVec,
+DeckItem::DeckItem(std::vector<double> dVec,
+                   std::vector<int> iVec,
+                   std::vector<std::string> sVec,
+                   std::vector<UDAValue> uVec,
                    type_tag typ,
                    const std::string& itemName,
                    const std::vector<value::status>& valueStat,
                    bool rawdata,
                    const std::vector<Dimension>& activeDim,
                    const std::vector<Dimension>& defDim)
-    : dval(dVec)
-    , ival(iVec)
-    , sval(sVec)
-    , uval(uVec)
+    : dval(std::move(dVec))
+    , ival(std::move(iVec))
+    , sval(std::move(sVec))
+    , uval(std::move(uVec))
     , type(typ)
     , item_name(itemName)
-    , value_status(valueStat)
     , raw_data(rawdata)
     , active_dimensions(activeDim)
     , default_dimensions(defDim)
-{}
+{
+    for (const auto& st : valueStat)
+        this->push_status(st);
+}
 
 template< typename T >
 std::vector< T >& DeckItem::value_ref() {
@@ -125,32 +128,61 @@ const std::string& DeckItem::name() const {
     return this->item_name;
 }
 
+value::status DeckItem::status( size_t index ) const {
+    const auto run = std::upper_bound( this->status_ends.begin(), this->status_ends.end(), index );
+    return this->status_runs[ run - this->status_ends.begin() ];
+}
+
+void DeckItem::push_status( value::status st, size_t n ) {
+    if (n == 0)
+        return;
+
+    if (!this->status_runs.empty() && this->status_runs.back() == st)
+        this->status_ends.back() += n;
+    else {
+        this->status_ends.push_back( this->data_size() + n );
+        this->status_runs.push_back( st );
+    }
+}
+
 bool DeckItem::defaultApplied( size_t index ) const {
-    return value::defaulted( this->value_status.at(index));
+    if (index >= this->data_size())
+        throw std::out_of_range("Invalid index");
+
+    return value::defaulted( this->status(index) );
 }
 
-const std::vector<value::status>& DeckItem::getValueStatus() const {
-    return this->value_status;
+std::vector<value::status> DeckItem::getValueStatus() const {
+    std::vector<value::status> value_status;
+    value_status.reserve( this->data_size() );
+
+    std::size_t index = 0;
+    for (std::size_t run = 0; run < this->status_ends.size(); run++) {
+        value_status.insert( value_status.end(), this->status_ends[run] - index, this->status_runs[run] );
+        index = this->status_ends[run];
+    }
+
+    return value_status;
 }
 
 bool DeckItem::hasValue( size_t index ) const {
-    if (index >= this->value_status.size())
+    if (index >= this->data_size())
         return false;
 
-    return value::has_value( this->value_status[index] );
+    return value::has_value( this->status(index) );
 }
 
 size_t DeckItem::data_size() const {
-    return this->value_status.size();
+    return this->status_ends.empty() ? 0 : this->status_ends.back();
 }
 
 
 template< typename T >
 T DeckItem::get( size_t index ) const {
-    if (index >= this->value_status.size())
+    if (index >= this->data_size())
         throw std::out_of_range("Invalid index");
 
-    if (!value::has_value(this->value_status[index]))
+    if (!value::has_value(this->status(index)))
         throw std::invalid_argument("Invalid arguemnt");
 
     return this->value_ref< T >()[index];
@@ -166,7 +198,7 @@ UDAValue DeckItem::get( size_t index ) const {
     // correctly we therefor need to create a new one with the correct dimension
     // attached before returning.
     std::size_t dim_index = index % this->active_dimensions.size();
-    if (value::defaulted(this->value_status[index])) {
+    if (value::defaulted(this->status(index))) {
         if (value.is<std::string>())
             return UDAValue(value.get<std::string>(), this->default_dimensions[dim_index]);
         else
@@ -191,7 +223,7 @@ void DeckItem::push( T x ) {
     auto& val = this->value_ref< T >();
 
     val.push_back( std::move( x ) );
-    this->value_status.push_back( value::status::deck_value );
+    this->push_status( value::status::deck_value );
 }
 
 void DeckItem::push_back( int x ) {
@@ -215,7 +247,7 @@ void DeckItem::push( T x, size_t n ) {
     auto& val = this->value_ref< T >();
 
     val.insert( val.end(), n, x );
-    this->value_status.insert( this->value_status.end(), n, value::status::deck_value );
+    this->push_status( value::status::deck_value, n );
 }
 
 void DeckItem::push_back( int x, size_t n ) {
@@ -237,12 +269,12 @@ void DeckItem::push_back( UDAValue x, size_t n ) {
 template< typename T >
 void DeckItem::push_default( T x ) {
     auto& val = this->value_ref< T >();
-    if( this->value_status.size() != val.size() )
+    if( this->data_size() != val.size() )
         throw std::logic_error("To add a value to an item, "
                 "no 'pseudo defaults' can be added before");
 
     val.push_back( std::move( x ) );
-    this->value_status.push_back( value::status::valid_default );
+    this->push_status( value::status::valid_default );
 }
 
 void DeckItem::push_backDefault( int x ) {
@@ -266,7 +298,26 @@ template<typename T>
 void DeckItem::push_backDummyDefault() {
     auto& val = this->value_ref< T >();
     val.push_back( T() );
-    this->value_status.push_back( value::status::empty_default );
+    this->push_status( value::status::empty_default );
+}
+
+void DeckItem::reserve( std::size_t n ) {
+    switch( this->type ) {
+    case type_tag::integer:
+        this->ival.reserve( n );
+        break;
+    case type_tag::fdouble:
+        this->dval.reserve( n );
+        break;
+    case type_tag::string:
+        this->sval.reserve( n );
+        break;
+    case type_tag::uda:
+        this->uval.reserve( n );
+        break;
+    default:
+        break;
+    }
 }
 
 std::string DeckItem::getTrimmedString( size_t index ) const {
@@ -277,23 +328,35 @@ double DeckItem::getSIDouble( size_t index ) const {
     return this->getSIDoubleData().at( index );
 }
 
+/*
+  Applies convert(dim, value) to each value of a double item, with the
+  default dimension for defaulted values and the active dimension for the
+  others.
+*/
+template< typename Convert >
+void DeckItem::convert_dimensions( Convert&& convert ) const {
+    auto& data = this->dval;
+    const auto dim_size = this->active_dimensions.size();
+
+    size_t index = 0;
+    for( size_t run = 0; run < this->status_ends.size(); run++ ) {
+        const auto& dims = value::defaulted( this->status_runs[run] )
+                         ? this->default_dimensions
+                         : this->active_dimensions;
+
+        const auto end = std::min( this->status_ends[run], data.size() );
+        for( ; index < end; index++ )
+            data[ index ] = convert( dims[ index % dim_size ], data[ index ] );
+    }
+}
+
 template<>
 const std::vector<double>& DeckItem::getData() const {
     auto& data = (const_cast<DeckItem*>(this))->value_ref< double >();
     if (this->raw_data)
         return data;
 
-    const auto dim_size = this->active_dimensions.size();
-    for( size_t index = 0; index < data.size(); index++ ) {
-        const auto dimIndex = index % dim_size;
-        if (value::defaulted(this->value_status[index])) {
-            const auto& dim = this->default_dimensions[dimIndex];
-            data[ index ] = dim.convertSiToRaw( data[ index ] );
-        } else {
-            const auto& dim = this->active_dimensions[dimIndex];
-            data[ index ] = dim.convertSiToRaw( data[ index ] );
-        }
-    }
+    this->convert_dimensions( []( const Dimension& dim, double value ) { return dim.convertSiToRaw( value ); } );
     this->raw_data = true;
     return data;
 }
@@ -314,18 +377,7 @@ const std::vector< double >& DeckItem::getSIDoubleData() const {
      * SI units, so externally the object still behaves as const
      */
 
-    const auto dim_size = this->active_dimensions.size();
-    const auto sz = data.size();
-    for( size_t index = 0; index < sz; index++ ) {
-        const auto dimIndex = index % dim_size;
-        if (value::defaulted(this->value_status[index])) {
-            const auto& dim = this->default_dimensions[dimIndex];
-            data[ index ] = dim.convertRawToSi( data[ index ] );
-        } else {
-            const auto& dim = this->active_dimensions[dimIndex];
-            data[ index ] = dim.convertRawToSi( data[ index ] );
-        }
-    }
+    this->convert_dimensions( []( const Dimension& dim, double value ) { return dim.convertRawToSi( value ); } );
     this->raw_data = false;
     return data;
 }
@@ -406,8 +458,9 @@ bool DeckItem::equal(const DeckItem& other, bool cmp_default, bool cmp_numeric)
     if (this->item_name != other.item_name)
         return false;
 
+    // the runs are always merged, so equal status gives equal runs
     if (cmp_default)
-        if (this->value_status != other.value_status)
+        if (this->status_ends != other.status_ends || this->status_runs != other.status_runs)
             return false;
 
     switch( this->type ) {
@@ -507,8 +560,8 @@ const std::vector<UDAValue>& DeckItem::uVal() const {
     return uval;
 }
 
-const std::vector<value::status>& DeckItem::valueStatus() const {
-    return value_status;
+std::vector<value::status> DeckItem::valueStatus() const {
+    return this->getValueStatus();
 }
 
 bool DeckItem::rawData() const {
@@ -280,7 +280,7 @@ namespace Opm {
         return this->getDataRecord().getDataItem().getSIDoubleData();
     }
 
-    const std::vector<value::status>& DeckKeyword::getValueStatus() const {
+    std::vector<value::status> DeckKeyword::getValueStatus() const {
         return this->getDataRecord().getDataItem().getValueStatus();
    }
 
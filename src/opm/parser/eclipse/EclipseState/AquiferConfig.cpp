@@ -44,7 +44,7 @@ bool AquiferConfig::active() const {
     return this->aqconn.active();
 }
 
-bool AquiferConfig::operator==(const AquiferConfig& other) {
+bool AquiferConfig::operator==(const AquiferConfig& other) const {
     return this->aquifetp == other.aquifetp &&
            this->aquiferct == other.aquiferct &&
            this->aqconn == other.aqconn;
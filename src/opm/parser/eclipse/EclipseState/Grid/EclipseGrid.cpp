@@ -1500,6 +1500,19 @@ EclipseGrid::EclipseGrid(const Deck& deck, const int * actnum)
         return this->getCellDepth(globalIndex);
     }
 
+    CellGeometry EclipseGrid::getCellGeometry(unsigned quantities) const {
+        return this->getCellGeometry(0, this->getNumActive(), quantities);
+    }
+
+    CellGeometry EclipseGrid::getCellGeometry(std::size_t activeBegin, std::size_t activeEnd, unsigned quantities) const {
+        if (activeBegin > activeEnd || activeEnd > this->getNumActive())
+            throw std::invalid_argument("Invalid range of active cells");
+
+        return calculateCellGeometry(this->getNXYZ(), m_coord, m_zcorn,
+                                     m_active_to_global.data() + activeBegin,
+                                     activeEnd - activeBegin, quantities);
+    }
+
     const std::vector<int>& EclipseGrid::getACTNUM( ) const {
 
         return m_actnum;
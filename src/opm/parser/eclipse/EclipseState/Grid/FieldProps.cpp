@@ -245,16 +245,17 @@ void verify_deck_data(const DeckKeyword& keyword, const std::vector<T>& deck_dat
 
 
 template <typename T>
-void assign_deck(const DeckKeyword& keyword, FieldProps::FieldData<T>& field_data, const std::vector<T>& deck_data, const std::vector<value::status>& deck_status, const Box& box) {
+void assign_deck(const DeckKeyword& keyword, FieldProps::FieldData<T>& field_data, const std::vector<T>& deck_data, const DeckItem& deck_item, const Box& box) {
     verify_deck_data(keyword, deck_data, box);
     for (const auto& cell_index : box.index_list()) {
         auto active_index = cell_index.active_index;
         auto data_index = cell_index.data_index;
+        auto deck_status = deck_item.status(data_index);
 
-        if (value::has_value(deck_status[data_index])) {
-            if (deck_status[data_index] == value::status::deck_value || field_data.value_status[active_index] == value::status::uninitialized) {
+        if (value::has_value(deck_status)) {
+            if (deck_status == value::status::deck_value || field_data.value_status[active_index] == value::status::uninitialized) {
                 field_data.data[active_index] = deck_data[data_index];
-                field_data.value_status[active_index] = deck_status[data_index];
+                field_data.value_status[active_index] = deck_status;
             }
         }
     }
@@ -262,15 +263,16 @@ void assign_deck(const DeckKeyword& keyword, FieldProps::FieldData<T>& field_dat
 
 
 template <typename T>
-void multiply_deck(const DeckKeyword& keyword, FieldProps::FieldData<T>& field_data, const std::vector<T>& deck_data, const std::vector<value::status>& deck_status, const Box& box) {
+void multiply_deck(const DeckKeyword& keyword, FieldProps::FieldData<T>& field_data, const std::vector<T>& deck_data, const DeckItem& deck_item, const Box& box) {
     verify_deck_data(keyword, deck_data, box);
     for (const auto& cell_index : box.index_list()) {
         auto active_index = cell_index.active_index;
         auto data_index = cell_index.data_index;
+        auto deck_status = deck_item.status(data_index);
 
-        if (value::has_value(deck_status[data_index]) && value::has_value(field_data.value_status[active_index])) {
+        if (value::has_value(deck_status) && value::has_value(field_data.value_status[active_index])) {
             field_data.data[active_index] *= deck_data[data_index];
-            field_data.value_status[active_index] = deck_status[data_index];
+            field_data.value_status[active_index] = deck_status;
         }
     }
 }
@@ -388,17 +390,11 @@ void handle_box_keyword(const DeckKeyword& deckKeyword,  Box& box) {
 
 
 std::vector<double> extract_cell_volume(const EclipseGrid& grid) {
-    std::vector<double> cell_volume(grid.getNumActive());
-    for (std::size_t active_index = 0; active_index < grid.getNumActive(); active_index++)
-        cell_volume[active_index] = grid.getCellVolume( grid.getGlobalIndex(active_index));
-    return cell_volume;
+    return grid.getCellGeometry(CellGeometry::Volumes).volume;
 }
 
 std::vector<double> extract_cell_depth(const EclipseGrid& grid) {
-    std::vector<double> cell_depth(grid.getNumActive());
-    for (std::size_t active_index = 0; active_index < grid.getNumActive(); active_index++)
-        cell_depth[active_index] = grid.getCellDepth( grid.getGlobalIndex(active_index));
-    return cell_depth;
+    return grid.getCellGeometry(CellGeometry::Depths).depth;
 }
 
 }
@@ -461,6 +457,19 @@ FieldProps::FieldProps(const Deck& deck, const Phases& phases, const EclipseGrid
 
 
 
+FieldProps::FieldProps(const EclipseGrid& grid, const TableManager& tables_arg) :
+    active_size(0),
+    global_size(0),
+    nx(0),
+    ny(0),
+    nz(0),
+    grid_ptr(&grid),
+    tables(tables_arg)
+{
+}
+
+
+
 void FieldProps::reset_actnum(const std::vector<int>& new_actnum) {
     if (this->global_size != new_actnum.size())
         throw std::logic_error("reset_actnum() must be called with the same number of global cells");
@@ -722,20 +731,20 @@ double FieldProps::getSIValue(const std::string& keyword, double raw_value) cons
 void FieldProps::handle_int_keyword(const DeckKeyword& keyword, const Box& box) {
     auto& field_data = this->init_get<int>(keyword.name());
     const auto& deck_data = keyword.getIntData();
-    const auto& deck_status = keyword.getValueStatus();
-    assign_deck(keyword, field_data, deck_data, deck_status, box);
+    const auto& deck_item = keyword.getDataRecord().getDataItem();
+    assign_deck(keyword, field_data, deck_data, deck_item, box);
 }
 
 
 void FieldProps::handle_double_keyword(Section section, const DeckKeyword& keyword, const Box& box) {
     auto& field_data = this->init_get<double>(keyword.name());
     const auto& deck_data = keyword.getSIDoubleData();
-    const auto& deck_status = keyword.getValueStatus();
+    const auto& deck_item = keyword.getDataRecord().getDataItem();
 
     if (section == Section::EDIT && keywords::multiplier_keywords.count(keyword.name()) == 1)
-        multiply_deck(keyword, field_data, deck_data, deck_status, box);
+        multiply_deck(keyword, field_data, deck_data, deck_item, box);
     else
-        assign_deck(keyword, field_data, deck_data, deck_status, box);
+        assign_deck(keyword, field_data, deck_data, deck_item, box);
 
 
     if (section == Section::GRID) {
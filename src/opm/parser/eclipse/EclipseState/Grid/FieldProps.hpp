@@ -44,12 +44,22 @@ public:
         std::string region_name;
 
 
+        MultregpRecord() = default;
+
         MultregpRecord(int rv, double m, const std::string& rn) :
             region_value(rv),
             multiplier(m),
             region_name(rn)
         {}
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(region_value);
+            serializer(multiplier);
+            serializer(region_name);
+        }
+
     };
 
     enum class ScalarOperation {
@@ -159,6 +169,14 @@ public:
             this->value_status[index] = status;
         }
 
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(data);
+            serializer(value_status);
+            serializer(all_set);
+        }
+
     };
 
 
@@ -215,6 +233,31 @@ public:
 
 
     FieldProps(const Deck& deck, const Phases& phases, const EclipseGrid& grid, const TableManager& table_arg);
+
+    /*
+      An empty container which refers to grid and tables, the content is
+      filled in by serializeOp() when unpacking.
+    */
+    FieldProps(const EclipseGrid& grid, const TableManager& table_arg);
+
+    template<class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(active_size);
+        serializer(global_size);
+        serializer(unit_system);
+        serializer(nx);
+        serializer(ny);
+        serializer(nz);
+        m_phases.serializeOp(serializer);
+        serializer(m_actnum);
+        serializer(cell_volume);
+        serializer(cell_depth);
+        serializer(m_default_region);
+        serializer(multregp);
+        serializer(int_data);
+        serializer(double_data);
+    }
     void reset_actnum(const std::vector<int>& actnum);
 
     const std::string& default_region() const;
@@ -353,13 +396,13 @@ private:
     void init_tempi(FieldData<double>& tempi);
     void subtract_swl(FieldProps::FieldData<double>& sogcr, const std::string& swl_kw);
 
-    const UnitSystem unit_system;
+    UnitSystem unit_system;
     std::size_t nx,ny,nz;
     Phases m_phases;
     std::vector<int> m_actnum;
     std::vector<double> cell_volume;
     std::vector<double> cell_depth;
-    const std::string m_default_region;
+    std::string m_default_region;
     const EclipseGrid * grid_ptr;      // A bit undecided whether to properly use the grid or not ...
     const TableManager& tables;
     std::vector<MultregpRecord> multregp;
@@ -21,6 +21,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FieldPropsManager.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
+#include <opm/parser/eclipse/EclipseState/Util/BinarySerializer.hpp>
 
 #include "FieldProps.hpp"
 
@@ -39,6 +40,16 @@ FieldPropsManager::MemInfo FieldPropsManager::meminfo( ) const {
     return FieldPropsManager::MemInfo(this->fp->global_size, this->fp->active_size, this->fp->num_int(), this->fp->num_double());
 }
 
+void FieldPropsManager::serialize(BinarySerializer& serializer, const EclipseGrid& grid, const TableManager& tables) {
+    bool has_value = static_cast<bool>(this->fp);
+    serializer(has_value);
+    if (!serializer.isSerializing())
+        this->fp = has_value ? std::make_shared<FieldProps>(grid, tables) : nullptr;
+
+    if (has_value)
+        this->fp->serializeOp(serializer);
+}
+
 template <typename T>
 const std::vector<T>& FieldPropsManager::get(const std::string& keyword) const {
     return this->fp->get<T>(keyword);
@@ -23,6 +23,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/MSW/Valve.hpp>
 
 #include <cassert>
+#include <stdexcept>
 
 namespace Opm {
 namespace {
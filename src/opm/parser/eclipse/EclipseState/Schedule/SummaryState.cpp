@@ -17,7 +17,10 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <cstring>
 #include <ctime>
 #include <iostream>
@@ -51,10 +54,37 @@ namespace {
             return is_total(key.substr(0,sep_pos));
     }
 
+    std::size_t next_layout() {
+        static std::atomic<std::size_t> layout{0};
+        return ++layout;
+    }
+
 }
 
+    SummaryState::const_iterator::const_iterator(const SummaryState* st_arg, Handle pos_arg) :
+        st(st_arg),
+        pos(pos_arg)
+    {
+        while (this->pos < this->st->m_keys.size() &&
+               (!this->st->has(this->pos) || this->st->m_general[this->pos] != invalid_handle))
+            this->pos++;
+    }
+
+
+    SummaryState::const_iterator::value_type SummaryState::const_iterator::operator*() const {
+        return { this->st->m_keys[this->pos], this->st->m_values[this->pos] };
+    }
+
+
+    SummaryState::const_iterator& SummaryState::const_iterator::operator++() {
+        *this = const_iterator(this->st, this->pos + 1);
+        return *this;
+    }
+
+
     SummaryState::SummaryState(std::chrono::system_clock::time_point sim_start_arg):
-        sim_start(sim_start_arg)
+        sim_start(sim_start_arg),
+        m_layout(next_layout())
     {
         this->update_elapsed(0);
     }
@@ -80,55 +110,124 @@ namespace {
     }
 
 
-    void SummaryState::update(const std::string& key, double value) {
-        if (is_total(key))
-            this->values[key] += value;
+    SummaryState::Handle SummaryState::add_slot(const std::string& key, Handle general) {
+        const Handle handle = this->m_keys.size();
+        this->m_keys.push_back(key);
+        this->m_values.push_back(0);
+        this->m_defined.push_back(0);
+        this->m_total.push_back(is_total(key));
+        this->m_general.push_back(general);
+
+        // New slot, the handles no longer match those of copies.
+        this->m_layout = next_layout();
+        return handle;
+    }
+
+
+    SummaryState::Handle SummaryState::handle(const std::string& key) {
+        const auto iter = this->m_index.find(key);
+        if (iter != this->m_index.end())
+            return iter->second;
+
+        const Handle handle = this->add_slot(key, invalid_handle);
+        this->m_index.emplace(key, handle);
+        return handle;
+    }
+
+
+    SummaryState::Handle SummaryState::find_handle(const std::string& key) const {
+        const auto iter = this->m_index.find(key);
+        if (iter == this->m_index.end())
+            return invalid_handle;
+
+        return iter->second;
+    }
+
+
+    // The well and group variables have slots of their own, an update also
+    // applies to the slot of the general key "var:name".
+    SummaryState::Handle SummaryState::var_handle(VarMap& var_map, const std::string& name, const std::string& var) {
+        auto& handles = var_map[var];
+        const auto iter = handles.find(name);
+        if (iter != handles.end())
+            return iter->second;
+
+        const auto key = var + ":" + name;
+        const Handle handle = this->add_slot(key, this->handle(key));
+        handles.emplace(name, handle);
+        return handle;
+    }
+
+
+    SummaryState::Handle SummaryState::well_handle(const std::string& well, const std::string& var) {
+        return this->var_handle(this->well_values, well, var);
+    }
+
+
+    SummaryState::Handle SummaryState::group_handle(const std::string& group, const std::string& var) {
+        return this->var_handle(this->group_values, group, var);
+    }
+
+
+    void SummaryState::define(Handle handle) {
+        if (!this->m_defined[handle]) {
+            this->m_defined[handle] = 1;
+            if (this->m_general[handle] == invalid_handle)
+                this->m_size++;
+        }
+    }
+
+
+    void SummaryState::update(Handle handle, double value) {
+        this->define(handle);
+        if (this->m_total[handle])
+            this->m_values[handle] += value;
         else
-            this->values[key] = value;
+            this->m_values[handle] = value;
+
+        const auto general = this->m_general[handle];
+        if (general != invalid_handle)
+            this->update(general, value);
+    }
+
+
+    void SummaryState::set(Handle handle, double value) {
+        this->define(handle);
+        this->m_values[handle] = value;
+    }
+
+
+    void SummaryState::update(const std::string& key, double value) {
+        this->update(this->handle(key), value);
     }
 
 
     void SummaryState::update_group_var(const std::string& group, const std::string& var, double value) {
-        std::string key = var + ":" + group;
-        if (is_total(var)) {
-            this->values[key] += value;
-            this->group_values[var][group] += value;
-        } else {
-            this->values[key] = value;
-            this->group_values[var][group] = value;
-        }
-        this->m_groups.insert(group);
+        this->update(this->group_handle(group, var), value);
     }
 
     void SummaryState::update_well_var(const std::string& well, const std::string& var, double value) {
-        std::string key = var + ":" + well;
-        if (is_total(var)) {
-            this->values[key] += value;
-            this->well_values[var][well] += value;
-        } else {
-            this->values[key] = value;
-            this->well_values[var][well] = value;
-        }
-        this->m_wells.insert(well);
+        this->update(this->well_handle(well, var), value);
     }
 
 
     void SummaryState::set(const std::string& key, double value) {
-        this->values[key] = value;
+        this->set(this->handle(key), value);
     }
 
 
     bool SummaryState::has(const std::string& key) const {
-        return (this->values.find(key) != this->values.end());
+        const auto handle = this->find_handle(key);
+        return (handle != invalid_handle) && this->has(handle);
     }
 
 
     double SummaryState::get(const std::string& key) const {
-        const auto iter = this->values.find(key);
-        if (iter == this->values.end())
+        const auto handle = this->find_handle(key);
+        if (handle == invalid_handle || !this->has(handle))
             throw std::out_of_range("No such key: " + key);
 
-        return iter->second;
+        return this->get(handle);
     }
 
     bool SummaryState::has_well_var(const std::string& well, const std::string& var) const {
@@ -140,11 +239,15 @@ namespace {
         if (well_iter == var_iter->second.end())
             return false;
 
-        return true;
+        return this->has(well_iter->second);
     }
 
     double SummaryState::get_well_var(const std::string& well, const std::string& var) const {
-        return this->well_values.at(var).at(well);
+        const auto handle = this->well_values.at(var).at(well);
+        if (!this->has(handle))
+            throw std::out_of_range("No such well variable: " + var + ":" + well);
+
+        return this->get(handle);
     }
 
     bool SummaryState::has_group_var(const std::string& group, const std::string& var) const {
@@ -156,62 +259,78 @@ namespace {
         if (group_iter == var_iter->second.end())
             return false;
 
-        return true;
+        return this->has(group_iter->second);
     }
 
     double SummaryState::get_group_var(const std::string& group, const std::string& var) const {
-        return this->group_values.at(var).at(group);
+        const auto handle = this->group_values.at(var).at(group);
+        if (!this->has(handle))
+            throw std::out_of_range("No such group variable: " + var + ":" + group);
+
+        return this->get(handle);
     }
 
     SummaryState::const_iterator SummaryState::begin() const {
-        return this->values.begin();
+        return const_iterator(this, 0);
     }
 
 
     SummaryState::const_iterator SummaryState::end() const {
-        return this->values.end();
+        return const_iterator(this, this->m_keys.size());
     }
 
 
-    std::vector<std::string> SummaryState::wells(const std::string& var) const {
-        const auto& var_iter = this->well_values.find(var);
-        if (var_iter == this->well_values.end())
+    std::vector<std::string> SummaryState::names(const VarMap& var_map, const std::string& var) const {
+        const auto& var_iter = var_map.find(var);
+        if (var_iter == var_map.end())
             return {};
 
-        std::vector<std::string> wells;
-        for (const auto& pair : var_iter->second)
-            wells.push_back(pair.first);
-        return wells;
+        std::vector<std::string> names;
+        for (const auto& pair : var_iter->second) {
+            if (this->has(pair.second))
+                names.push_back(pair.first);
+        }
+        return names;
+    }
+
+
+    std::vector<std::string> SummaryState::names(const VarMap& var_map) const {
+        std::unordered_set<std::string> names;
+        for (const auto& var_pair : var_map) {
+            for (const auto& pair : var_pair.second) {
+                if (this->has(pair.second))
+                    names.insert(pair.first);
+            }
+        }
+        return std::vector<std::string>(names.begin(), names.end());
+    }
+
+
+    std::vector<std::string> SummaryState::wells(const std::string& var) const {
+        return this->names(this->well_values, var);
     }
 
 
     std::vector<std::string> SummaryState::wells() const {
-        return std::vector<std::string>(this->m_wells.begin(), this->m_wells.end());
+        return this->names(this->well_values);
     }
 
 
     std::vector<std::string> SummaryState::groups(const std::string& var) const {
-        const auto& var_iter = this->group_values.find(var);
-        if (var_iter == this->group_values.end())
-            return {};
-
-        std::vector<std::string> groups;
-        for (const auto& pair : var_iter->second)
-            groups.push_back(pair.first);
-        return groups;
+        return this->names(this->group_values, var);
     }
 
 
     std::vector<std::string> SummaryState::groups() const {
-        return std::vector<std::string>(this->m_groups.begin(), this->m_groups.end());
+        return this->names(this->group_values);
     }
 
     std::size_t SummaryState::num_wells() const {
-        return this->m_wells.size();
+        return this->wells().size();
     }
 
     std::size_t SummaryState::size() const {
-        return this->values.size();
+        return this->m_size;
     }
 
 
@@ -264,43 +383,44 @@ namespace {
         return {std::addressof(this->buffer[this->pos - length]), length};
     }
 
-    void put_map(Serializer& ser, const std::unordered_map<std::string, double>& values) {
-        ser.put(values.size());
-        for (const auto& value_pair : values) {
-            ser.put(value_pair.first);
-            ser.put(value_pair.second);
-        }
-    }
-
 }
 
     std::vector<char> SummaryState::serialize() const {
         Serializer ser;
         ser.put(this->elapsed);
-        put_map(ser, values);
 
-        ser.put(this->well_values.size());
-        for (const auto& well_var_pair : this->well_values) {
-            ser.put(well_var_pair.first);
-            put_map(ser, well_var_pair.second);
+        ser.put(this->size());
+        for (const auto& value_pair : *this) {
+            ser.put(value_pair.first);
+            ser.put(value_pair.second);
         }
 
-        ser.put(this->group_values.size());
-        for (const auto& group_var_pair : this->group_values) {
-            ser.put(group_var_pair.first);
-            put_map(ser, group_var_pair.second);
-        }
+        const auto put_vars = [this, &ser](const VarMap& var_map) {
+            ser.put(var_map.size());
+            for (const auto& var_pair : var_map) {
+                ser.put(var_pair.first);
+                ser.put(this->names(var_map, var_pair.first).size());
+                for (const auto& pair : var_pair.second) {
+                    if (this->has(pair.second)) {
+                        ser.put(pair.first);
+                        ser.put(this->get(pair.second));
+                    }
+                }
+            }
+        };
+
+        put_vars(this->well_values);
+        put_vars(this->group_values);
 
         return std::move(ser.buffer);
     }
 
 
     void  SummaryState::deserialize(const std::vector<char>& buffer) {
-        this->values.clear();
-        this->m_wells.clear();
-        this->well_values.clear();
-        this->m_groups.clear();
-        this->group_values.clear();
+        // Registered keys are retained so that handles stay valid.
+        std::fill(this->m_values.begin(), this->m_values.end(), 0.0);
+        std::fill(this->m_defined.begin(), this->m_defined.end(), 0);
+        this->m_size = 0;
         this->elapsed = 0;
 
         Serializer ser(buffer);
@@ -310,7 +430,7 @@ namespace {
             for (std::size_t index = 0; index < num_values; index++) {
                 std::string key = ser.get<std::string>();
                 double value = ser.get<double>();
-                this->update(key, value);
+                this->set(this->handle(key), value);
             }
         }
 
@@ -323,7 +443,7 @@ namespace {
                 for (std::size_t well_index=0; well_index < num_well; well_index++) {
                     std::string well = ser.get<std::string>();
                     double value = ser.get<double>();
-                    this->update_well_var(well, var, value);
+                    this->set(this->well_handle(well, var), value);
                 }
             }
         }
@@ -337,7 +457,7 @@ namespace {
                 for (std::size_t group_index=0; group_index < num_group; group_index++) {
                     std::string group = ser.get<std::string>();
                     double value = ser.get<double>();
-                    this->update_group_var(group, var, value);
+                    this->set(this->group_handle(group, var), value);
                 }
             }
         }
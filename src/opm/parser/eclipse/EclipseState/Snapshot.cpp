@@ -0,0 +1,149 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/FileSystem.hpp>
+
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Action/ASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/SpiralICD.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/Valve.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQActive.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WList.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WListManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Snapshot.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Util/BinarySerializer.hpp>
+
+namespace Opm {
+namespace Snapshot {
+
+namespace {
+
+const char magic[8] = { 'O', 'P', 'M', 'S', 'N', 'A', 'P', '1' };
+
+// written as a number, reads back differently on a machine with another byte order
+const std::uint32_t byteOrderMark = 0x01020304;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t payload_size;
+};
+
+}
+
+
+void save(const std::string& fileName,
+          const EclipseState& es,
+          const Schedule& schedule,
+          const SummaryConfig& summary_config)
+{
+    BinarySerializer packer;
+    packer.pack(es);
+    packer.pack(schedule);
+    packer.pack(summary_config);
+    const auto& payload = packer.buffer();
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof magic);
+    header.version = formatVersion;
+    header.byte_order = byteOrderMark;
+    header.payload_size = payload.size();
+
+    const auto tmpFile = fileName + unique_path(".%%%%-%%%%.tmp");
+    try {
+        std::ofstream stream(tmpFile, std::ios::binary);
+        if (!stream)
+            throw std::runtime_error("Could not open snapshot file: " + fileName + " for writing");
+
+        stream.write(header.magic, sizeof header.magic);
+        stream.write(reinterpret_cast<const char*>(&header.version), sizeof header.version);
+        stream.write(reinterpret_cast<const char*>(&header.byte_order), sizeof header.byte_order);
+        stream.write(reinterpret_cast<const char*>(&header.payload_size), sizeof header.payload_size);
+        stream.write(payload.data(), payload.size());
+        stream.close();
+        if (!stream)
+            throw std::runtime_error("Writing snapshot file: " + fileName + " failed");
+
+        Opm::filesystem::rename(tmpFile, fileName);
+    } catch (...) {
+        std::error_code ec;
+        Opm::filesystem::remove(tmpFile, ec);
+        throw;
+    }
+}
+
+
+void load(const std::string& fileName,
+          EclipseState& es,
+          Schedule& schedule,
+          SummaryConfig& summary_config)
+{
+    std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+    if (!stream)
+        throw std::invalid_argument("Could not open snapshot file: " + fileName);
+
+    const auto fileSize = static_cast<std::uint64_t>(stream.tellg());
+    stream.seekg(0);
+
+    Header header;
+    stream.read(header.magic, sizeof header.magic);
+    stream.read(reinterpret_cast<char*>(&header.version), sizeof header.version);
+    stream.read(reinterpret_cast<char*>(&header.byte_order), sizeof header.byte_order);
+    stream.read(reinterpret_cast<char*>(&header.payload_size), sizeof header.payload_size);
+    if (!stream || std::memcmp(header.magic, magic, sizeof magic) != 0)
+        throw std::runtime_error("The file: " + fileName + " is not a snapshot file");
+
+    if (header.version != formatVersion)
+        throw std::runtime_error("The snapshot file: " + fileName + " has an unsupported format version");
+
+    if (header.byte_order != byteOrderMark)
+        throw std::runtime_error("The snapshot file: " + fileName + " was written on a machine with a different byte order");
+
+    if (header.payload_size != fileSize - sizeof header.magic - sizeof header.version
+                                         - sizeof header.byte_order - sizeof header.payload_size)
+        throw std::runtime_error("The snapshot file: " + fileName + " has the wrong size");
+
+    std::vector<char> payload(header.payload_size);
+    if (!stream.read(payload.data(), payload.size()))
+        throw std::runtime_error("Reading snapshot file: " + fileName + " failed");
+
+    BinarySerializer unpacker(std::move(payload));
+    unpacker.unpack(es);
+    unpacker.unpack(schedule);
+    unpacker.unpack(summary_config);
+    if (!unpacker.done())
+        throw std::runtime_error("The snapshot file: " + fileName + " has trailing data");
+
+    OpmLog::info("Loaded EclipseState, Schedule and SummaryConfig from snapshot file: " + fileName);
+}
+
+}
+}
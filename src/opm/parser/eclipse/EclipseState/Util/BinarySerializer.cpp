@@ -0,0 +1,105 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/parser/eclipse/EclipseState/Util/BinarySerializer.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+namespace Opm {
+
+void BinarySerializer::operator()(const std::string& data) {
+    auto& value = const_cast<std::string&>(data);
+    auto size = this->containerSize(value.size());
+    if (!this->m_packing)
+        value.resize(size);
+
+    this->bytes(&value[0], size);
+}
+
+
+/*
+  The UnitSystem points into static conversion tables, and the Deck keeps an
+  index of its keywords; both are rebuilt through their constructors when
+  unpacking.
+*/
+void BinarySerializer::operator()(const UnitSystem& data) {
+    std::string name = data.getName();
+    auto type = data.getType();
+    std::map<std::string, Dimension> dimensions = data.getDimensions();
+    std::size_t use_count = data.use_count();
+
+    (*this)(name);
+    (*this)(type);
+    this->map(dimensions);
+    (*this)(use_count);
+
+    if (!this->m_packing)
+        const_cast<UnitSystem&>(data) = UnitSystem(name, type, dimensions, use_count);
+}
+
+
+void BinarySerializer::operator()(const Deck& data) {
+    if (this->m_packing) {
+        (*this)(data.keywords());
+        (*this)(data.getDefaultUnitSystem());
+        (*this)(data.activeUnitSystem());
+        (*this)(data.getDataFile());
+        (*this)(data.getInputPath());
+        (*this)(data.unitSystemAccessCount());
+    } else {
+        std::vector<DeckKeyword> keywords;
+        UnitSystem defaultUnits;
+        std::unique_ptr<UnitSystem> activeUnits;
+        std::string dataFile;
+        std::string inputPath;
+        std::size_t accessCount;
+
+        (*this)(keywords);
+        (*this)(defaultUnits);
+        (*this)(activeUnits);
+        (*this)(dataFile);
+        (*this)(inputPath);
+        (*this)(accessCount);
+
+        const_cast<Deck&>(data) = Deck(std::move(keywords), defaultUnits, activeUnits.get(),
+                                       dataFile, inputPath, accessCount);
+    }
+}
+
+
+/*
+  The serializeOp() hook of the EclipseState leaves out the input grid and
+  the field properties, which are distributed otherwise when the state is
+  broadcast with MPI. A snapshot needs them; the unpacked field properties
+  refer to the grid and tables of the unpacked EclipseState.
+*/
+void BinarySerializer::operator()(const EclipseState& data) {
+    auto& es = const_cast<EclipseState&>(data);
+    es.serializeOp(*this);
+    (*this)(es.m_inputGrid);
+    es.field_props.serialize(*this, es.m_inputGrid, es.m_tables);
+}
+
+}
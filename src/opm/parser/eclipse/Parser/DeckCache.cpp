@@ -0,0 +1,491 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <opm/common/OpmLog/Location.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/common/utility/FileSystem.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Deck/UDAValue.hpp>
+#include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+#include "DeckCache.hpp"
+
+namespace Opm {
+namespace DeckCache {
+
+namespace {
+
+const char magic[8] = { 'O', 'P', 'M', 'D', 'E', 'C', 'K', '1' };
+const std::uint32_t formatVersion = 1;
+
+
+class CacheWriter {
+public:
+    explicit CacheWriter(const std::string& fileName) :
+        stream(fileName, std::ios::binary)
+    {
+        if (!stream)
+            throw std::runtime_error("Could not open deck cache file: " + fileName + " for writing");
+    }
+
+    void write(const void* data, std::size_t size) {
+        this->stream.write(static_cast<const char*>(data), size);
+    }
+
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values are written as bytes");
+        this->write(&value, sizeof value);
+    }
+
+    void put(const std::string& value) {
+        this->put<std::uint64_t>(value.size());
+        this->write(value.data(), value.size());
+    }
+
+    template <typename T>
+    void put(const std::vector<T>& values) {
+        this->put<std::uint64_t>(values.size());
+        this->write(values.data(), values.size() * sizeof(T));
+    }
+
+    void put(const std::vector<std::string>& values) {
+        this->put<std::uint64_t>(values.size());
+        for (const auto& value : values)
+            this->put(value);
+    }
+
+    void put(const Dimension& dim) {
+        this->put(dim.getSIScalingRaw());
+        this->put(dim.getSIOffset());
+    }
+
+    void close() {
+        this->stream.close();
+        if (!this->stream)
+            throw std::runtime_error("Writing deck cache file failed");
+    }
+
+private:
+    std::ofstream stream;
+};
+
+
+class CacheReader {
+public:
+    explicit CacheReader(const std::string& fileName) :
+        stream(fileName, std::ios::binary | std::ios::ate)
+    {
+        if (!stream)
+            throw std::invalid_argument("Could not open deck cache file: " + fileName);
+
+        this->remaining = static_cast<std::size_t>(this->stream.tellg());
+        this->stream.seekg(0);
+    }
+
+    void read(void* data, std::size_t size) {
+        if (size > this->remaining)
+            throw std::runtime_error("Deck cache file is truncated");
+
+        this->stream.read(static_cast<char*>(data), size);
+        if (!this->stream)
+            throw std::runtime_error("Reading deck cache file failed");
+
+        this->remaining -= size;
+    }
+
+    template <typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values are read as bytes");
+        T value;
+        this->read(&value, sizeof value);
+        return value;
+    }
+
+    // the size of an array, checked against what is left of the file
+    std::size_t count(std::size_t elementSize) {
+        auto n = this->get<std::uint64_t>();
+        if (elementSize > 0 && n > this->remaining / elementSize)
+            throw std::runtime_error("Deck cache file is truncated");
+
+        return static_cast<std::size_t>(n);
+    }
+
+    std::string string() {
+        std::string value(this->count(1), '\0');
+        this->read(&value[0], value.size());
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> vector() {
+        std::vector<T> values(this->count(sizeof(T)));
+        this->read(values.data(), values.size() * sizeof(T));
+        return values;
+    }
+
+    std::vector<std::string> strings() {
+        std::vector<std::string> values(this->count(sizeof(std::uint64_t)));
+        for (auto& value : values)
+            value = this->string();
+        return values;
+    }
+
+    Dimension dimension() {
+        double factor = this->get<double>();
+        double offset = this->get<double>();
+        return Dimension(factor, offset);
+    }
+
+    bool done() const {
+        return this->remaining == 0;
+    }
+
+private:
+    std::ifstream stream;
+    std::size_t remaining;
+};
+
+
+/*
+  The status of the values is recovered through the public accessors of the
+  item, and written as runs - large arrays are usually a single run.
+*/
+value::status itemStatus(const DeckItem& item, std::size_t index) {
+    if (item.defaultApplied(index))
+        return item.hasValue(index) ? value::status::valid_default : value::status::empty_default;
+
+    return item.hasValue(index) ? value::status::deck_value : value::status::uninitialized;
+}
+
+
+void writeDimensions(CacheWriter& writer, const std::vector<Dimension>& dims) {
+    writer.put<std::uint64_t>(dims.size());
+    for (const auto& dim : dims)
+        writer.put(dim);
+}
+
+std::vector<Dimension> readDimensions(CacheReader& reader) {
+    std::vector<Dimension> dims(reader.count(2 * sizeof(double)));
+    for (auto& dim : dims)
+        dim = reader.dimension();
+    return dims;
+}
+
+
+void writeItem(CacheWriter& writer, const DeckItem& item) {
+    writer.put(item.name());
+    writer.put(item.getType());
+    writer.put(item.rawData());
+
+    std::vector<std::uint64_t> ends;
+    std::vector<value::status> runs;
+    for (std::size_t index = 0; index < item.data_size(); index++) {
+        auto st = itemStatus(item, index);
+        if (runs.empty() || runs.back() != st) {
+            ends.push_back(index + 1);
+            runs.push_back(st);
+        } else
+            ends.back() = index + 1;
+    }
+    writer.put(ends);
+    writer.put(runs);
+
+    writer.put(item.dVal());
+    writer.put(item.iVal());
+    writer.put(item.sVal());
+
+    const auto& udas = item.uVal();
+    writer.put<std::uint64_t>(udas.size());
+    for (const auto& uda : udas) {
+        writer.put(uda.is<double>());
+        if (uda.is<double>())
+            writer.put(uda.get<double>());
+        else
+            writer.put(uda.get<std::string>());
+        writer.put(uda.get_dim());
+    }
+
+    writeDimensions(writer, item.activeDimensions());
+    writeDimensions(writer, item.defaultDimensions());
+}
+
+DeckItem readItem(CacheReader& reader) {
+    auto name = reader.string();
+    auto type = reader.get<type_tag>();
+    auto rawData = reader.get<bool>();
+
+    auto ends = reader.vector<std::uint64_t>();
+    auto runs = reader.vector<value::status>();
+    if (ends.size() != runs.size())
+        throw std::runtime_error("Deck cache file is corrupt");
+
+    std::vector<value::status> status;
+    if (!ends.empty())
+        status.reserve(ends.back());
+    for (std::size_t run = 0; run < runs.size(); run++) {
+        if (ends[run] < status.size())
+            throw std::runtime_error("Deck cache file is corrupt");
+        status.resize(ends[run], runs[run]);
+    }
+
+    auto dval = reader.vector<double>();
+    auto ival = reader.vector<int>();
+    auto sval = reader.strings();
+
+    std::vector<UDAValue> uval(reader.count(sizeof(bool)));
+    for (auto& uda : uval) {
+        if (reader.get<bool>()) {
+            double value = reader.get<double>();
+            uda = UDAValue(value, reader.dimension());
+        } else {
+            auto value = reader.string();
+            uda = UDAValue(value, reader.dimension());
+        }
+    }
+
+    auto activeDims = readDimensions(reader);
+    auto defaultDims = readDimensions(reader);
+
+    return DeckItem(std::move(dval), std::move(ival), std::move(sval), std::move(uval),
+                    type, name, status, rawData, activeDims, defaultDims);
+}
+
+
+void writeKeyword(CacheWriter& writer, const DeckKeyword& keyword) {
+    writer.put(keyword.name());
+    writer.put(keyword.location().filename);
+    writer.put<std::uint64_t>(keyword.location().lineno);
+    writer.put(keyword.isDataKeyword());
+    writer.put(keyword.isSlashTerminated());
+    writer.put(keyword.isDoubleRecordKeyword());
+
+    writer.put<std::uint64_t>(keyword.size());
+    for (const auto& record : keyword) {
+        writer.put<std::uint64_t>(record.size());
+        for (const auto& item : record)
+            writeItem(writer, item);
+    }
+}
+
+DeckKeyword readKeyword(CacheReader& reader) {
+    auto name = reader.string();
+    auto filename = reader.string();
+    auto lineno = reader.get<std::uint64_t>();
+
+    DeckKeyword keyword(Location(filename, lineno), name);
+    keyword.setDataKeyword(reader.get<bool>());
+    if (!reader.get<bool>())
+        keyword.setFixedSize();
+    keyword.setDoubleRecordKeyword(reader.get<bool>());
+
+    auto numRecords = reader.count(sizeof(std::uint64_t));
+    for (std::size_t r = 0; r < numRecords; r++) {
+        auto numItems = reader.count(sizeof(std::uint64_t));
+        std::vector<DeckItem> items;
+        items.reserve(numItems);
+        for (std::size_t i = 0; i < numItems; i++)
+            items.push_back(readItem(reader));
+
+        keyword.addRecord(DeckRecord(std::move(items)));
+    }
+
+    return keyword;
+}
+
+
+void writeUnitSystem(CacheWriter& writer, const UnitSystem& units) {
+    writer.put(units.getName());
+    writer.put(units.getType());
+    writer.put<std::uint64_t>(units.use_count());
+
+    const auto& dims = units.getDimensions();
+    writer.put<std::uint64_t>(dims.size());
+    for (const auto& pair : dims) {
+        writer.put(pair.first);
+        writer.put(pair.second);
+    }
+}
+
+UnitSystem readUnitSystem(CacheReader& reader) {
+    auto name = reader.string();
+    auto type = reader.get<UnitSystem::UnitType>();
+    auto use_count = reader.get<std::uint64_t>();
+
+    std::map<std::string, Dimension> dims;
+    auto numDims = reader.count(sizeof(std::uint64_t));
+    for (std::size_t d = 0; d < numDims; d++) {
+        auto dimName = reader.string();
+        dims.emplace(dimName, reader.dimension());
+    }
+
+    return UnitSystem(name, type, dims, use_count);
+}
+
+
+std::uint64_t fileHash(const std::string& fileName, std::uint64_t& size) {
+    std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+    if (!stream)
+        throw std::invalid_argument("Could not open deck source file: " + fileName);
+
+    std::string buffer(static_cast<std::size_t>(stream.tellg()), '\0');
+    stream.seekg(0);
+    if (!stream.read(&buffer[0], buffer.size()))
+        throw std::runtime_error("Could not read deck source file: " + fileName);
+
+    size = buffer.size();
+    return hash(buffer);
+}
+
+}
+
+
+std::uint64_t hash(const char* data, std::size_t size, std::uint64_t seed) {
+    const std::uint64_t prime = 1099511628211ULL;
+    auto h = seed;
+    for (std::size_t i = 0; i < size; i++) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= prime;
+    }
+    return h;
+}
+
+std::uint64_t hash(const std::string& data, std::uint64_t seed) {
+    return hash(data.data(), data.size(), seed);
+}
+
+
+std::string fileName(const std::string& cacheDir, const std::string& dataFile) {
+    auto dataPath = Opm::filesystem::canonical(dataFile);
+
+    std::stringstream ss;
+    ss << dataPath.stem().string() << '-'
+       << std::hex << std::setw(16) << std::setfill('0') << hash(dataPath.string())
+       << ".DECKCACHE";
+
+    return (Opm::filesystem::path(cacheDir) / ss.str()).string();
+}
+
+
+Deck load(const std::string& cacheFile, std::uint64_t key) {
+    CacheReader reader(cacheFile);
+
+    char fileMagic[sizeof magic];
+    reader.read(fileMagic, sizeof fileMagic);
+    if (std::memcmp(fileMagic, magic, sizeof magic) != 0)
+        throw std::runtime_error("The file: " + cacheFile + " is not a deck cache file");
+
+    if (reader.get<std::uint32_t>() != formatVersion)
+        throw std::runtime_error("The deck cache file: " + cacheFile + " has an unsupported format version");
+
+    if (reader.get<std::uint64_t>() != key)
+        throw std::runtime_error("The deck cache file: " + cacheFile + " was written with different parser settings");
+
+    auto numSources = reader.count(3 * sizeof(std::uint64_t));
+    for (std::size_t s = 0; s < numSources; s++) {
+        auto path = reader.string();
+        auto size = reader.get<std::uint64_t>();
+        auto sourceHash = reader.get<std::uint64_t>();
+
+        std::uint64_t currentSize;
+        auto currentHash = fileHash(path, currentSize);
+        if (currentSize != size || currentHash != sourceHash)
+            throw std::runtime_error("The input file: " + path + " has changed since the deck cache was written");
+    }
+
+    auto defaultUnits = readUnitSystem(reader);
+    std::unique_ptr<UnitSystem> activeUnits;
+    if (reader.get<bool>())
+        activeUnits.reset(new UnitSystem(readUnitSystem(reader)));
+
+    auto dataFile = reader.string();
+    auto inputPath = reader.string();
+    auto accessCount = reader.get<std::uint64_t>();
+
+    std::vector<DeckKeyword> keywords(reader.count(sizeof(std::uint64_t)));
+    for (auto& keyword : keywords)
+        keyword = readKeyword(reader);
+
+    if (!reader.done())
+        throw std::runtime_error("The deck cache file: " + cacheFile + " has trailing data");
+
+    OpmLog::info("Loaded deck from cache file: " + cacheFile);
+    return Deck(std::move(keywords), defaultUnits, activeUnits.get(), dataFile, inputPath, accessCount);
+}
+
+
+void save(const std::string& cacheFile, std::uint64_t key,
+          const std::vector<Source>& sources, const Deck& deck)
+{
+    const auto cacheDir = Opm::filesystem::path(cacheFile).parent_path();
+    if (!cacheDir.empty())
+        Opm::filesystem::create_directories(cacheDir);
+
+    const auto tmpFile = cacheFile + unique_path(".%%%%-%%%%.tmp");
+    try {
+        CacheWriter writer(tmpFile);
+        writer.write(magic, sizeof magic);
+        writer.put(formatVersion);
+        writer.put(key);
+
+        writer.put<std::uint64_t>(sources.size());
+        for (const auto& source : sources) {
+            writer.put(source.path);
+            writer.put(source.size);
+            writer.put(source.hash);
+        }
+
+        writeUnitSystem(writer, deck.getDefaultUnitSystem());
+        const auto& activeUnits = deck.activeUnitSystem();
+        writer.put(static_cast<bool>(activeUnits));
+        if (activeUnits)
+            writeUnitSystem(writer, *activeUnits);
+
+        writer.put(deck.getDataFile());
+        writer.put(deck.getInputPath());
+        writer.put<std::uint64_t>(deck.unitSystemAccessCount());
+
+        writer.put<std::uint64_t>(deck.size());
+        for (const auto& keyword : deck)
+            writeKeyword(writer, keyword);
+
+        writer.close();
+        Opm::filesystem::rename(tmpFile, cacheFile);
+    } catch (...) {
+        std::error_code ec;
+        Opm::filesystem::remove(tmpFile, ec);
+        throw;
+    }
+}
+
+}
+}
@@ -0,0 +1,73 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_DECK_CACHE_HPP
+#define OPM_DECK_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+class Deck;
+
+/*
+  A deck cache file holds a parsed Deck, together with the input files it was
+  parsed from:
+
+    header:   magic "OPMDECK1" (8 bytes), format version (uint32),
+              parser key (uint64)
+    sources:  number of files, then for each file the canonical path,
+              the size and the content hash
+    deck:     the unit systems, the data file and input path, and the
+              keywords with their records and items
+
+  Numbers are written in native byte order, and arrays of numbers as one
+  block, so reading a cached deck costs little more than reading the file.
+  The cache is only valid on the machine which wrote it; any mismatch -
+  magic, version, parser key or the content of a source file - makes load()
+  throw, and the deck must be parsed again.
+*/
+
+namespace DeckCache {
+
+    struct Source {
+        std::string path;
+        std::uint64_t size;
+        std::uint64_t hash;
+    };
+
+    // FNV-1a hash of size bytes, continuing from seed
+    std::uint64_t hash(const char* data, std::size_t size, std::uint64_t seed = 14695981039346656037ULL);
+    std::uint64_t hash(const std::string& data, std::uint64_t seed = 14695981039346656037ULL);
+
+    // name of the cache file for dataFile in the directory cacheDir
+    std::string fileName(const std::string& cacheDir, const std::string& dataFile);
+
+    Deck load(const std::string& cacheFile, std::uint64_t key);
+
+    // write to a temporary file which is renamed to cacheFile when complete
+    void save(const std::string& cacheFile, std::uint64_t key,
+              const std::vector<Source>& sources, const Deck& deck);
+}
+}
+
+#endif
@@ -17,7 +17,12 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "config.h"
+
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iterator>
 #include <iomanip>
@@ -44,9 +49,11 @@
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
 #include <opm/parser/eclipse/Parser/ParserRecord.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
+#include "DeckCache.hpp"
 #include "raw/RawConsts.hpp"
 #include "raw/RawEnums.hpp"
 #include "raw/RawRecord.hpp"
@@ -328,7 +335,7 @@ void InputStack::push( std::string&& input, Opm::filesystem::path p ) {
 class ParserState {
     public:
         ParserState( const std::vector<std::pair<std::string,std::string>>&, const ParseContext&, ErrorGuard& );
-        ParserState( const std::vector<std::pair<std::string,std::string>>&, const ParseContext&, ErrorGuard&, Opm::filesystem::path );
+        ParserState( const std::vector<std::pair<std::string,std::string>>&, const ParseContext&, ErrorGuard&, Opm::filesystem::path, bool record_sources = false );
 
         void loadString( const std::string& );
         void loadFile( const Opm::filesystem::path& );
@@ -362,6 +369,35 @@ class ParserState {
         const ParseContext& parseContext;
         ErrorGuard& errors;
         bool unknown_keyword = false;
+
+        /*
+          Large data keywords are not converted when they are read. They get
+          a placeholder in the deck, and the raw keyword is queued here
+          together with the unit systems in effect at that point. The queue
+          is converted by parseDeferred(), in parallel, and the results
+          replace the placeholders.
+        */
+        struct DeferredKeyword {
+            std::size_t deckIndex;
+            std::unique_ptr<RawKeyword> rawKeyword;
+            const ParserKeyword* parserKeyword;
+            UnitSystem activeUnits;
+            UnitSystem defaultUnits;
+            std::string filename;
+        };
+
+        std::vector<DeferredKeyword> deferred;
+        std::size_t parallelThreshold = 0;
+
+        /*
+          When the deck is to be cached every file which is read is recorded
+          with its content hash. A missing include file or embedded Python
+          makes the result depend on more than these files, and the deck is
+          not cached.
+        */
+        bool recordSources = false;
+        bool cacheable = true;
+        std::vector<DeckCache::Source> sources;
 };
 
 const Opm::filesystem::path& ParserState::current_path() const {
@@ -420,12 +456,14 @@ ParserState::ParserState(const std::vector<std::pair<std::string, std::string>>&
 ParserState::ParserState( const std::vector<std::pair<std::string, std::string>>& code_keywords_arg,
                           const ParseContext& context,
                           ErrorGuard& errors_arg,
-                          Opm::filesystem::path p ) :
+                          Opm::filesystem::path p,
+                          bool record_sources ) :
     code_keywords(code_keywords_arg),
     rootPath( Opm::filesystem::canonical( p ).parent_path() ),
     python( PythonInstance() ),
     parseContext( context ),
-    errors( errors_arg )
+    errors( errors_arg ),
+    recordSources( record_sources )
 {
     openRootFile( p );
 }
@@ -441,6 +479,7 @@ void ParserState::loadFile(const Opm::filesystem::path& inputFile) {
         inputFileCanonical = Opm::filesystem::canonical(inputFile);
     } catch (const Opm::filesystem::filesystem_error& fs_error) {
         std::string msg = "Could not open file: " + inputFile.string();
+        this->cacheable = false;
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg, errors);
         return;
     }
@@ -455,6 +494,7 @@ void ParserState::loadFile(const Opm::filesystem::path& inputFile) {
     if( !ufp ) {
         std::string msg = "Could not read from file: " + inputFile.string();
 
+        this->cacheable = false;
         parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , msg, errors);
         return;
     }
@@ -476,6 +516,9 @@ void ParserState::loadFile(const Opm::filesystem::path& inputFile) {
         throw std::runtime_error( "Error when reading input file '"
                                 + inputFileCanonical.string() + "'" );
 
+    if (this->recordSources)
+        this->sources.push_back({ inputFileCanonical.string(), readc, DeckCache::hash( buffer.data(), readc ) });
+
     this->input_stack.push( str::clean( this->code_keywords, buffer ), inputFileCanonical );
 }
 
@@ -559,6 +602,141 @@ void ParserState::addPathAlias( const std::string& alias, const std::string& pat
 }
 
 
+std::invalid_argument keywordError(const RawKeyword& rawKeyword, const std::exception& exc) {
+    const auto& location = rawKeyword.location();
+    std::string msg = "\nFailed to parse keyword: " + rawKeyword.getKeywordName() + "\n" +
+                      "In file " + location.filename + ", line " +  std::to_string(location.lineno) + "\n\n" +
+                      "Error message: " + exc.what() + "\n";
+
+    return std::invalid_argument(msg);
+}
+
+
+// size of the input, without splitting the records into items
+std::size_t inputLength(const RawKeyword& rawKeyword) {
+    std::size_t length = 0;
+    for (const auto& record : rawKeyword)
+        length += record.length();
+
+    return length;
+}
+
+
+/*
+  Only data keywords (PORO, ZCORN, ...) are deferred; they do not affect
+  how the rest of the input is read and nothing during parsing looks at
+  their values.
+*/
+
+bool deferKeyword(const ParserState& parserState, const ParserKeyword& parserKeyword, const RawKeyword& rawKeyword) {
+    if (parserState.parallelThreshold == 0 || !parserKeyword.isDataKeyword())
+        return false;
+
+    return inputLength(rawKeyword) >= parserState.parallelThreshold;
+}
+
+
+void addDeferredKeyword(ParserState& parserState, const ParserKeyword& parserKeyword,
+                        std::unique_ptr<RawKeyword> rawKeyword, const std::string& filename) {
+    auto& deck = parserState.deck;
+    auto& active = deck.getActiveUnitSystem();
+    auto& dflt = deck.getDefaultUnitSystem();
+
+    // Register the dimensions in the deck's unit systems now, as the serial
+    // conversion would have done, so that the unit systems (and their use
+    // counts) end up the same.
+    for (const auto& record : parserKeyword) {
+        for (const auto& item : record) {
+            for (const auto& dim : item.dimensions()) {
+                active.getNewDimension(dim);
+                dflt.getNewDimension(dim);
+            }
+        }
+    }
+
+    DeckKeyword placeholder(rawKeyword->location(), rawKeyword->getKeywordName());
+    placeholder.setDataKeyword(parserKeyword.isDataKeyword());
+
+    const auto deckIndex = deck.size();
+    deck.addKeyword(std::move(placeholder));
+
+    parserState.deferred.push_back({ deckIndex, std::move(rawKeyword), &parserKeyword, active, dflt, filename });
+}
+
+
+/*
+  Convert the deferred keywords and put them in place in the deck. Each
+  keyword is first converted in parallel on a copy of the raw keyword, with
+  a ParseContext which ignores every input error. If that raises an
+  exception or records any error the keyword is converted again, in input
+  order, with the real ParseContext and ErrorGuard - so that the deck,
+  messages and exceptions are those of the serial parser. If
+  pendingKeyword is given, nothing is done unless one of the deferred
+  keywords has that name.
+*/
+
+void parseDeferred(ParserState& parserState, const std::string& pendingKeyword = "") {
+    auto deferred = std::move(parserState.deferred);
+    parserState.deferred.clear();
+
+    if (!pendingKeyword.empty()) {
+        const auto pending = std::any_of(deferred.begin(), deferred.end(),
+                                         [&pendingKeyword](const ParserState::DeferredKeyword& kw)
+                                         {
+                                             return kw.rawKeyword->getKeywordName() == pendingKeyword;
+                                         });
+        if (!pending) {
+            parserState.deferred = std::move(deferred);
+            return;
+        }
+    }
+
+    // not from the environment - errors must not be logged from the threads
+    ParseContext lenientContext;
+    lenientContext.update(InputError::IGNORE);
+
+    std::vector<std::unique_ptr<DeckKeyword>> parsed(deferred.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (long i = 0; i < static_cast<long>(deferred.size()); i++) {
+        auto& kw = deferred[i];
+
+        try {
+            ErrorGuard errors;
+            RawKeyword rawKeyword = *kw.rawKeyword;
+            UnitSystem active = kw.activeUnits;
+            UnitSystem dflt = kw.defaultUnits;
+
+            auto deckKeyword = kw.parserKeyword->parse(lenientContext, errors, rawKeyword,
+                                                       active, dflt, kw.filename);
+            if (errors.empty())
+                parsed[i] = std::make_unique<DeckKeyword>(std::move(deckKeyword));
+        } catch (...) {
+            // converted again below
+        }
+    }
+
+    for (std::size_t i = 0; i < deferred.size(); i++) {
+        auto& kw = deferred[i];
+
+        if (!parsed[i]) {
+            try {
+                parsed[i] = std::make_unique<DeckKeyword>(
+                    kw.parserKeyword->parse(parserState.parseContext, parserState.errors,
+                                            *kw.rawKeyword, kw.activeUnits, kw.defaultUnits,
+                                            kw.filename));
+            } catch (const std::exception& exc) {
+                throw keywordError(*kw.rawKeyword, exc);
+            }
+        }
+
+        parserState.deck.getKeyword(kw.deckIndex) = std::move(*parsed[i]);
+    }
+}
+
+
 RawKeyword * newRawKeyword(const ParserKeyword& parserKeyword, const std::string& keywordString, ParserState& parserState, const Parser& parser) {
     bool raw_string_keyword = parserKeyword.rawStringKeyword();
 
@@ -597,6 +775,8 @@ RawKeyword * newRawKeyword(const ParserKeyword& parserKeyword, const std::string
 
     const auto& keyword_size = parserKeyword.getKeywordSize();
     const auto& deck = parserState.deck;
+    parseDeferred(parserState, keyword_size.keyword);
+
     auto size_type = parserKeyword.isTableCollection() ? Raw::TABLE_COLLECTION : Raw::FIXED;
 
     if( deck.hasKeyword(keyword_size.keyword ) ) {
@@ -824,7 +1004,7 @@ std::unique_ptr<RawKeyword> tryParseKeyword( ParserState& parserState, const Par
 }
 
 
-bool parseState( ParserState& parserState, const Parser& parser ) {
+bool parseKeywords( ParserState& parserState, const Parser& parser ) {
     std::string filename = parserState.current_path().string();
 
     while( !parserState.done() ) {
@@ -871,8 +1051,15 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
                    << " in file " << location.filename << ", line " << std::to_string(location.lineno);
                 OpmLog::info(ss.str());
             }
+            if (deferKeyword(parserState, parserKeyword, *rawKeyword)) {
+                addDeferredKeyword(parserState, parserKeyword, std::move(rawKeyword), filename);
+                continue;
+            }
+
             try {
                 if (rawKeyword->getKeywordName() ==  Opm::RawConsts::pyinput) {
+                    parseDeferred(parserState);
+                    parserState.cacheable = false;
                     if (parserState.python) {
                         std::string python_string = rawKeyword->getFirstRecord().getRecordString();
                         parserState.python->exec(python_string, parser, parserState.deck);
@@ -893,12 +1080,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
                   error message; the parser is quite confused at this state and
                   we should not be tempted to continue the parsing.
                 */
-                const auto& location = rawKeyword->location();
-                std::string msg = "\nFailed to parse keyword: " + rawKeyword->getKeywordName() + "\n" +
-                                  "In file " + location.filename + ", line " +  std::to_string(location.lineno) + "\n\n" +
-                                  "Error message: " + exc.what() + "\n";
-
-                throw std::invalid_argument(msg);
+                throw keywordError(*rawKeyword, exc);
             }
         } else {
             const std::string msg = "The keyword " + rawKeyword->getKeywordName() + " is not recognized - ignored";
@@ -910,6 +1092,36 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     return true;
 }
 
+
+bool parseState( ParserState& parserState, const Parser& parser ) {
+    try {
+        parseKeywords( parserState, parser );
+    } catch (...) {
+        // an error in a deferred keyword comes first in the input
+        parseDeferred( parserState );
+        throw;
+    }
+
+    parseDeferred( parserState );
+    return true;
+}
+
+/*
+  A cached deck is only valid for the parser which wrote it: the key covers
+  the version of the library, the definitions of the keywords the parser
+  knows and the actions of the parse context.
+*/
+std::uint64_t deckCacheKey( std::uint64_t keywordHash, const ParseContext& parseContext ) {
+    auto key = DeckCache::hash( std::to_string( OPM_COMMON_VERSION_MAJOR ) + '.' +
+                                std::to_string( OPM_COMMON_VERSION_MINOR ) + '\n' );
+    key = DeckCache::hash( reinterpret_cast< const char* >( &keywordHash ), sizeof keywordHash, key );
+
+    for (const auto& pair : parseContext)
+        key = DeckCache::hash( pair.first + '=' + std::to_string( static_cast<int>(pair.second) ) + '\n', key );
+
+    return key;
+}
+
 }
 
 
@@ -980,9 +1192,31 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext, ErrorGuard& errors) const {
-        ParserState parserState( this->codeKeywords(), parseContext, errors, dataFileName );
+        std::string cacheFile;
+        std::uint64_t cacheKey = 0;
+        if (!this->deck_cache_directory.empty()) {
+            cacheKey = deckCacheKey( this->keyword_hash ? this->keyword_hash : this->keywordHash(),
+                                     parseContext );
+            try {
+                cacheFile = DeckCache::fileName( this->deck_cache_directory, dataFileName );
+                return DeckCache::load( cacheFile, cacheKey );
+            } catch (const std::exception& exc) {
+                OpmLog::info( std::string("Deck cache not used: ") + exc.what() );
+            }
+        }
+
+        ParserState parserState( this->codeKeywords(), parseContext, errors, dataFileName, !cacheFile.empty() );
+        parserState.parallelThreshold = this->parallel_threshold;
         parseState( parserState, *this );
 
+        if (!cacheFile.empty() && parserState.cacheable && errors.empty()) {
+            try {
+                DeckCache::save( cacheFile, cacheKey, parserState.sources, parserState.deck );
+            } catch (const std::exception& exc) {
+                OpmLog::warning( std::string("Could not write deck cache: ") + exc.what() );
+            }
+        }
+
         return std::move( parserState.deck );
     }
 
@@ -1002,6 +1236,7 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
 
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext, ErrorGuard& errors) const {
         ParserState parserState( this->codeKeywords(), parseContext, errors );
+        parserState.parallelThreshold = this->parallel_threshold;
         parserState.loadString( data );
         parseState( parserState, *this );
         return std::move( parserState.deck );
@@ -1021,6 +1256,26 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return m_deckParserKeywords.size();
     }
 
+    void Parser::setParallelThreshold(std::size_t numChars) {
+        this->parallel_threshold = numChars;
+    }
+
+    void Parser::setDeckCacheDirectory(const std::string& directory) {
+        this->deck_cache_directory = directory;
+        this->keyword_hash = directory.empty() ? 0 : this->keywordHash();
+    }
+
+    // the generated code of a keyword covers all of its definition
+    std::uint64_t Parser::keywordHash() const {
+        auto hash = DeckCache::hash( std::string() );
+        for (const auto* keywords : { &this->m_deckParserKeywords, &this->m_wildCardKeywords }) {
+            for (const auto& pair : *keywords)
+                hash = DeckCache::hash( pair.first.string() + '\n' + pair.second->createCode(), hash );
+        }
+
+        return hash;
+    }
+
     const ParserKeyword* Parser::matchingKeyword(const string_view& name) const {
         for (auto iter = m_wildCardKeywords.begin(); iter != m_wildCardKeywords.end(); ++iter) {
             if (iter->second->matches(name))
@@ -1062,6 +1317,7 @@ void Parser::addParserKeyword( ParserKeyword&& parserKeyword ) {
      */
 
     this->keyword_storage.push_back( std::move( parserKeyword ) );
+    this->keyword_hash = 0;
     const ParserKeyword * ptr = std::addressof(this->keyword_storage.back());
     string_view name( ptr->getName() );
 
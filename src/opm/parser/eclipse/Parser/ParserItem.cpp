@@ -17,10 +17,12 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <ostream>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <type_traits>
 
 #include <opm/json/JsonObject.hpp>
 
@@ -29,6 +31,7 @@
 #include <opm/parser/eclipse/Deck/UDAValue.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
+#include "raw/RawConsts.hpp"
 #include "raw/RawRecord.hpp"
 #include "raw/StarToken.hpp"
 
@@ -440,6 +443,105 @@ std::string ParserItem::createCode(const std::string& indent) const {
 
 namespace {
 
+// one token of an ALL sized item: a value, N*value or N*
+template< typename T >
+void scan_token( DeckItem& deck_item, const ParserItem& parser_item, const string_view& token ) {
+    std::string countString;
+    std::string valueString;
+
+    if( !isStarToken( token, countString, valueString ) ) {
+        deck_item.push_back( readValueToken< T >( token ) );
+        return;
+    }
+
+    StarToken st(token, countString, valueString);
+
+    if( st.hasValue() ) {
+        deck_item.push_back( readValueToken< T >( st.valueString() ), st.count() );
+        return;
+    }
+
+    if (parser_item.hasDefault()) {
+        auto value = parser_item.getDefault< T >();
+        for (size_t i=0; i < st.count(); i++)
+            deck_item.push_backDefault( value );
+    } else {
+        for (size_t i=0; i < st.count(); i++)
+            deck_item.push_backDummyDefault<T>();
+    }
+}
+
+template< typename Func >
+void for_each_token( const string_view& text, Func&& func ) {
+    const RawConsts::is_separator separator;
+    auto current = text.begin();
+
+    while( true ) {
+        current = std::find_if_not( current, text.end(), separator );
+        if( current == text.end() )
+            return;
+
+        auto token_end = std::find_if( current, text.end(), separator );
+        func( string_view{ current, token_end } );
+        current = token_end;
+    }
+}
+
+// Splits "N*value" with a count of one to nine digits; false for anything
+// else, including a zero count.
+bool split_repeat( const string_view& token, std::size_t& count, string_view& value ) {
+    auto star = token.begin();
+    std::size_t n = 0;
+    for( ; star != token.end() && *star >= '0' && *star <= '9'; ++star )
+        n = 10 * n + (*star - '0');
+
+    const auto numDigits = star - token.begin();
+    if( star == token.end() || *star != '*' || numDigits == 0 || numDigits > 9 || n == 0 )
+        return false;
+
+    count = n;
+    value = string_view{ star + 1, token.end() };
+    return true;
+}
+
+/*
+  Bulk scanner for ALL sized int and double items, i.e. the large arrays
+  like ZCORN and PORO. The record string is read directly instead of being
+  split into a deque of tokens first. The values are counted in a first
+  pass so the item is allocated once, and plain numbers and N*value repeats
+  are converted with readNumberToken(). Other tokens go through
+  scan_token(), so the values and errors are those of the general path.
+*/
+template< typename T >
+void scan_numbers( DeckItem& deck_item, const ParserItem& parser_item, const string_view& text ) {
+    std::size_t num_values = 0;
+    for_each_token( text, [&num_values]( const string_view& token ) {
+        std::size_t count = 1;
+        string_view value;
+        split_repeat( token, count, value );
+        num_values += count;
+    });
+
+    deck_item.reserve( num_values );
+
+    for_each_token( text, [&deck_item, &parser_item]( const string_view& token ) {
+        std::size_t count;
+        string_view value_string;
+        T value;
+
+        if( !split_repeat( token, count, value_string ) ) {
+            if( readNumberToken( token, value ) )
+                deck_item.push_back( value );
+            else
+                scan_token< T >( deck_item, parser_item, token );
+        }
+        else if( !value_string.empty() && readNumberToken( value_string, value ) )
+            deck_item.push_back( value, count );
+        else
+            scan_token< T >( deck_item, parser_item, token );
+    });
+}
+
 template< typename T >
 void scan_item( DeckItem& deck_item, const ParserItem& parser_item, RawRecord& record ) {
     bool parse_raw = parser_item.parseRaw();
@@ -453,34 +555,17 @@ void scan_item( DeckItem& deck_item, const ParserItem& parser_item, RawRecord& r
             return;
         }
 
-        while( record.size() > 0 ) {
-            auto token = record.pop_front();
-
-            std::string countString;
-            std::string valueString;
-
-            if( !isStarToken( token, countString, valueString ) ) {
-                deck_item.push_back( readValueToken< T >( token ) );
-                continue;
-            }
-
-            StarToken st(token, countString, valueString);
-
-            if( st.hasValue() ) {
-                deck_item.push_back( readValueToken< T >( st.valueString() ), st.count() );
-                continue;
-            }
-
-            if (parser_item.hasDefault()) {
-                auto value = parser_item.getDefault< T >();
-                for (size_t i=0; i < st.count(); i++)
-                    deck_item.push_backDefault( value );
-            } else {
-                for (size_t i=0; i < st.count(); i++)
-                    deck_item.push_backDummyDefault<T>();
+        if constexpr (std::is_same< T, int >::value || std::is_same< T, double >::value) {
+            string_view text;
+            if (record.pop_all( text )) {
+                scan_numbers< T >( deck_item, parser_item, text );
+                return;
             }
         }
 
+        while( record.size() > 0 )
+            scan_token< T >( deck_item, parser_item, record.pop_front() );
+
         return;
     }
 
@@ -117,7 +117,7 @@ namespace {
 
     bool RawKeyword::addRecord(RawRecord record) {
 
-        if (record.size() > 0)
+        if (!record.empty())
             m_isTempFinished = false;
 
         this->m_records.push_back(std::move(record));
@@ -71,8 +71,8 @@ std::deque< string_view > splitSingleRecordString( const string_view& record ) {
     */
 
 template< typename T >
-inline bool even_quotes( const T& str ) {
-    return std::count( str.begin(), str.end(), RawConsts::quote ) % 2 == 0;
+inline std::size_t count_quotes( const T& str ) {
+    return std::count( str.begin(), str.end(), RawConsts::quote );
 }
 
 }
@@ -81,14 +81,17 @@ inline bool even_quotes( const T& str ) {
         m_sanitizedRecordString( singleRecordString )
     {
 
-        if (text)
+        if (text) {
             this->m_recordItems.push_back(this->m_sanitizedRecordString);
+            this->m_split = true;
+        }
         else {
-            this->m_recordItems = splitSingleRecordString( m_sanitizedRecordString );
-
-            if( !even_quotes( singleRecordString ) )
+            const auto quotes = count_quotes( singleRecordString );
+            if( quotes % 2 != 0 )
                 throw std::invalid_argument("Input string is not a complete record string, "
                                             "offending string: '" + singleRecordString + "'");
+
+            this->m_quoted = quotes > 0;
         }
     }
 
@@ -96,12 +99,35 @@ inline bool even_quotes( const T& str ) {
         RawRecord(singleRecordString, false)
     {}
 
+    void RawRecord::splitRecordString() const {
+        this->m_recordItems = splitSingleRecordString( m_sanitizedRecordString );
+        this->m_split = true;
+    }
+
+    bool RawRecord::empty() const {
+        if (this->m_split)
+            return this->m_recordItems.empty();
+
+        return std::all_of( m_sanitizedRecordString.begin(), m_sanitizedRecordString.end(), RawConsts::is_separator() );
+    }
+
+    bool RawRecord::pop_all( string_view& text ) {
+        if (this->m_split || this->m_quoted)
+            return false;
+
+        text = this->m_sanitizedRecordString;
+        this->m_split = true;
+        return true;
+    }
+
     void RawRecord::prepend( size_t count, string_view tok ) {
+        this->split();
         this->m_recordItems.insert( this->m_recordItems.begin(), count, tok );
     }
 
     void RawRecord::dump() const {
         std::cout << "RecordDump: ";
+        this->split();
         for (size_t i = 0; i < m_recordItems.size(); i++) {
             std::cout
                 << this->m_recordItems[i] << "/"
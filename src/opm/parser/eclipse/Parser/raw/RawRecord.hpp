@@ -42,32 +42,56 @@ namespace Opm {
         void push_front( string_view token );
         void prepend( size_t count, string_view token );
         inline size_t size() const;
+        bool empty() const;
 
         std::string getRecordString() const;
+        std::size_t length() const { return m_sanitizedRecordString.size(); }
         inline string_view getItem(size_t index) const;
 
+        // Takes the complete record string, for scanners which read the
+        // tokens directly.  Only possible while nothing has been taken from
+        // the record and the record has no quoted strings; returns false
+        // otherwise.  The record is empty afterwards.
+        bool pop_all( string_view& text );
+
         void dump() const;
 
     private:
         string_view m_sanitizedRecordString;
-        std::deque< string_view > m_recordItems;
+
+        // The record string is split into tokens when they are first
+        // needed, records consumed by pop_all() are never split.
+        mutable std::deque< string_view > m_recordItems;
+        mutable bool m_split = false;
+        bool m_quoted = false;
+
+        inline void split() const;
+        void splitRecordString() const;
     };
 
     /*
      * These are frequently called, but fairly trivial in implementation, and
      * inlining the calls gives a decent low-effort performance benefit.
      */
+    void RawRecord::split() const {
+        if (!this->m_split)
+            this->splitRecordString();
+    }
+
     string_view RawRecord::pop_front() {
+        this->split();
         auto front = m_recordItems.front();
         this->m_recordItems.pop_front();
         return front;
     }
 
     size_t RawRecord::size() const {
+        this->split();
         return m_recordItems.size();
     }
 
     string_view RawRecord::getItem(size_t index) const {
+        this->split();
         return this->m_recordItems.at( index );
     }
 }
@@ -20,9 +20,11 @@
 #include <array>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <cstdlib>
+#include <limits>
 
 #include <boost/spirit/include/qi.hpp>
 
@@ -108,6 +110,116 @@ namespace Opm {
     }
 
 
+    namespace {
+
+    bool isDigit( char c ) {
+        return c >= '0' && c <= '9';
+    }
+
+    template< typename Itr >
+    bool readSign( Itr& it, const Itr& end ) {
+        if( it == end || (*it != '-' && *it != '+') )
+            return false;
+
+        return *it++ == '-';
+    }
+
+    }
+
+    template<>
+    bool readNumberToken< int >( string_view view, int& value ) {
+        auto it = view.begin();
+        const bool neg = readSign( it, view.end() );
+
+        // at most nine digits can not overflow
+        const auto numDigits = view.end() - it;
+        if( numDigits == 0 || numDigits > 9 )
+            return false;
+
+        int n = 0;
+        for( ; it != view.end(); ++it ) {
+            if( !isDigit( *it ) )
+                return false;
+
+            n = 10 * n + (*it - '0');
+        }
+
+        value = neg ? -n : n;
+        return true;
+    }
+
+    /*
+      The digits are accumulated in a 64 bit integer and scaled by a power of
+      ten in the same way as the Spirit real parser used by readValueToken()
+      does. With at most 15 digits the mantissa is exact in a double, so the
+      scaling is the only rounding step and the values are identical. Leading
+      zeros are counted as well, the Spirit parser does not skip them either.
+      Tokens with more digits, or an exponent outside the range of double, are
+      left to readValueToken().
+    */
+
+    template<>
+    bool readNumberToken< double >( string_view view, double& value ) {
+        auto it = view.begin();
+        const auto end = view.end();
+        const bool neg = readSign( it, end );
+
+        std::uint64_t acc = 0;
+        int numDigits = 0;
+        int fracDigits = 0;
+
+        for( ; it != end && isDigit( *it ); ++it, ++numDigits )
+            acc = 10 * acc + (*it - '0');
+
+        if( it != end && *it == '.' ) {
+            for( ++it; it != end && isDigit( *it ); ++it, ++numDigits, ++fracDigits )
+                acc = 10 * acc + (*it - '0');
+        }
+
+        if( numDigits == 0 || numDigits > std::numeric_limits< double >::digits10 )
+            return false;
+
+        int exp = 0;
+        if( it != end ) {
+            if( *it != 'e' && *it != 'E' && *it != 'd' && *it != 'D' )
+                return false;
+
+            ++it;
+            const bool negExp = readSign( it, end );
+
+            const auto expDigits = end - it;
+            if( expDigits == 0 || expDigits > 4 )
+                return false;
+
+            for( ; it != end; ++it ) {
+                if( !isDigit( *it ) )
+                    return false;
+
+                exp = 10 * exp + (*it - '0');
+            }
+
+            if( negExp )
+                exp = -exp;
+        }
+
+        const int scale = exp - fracDigits;
+        double n;
+        if( scale >= 0 ) {
+            if( scale > std::numeric_limits< double >::max_exponent10 )
+                return false;
+
+            n = acc * boost::spirit::traits::pow10< double >( scale );
+        } else {
+            if( scale < std::numeric_limits< double >::min_exponent10 )
+                return false;
+
+            n = static_cast< double >( acc ) / boost::spirit::traits::pow10< double >( -scale );
+        }
+
+        value = neg ? -n : n;
+        return true;
+    }
+
     template <>
     std::string readValueToken< std::string >( string_view view ) {
         if( view.size() == 0 || view[ 0 ] != '\'' )
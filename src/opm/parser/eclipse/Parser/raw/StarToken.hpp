@@ -33,6 +33,12 @@ namespace Opm {
     template <class T>
     T readValueToken( string_view );
 
+    // Reads a plain number - e.g. "-12" or "1.5D+3" - giving the same value
+    // as readValueToken(), without its overhead.  Returns false for tokens
+    // it does not handle; those should be passed to readValueToken().
+    template <class T>
+    bool readNumberToken( string_view, T& );
+
 class StarToken {
 public:
     StarToken(const string_view& token)
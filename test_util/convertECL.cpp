@@ -1,6 +1,8 @@
 #include <chrono>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <tuple>
 #include <getopt.h>
 
@@ -103,7 +105,9 @@ static void printHelp() {
               << "\nIn addition, the program takes these options (which must be given before the arguments):\n\n"
               << "-h Print help and exit.\n"
               << "-l list report step numbers in the selected restart file.\n"
-              << "-r extract and convert a spesific report time step number from a unified restart file. \n\n";
+              << "-r extract and convert a spesific report time step number from a unified restart file. \n"
+              << "-c compress a binary file, every array is compressed separately. The file is replaced by the compressed file.\n"
+              << "-u uncompress a compressed binary file. The file is replaced by the uncompressed file.\n\n";
 }
 
 int main(int argc, char **argv) {
@@ -112,8 +116,10 @@ int main(int argc, char **argv) {
     int reportStepNumber           = -1;
     bool specificReportStepNumber  = false;
     bool listProperties            = false;
+    bool compress                  = false;
+    bool uncompress                = false;
 
-    while ((c = getopt(argc, argv, "hr:l")) != -1) {
+    while ((c = getopt(argc, argv, "hr:lcu")) != -1) {
         switch (c) {
         case 'h':
             printHelp();
@@ -125,6 +131,12 @@ int main(int argc, char **argv) {
             specificReportStepNumber=true;
             reportStepNumber = atoi(optarg);
             break;
+        case 'c':
+            compress=true;
+            break;
+        case 'u':
+            uncompress=true;
+            break;
         default:
             return EXIT_FAILURE;
         }
@@ -181,7 +193,21 @@ int main(int argc, char **argv) {
     std::map<std::string, std::string> to_binary = {{".FEGRID", ".EGRID"}, {".FINIT", ".INIT"}, {".FSMSPEC", ".SMSPEC"}, 
         {".FUNSMRY", ".UNSMRY"}, {".FUNRST", ".UNRST"}, {".FRFT", ".RFT"}};
         
-    if (formattedOutput) {
+    const bool changeCompression = compress || uncompress;
+
+    if (changeCompression) {
+
+        if (file1.formattedInput() || (compress && uncompress) || specificReportStepNumber) {
+            std::cout << "\n!ERROR, options -c and -u apply to complete binary files and cannot be combined with each other or -r\n" << std::endl;
+            exit(1);
+        }
+
+        // written next to the input file, which is then replaced
+
+        formattedOutput = false;
+        resFile = filename + ".tmp";
+
+    } else if (formattedOutput) {
         
         auto search = to_formatted.find(extension);
     
@@ -211,36 +237,64 @@ int main(int argc, char **argv) {
         }
     }
 
-    std::cout << "\033[1;31m" << "\nconverting  " << argv[argOffset] << " -> " << resFile << "\033[0m\n" << std::endl;
+    std::cout << "\033[1;31m" << "\nconverting  " << argv[argOffset] << " -> "
+              << (changeCompression ? filename : resFile) << "\033[0m\n" << std::endl;
 
-    EclOutput outFile(resFile, formattedOutput);
+    if (specificReportStepNumber && (extension!=".UNRST")) {
+        std::cout << "\n!ERROR, option -r only can only be used with unified restart files (*.UNRST) " << std::endl;
+        exit(1);
+    }
 
-    if (specificReportStepNumber) {
+    auto outFile = std::make_unique<EclOutput>(resFile, formattedOutput, std::ios::out, compress);
+    bool written = outFile->good();
 
-        if (extension!=".UNRST") {
-            std::cout << "\n!ERROR, option -r only can only be used with unified restart files (*.UNRST) " << std::endl;
-            exit(1);
-        }
+    try {
+        if (specificReportStepNumber) {
 
-        ERst rst1(filename);
+            ERst rst1(filename);
 
-        if (!rst1.hasReportStepNumber(reportStepNumber)) {
-            std::cout << "\n!ERROR, selected unified restart file doesn't have report step number " << reportStepNumber << "\n" << std::endl;
-            exit(1);
+            if (!rst1.hasReportStepNumber(reportStepNumber)) {
+                std::cout << "\n!ERROR, selected unified restart file doesn't have report step number " << reportStepNumber << "\n" << std::endl;
+                exit(1);
+            }
+
+            rst1.loadReportStepNumber(reportStepNumber);
+
+            auto arrayList = rst1.listOfRstArrays(reportStepNumber);
+
+            writeArrayList(arrayList, rst1, reportStepNumber, *outFile);
+
+        } else {
+
+            file1.loadData();
+            auto arrayList = file1.getList();
+
+            writeArrayList(arrayList, file1, *outFile);
         }
 
-        rst1.loadReportStepNumber(reportStepNumber);
+        outFile->flushStream();
+        written = written && outFile->good();
+    } catch (const std::exception& e) {
+        std::cout << "\n!ERROR, " << e.what() << std::endl;
+        written = false;
+    }
 
-        auto arrayList = rst1.listOfRstArrays(reportStepNumber);
+    outFile.reset();
 
-        writeArrayList(arrayList, rst1, reportStepNumber, outFile);
+    // the input file is only replaced by a complete output file
 
-    } else {
+    if (!written) {
+        std::cout << "\n!ERROR, unable to write '" << resFile << "'\n" << std::endl;
 
-        file1.loadData();
-        auto arrayList = file1.getList();
+        if (changeCompression)
+            std::remove(resFile.c_str());
 
-        writeArrayList(arrayList, file1, outFile);
+        exit(1);
+    }
+
+    if (changeCompression && (std::rename(resFile.c_str(), filename.c_str()) != 0)) {
+        std::cout << "\n!ERROR, unable to replace '" << filename << "' by '" << resFile << "'\n" << std::endl;
+        exit(1);
     }
 
     auto end = std::chrono::system_clock::now();
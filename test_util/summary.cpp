@@ -31,6 +31,7 @@ static void printHelp() {
 
     std::cout << "\nsummary needs a minimum of two arguments. First is smspec filename and then list of vectors  \n"
               << "\nIn addition, the program takes these options (which must be given before the arguments):\n\n"
+              << "-c create or update transposed summary file (.ESMRY), speeds up later reads.\n"
               << "-h Print help and exit.\n"
               << "-l list all summary vectors.\n"
               << "-r extract data only for report steps. \n\n";
@@ -65,9 +66,13 @@ int main(int argc, char **argv) {
     int c                          = 0;
     bool reportStepsOnly           = false;
     bool listKeys                  = false;
+    bool writeCacheFile            = false;
 
-    while ((c = getopt(argc, argv, "hrl")) != -1) {
+    while ((c = getopt(argc, argv, "chrl")) != -1) {
         switch (c) {
+        case 'c':
+            writeCacheFile=true;
+            break;
         case 'h':
             printHelp();
             return 0;
@@ -86,6 +91,10 @@ int main(int argc, char **argv) {
 
     std::string filename = argv[argOffset];
     Opm::EclIO::ESmry smryFile(filename);
+
+    if (writeCacheFile) {
+        smryFile.writeCacheFile();
+    }
     
     if (listKeys){
         auto list = smryFile.keywordList();
@@ -123,7 +132,11 @@ int main(int argc, char **argv) {
             std::cout << "\n!Runtime Error \n >> " << message << "\n\n";
             return EXIT_FAILURE;
         }
-        
+    }
+
+    smryFile.loadData(smryList);
+
+    for (auto key : smryList){
         std::vector<float> vect = reportStepsOnly ? smryFile.get_at_rstep(key) : smryFile.get(key);
 
         smryData.push_back(vect);
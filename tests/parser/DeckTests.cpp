@@ -671,6 +671,42 @@ BOOST_AUTO_TEST_CASE(DeckItemEqual) {
 }
 
 
+BOOST_AUTO_TEST_CASE(DeckItemValueStatus) {
+    DeckItem item("TEST", int());
+    item.push_back(1, 1000);
+    item.push_backDefault(2);
+    item.push_backDefault(2);
+    item.push_back(3);
+
+    BOOST_CHECK_EQUAL( item.data_size(), 1003U );
+    BOOST_CHECK( !item.defaultApplied(999) );
+    BOOST_CHECK( item.defaultApplied(1000) );
+    BOOST_CHECK( item.defaultApplied(1001) );
+    BOOST_CHECK( !item.defaultApplied(1002) );
+    BOOST_CHECK_THROW( item.defaultApplied(1003), std::out_of_range );
+
+    const auto& status = item.getValueStatus();
+    BOOST_CHECK_EQUAL( status.size(), 1003U );
+    BOOST_CHECK( status[999] == value::status::deck_value );
+    BOOST_CHECK( status[1001] == value::status::valid_default );
+    BOOST_CHECK( status[1002] == value::status::deck_value );
+    for (std::size_t i = 0; i < status.size(); i++)
+        BOOST_CHECK( item.status(i) == status[i] );
+
+    // the expanded status follows values added later
+    item.push_backDummyDefault<int>();
+    BOOST_CHECK_EQUAL( item.getValueStatus().size(), 1004U );
+    BOOST_CHECK( item.getValueStatus()[1003] == value::status::empty_default );
+    BOOST_CHECK( !item.hasValue(1003) );
+    BOOST_CHECK_THROW( item.get<int>(1003), std::invalid_argument );
+
+    DeckItem copy(item.dVal(), item.iVal(), item.sVal(), item.uVal(), item.getType(), item.name(),
+                  item.valueStatus(), item.rawData(), item.activeDimensions(), item.defaultDimensions());
+    BOOST_CHECK( copy.equal( item, true, true ) );
+    BOOST_CHECK( copy.getValueStatus() == item.getValueStatus() );
+}
+
+
 BOOST_AUTO_TEST_CASE(STRING_TO_BOOL) {
     BOOST_CHECK( DeckItem::to_bool("TRUE") );
     BOOST_CHECK( DeckItem::to_bool("T") );
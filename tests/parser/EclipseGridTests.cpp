@@ -1070,6 +1070,48 @@ BOOST_AUTO_TEST_CASE(ProcessedCopy) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(CellGeometryBulk) {
+
+    const Opm::EclipseGrid grid0(4, 5, 3, 10.0, 20.0, 2.0);
+
+    std::vector<double> zcorn = grid0.getZCORN();
+    for (std::size_t n = 0; n < zcorn.size(); n++)
+        zcorn[n] += 0.1 * (n % 7);
+
+    std::vector<int> actnum(grid0.getCartesianSize(), 1);
+    for (std::size_t n = 0; n < actnum.size(); n += 3)
+        actnum[n] = 0;
+
+    const Opm::EclipseGrid grid(grid0, zcorn.data(), actnum);
+    const auto geometry = grid.getCellGeometry();
+
+    BOOST_CHECK_EQUAL(geometry.volume.size(), grid.getNumActive());
+
+    for (std::size_t a = 0; a < grid.getNumActive(); a++) {
+        const auto g = grid.getGlobalIndex(a);
+        const auto center = grid.getCellCenter(g);
+
+        BOOST_CHECK_CLOSE(geometry.volume[a], grid.getCellVolume(g), 1e-10);
+        BOOST_CHECK_CLOSE(geometry.depth[a], grid.getCellDepth(g), 1e-10);
+        BOOST_CHECK_CLOSE(geometry.centerX[a], center[0], 1e-10);
+        BOOST_CHECK_CLOSE(geometry.centerY[a], center[1], 1e-10);
+        BOOST_CHECK_CLOSE(geometry.centerZ[a], center[2], 1e-10);
+
+        for (std::size_t c = 0; c < 8; c++) {
+            const auto corner = grid.getCornerPos(g % 4, (g / 4) % 5, g / 20, c);
+            BOOST_CHECK_CLOSE(geometry.cornerX[c][a], corner[0], 1e-10);
+            BOOST_CHECK_CLOSE(geometry.cornerZ[c][a], corner[2], 1e-10);
+        }
+    }
+
+    const auto range = grid.getCellGeometry(5, 15, Opm::CellGeometry::Depths);
+    BOOST_CHECK_EQUAL(range.depth.size(), 10U);
+    BOOST_CHECK(range.volume.empty());
+    BOOST_CHECK_CLOSE(range.depth[0], geometry.depth[5], 1e-10);
+
+    BOOST_CHECK_THROW(grid.getCellGeometry(5, grid.getNumActive() + 1), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(regularCartGrid) {
 
     int nx = 3;
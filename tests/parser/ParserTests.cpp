@@ -21,12 +21,16 @@
 #include <boost/test/unit_test.hpp>
 
 #include <opm/json/JsonObject.hpp>
+#include <fstream>
 #include <iostream>
 
 #include <opm/common/utility/FileSystem.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Deck/UDAValue.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
 #include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
@@ -2314,3 +2318,160 @@ auto record = kw.getRecord(1);
 BOOST_CHECK_EQUAL( record.getItem(5).get<double>(0), 0.9 );
 BOOST_CHECK( !deck.hasKeyword("LANGMUIR") );
 }
+
+BOOST_AUTO_TEST_CASE(ParseDeferredDataKeywords) {
+    const std::string deck_string = R"(
+RUNSPEC
+FIELD
+DIMENS
+ 2 2 2 /
+TABDIMS
+ 1 1 3 /
+GRID
+DX
+ 8*100 /
+DY
+ 4*50 2*60 2*70 /
+DZ
+ 8*10 /
+TOPS
+ 4*8000 /
+PORO
+ 0.25 0.20 3*0.15 0.1 1* 0.3 /
+ACTNUM
+ 3*1 0 4*1 /
+PROPS
+SWOF
+ 0.1 0.0 1.0 0.0
+ 0.5 0.3 0.4 0.0
+ 1.0 1.0 0.0 0.0 /
+)";
+
+    Parser serial;
+    serial.setParallelThreshold(0);
+
+    Parser deferred;
+    deferred.setParallelThreshold(1);
+
+    const auto deck1 = serial.parseString(deck_string);
+    const auto deck2 = deferred.parseString(deck_string);
+
+    BOOST_CHECK( deck1 == deck2 );
+    BOOST_CHECK_EQUAL( deck2.getKeyword("PORO").getSIDoubleData()[4], 0.15 );
+    BOOST_CHECK_CLOSE( deck2.getKeyword("DY").getSIDoubleData()[7], 70 * 0.3048, 1e-10 );
+
+    const std::string invalid_string = deck_string + R"(
+REGIONS
+SATNUM
+ 8*1 /
+)";
+    auto bad_string = invalid_string;
+    bad_string.replace(bad_string.find("0.20"), 4, "0.2X");
+
+    std::string serial_msg;
+    try {
+        serial.parseString(bad_string);
+    } catch (const std::invalid_argument& exc) {
+        serial_msg = exc.what();
+    }
+
+    std::string deferred_msg;
+    try {
+        deferred.parseString(bad_string);
+    } catch (const std::invalid_argument& exc) {
+        deferred_msg = exc.what();
+    }
+
+    BOOST_CHECK( serial_msg.find("PORO") != std::string::npos );
+    BOOST_CHECK_EQUAL( serial_msg, deferred_msg );
+}
+
+BOOST_AUTO_TEST_CASE(ParseFileDeckCache) {
+    namespace fs = Opm::filesystem;
+    const auto work_dir = fs::temp_directory_path() / Opm::unique_path("deck_cache_%%%%-%%%%");
+    const auto cache_dir = work_dir / "cache";
+    fs::create_directories(work_dir);
+
+    const auto data_file = (work_dir / "CASE.DATA").string();
+    const auto include_file = (work_dir / "PORO.INC").string();
+    {
+        std::ofstream data(data_file);
+        data << R"(
+RUNSPEC
+FIELD
+DIMENS
+ 2 2 2 /
+GRID
+DX
+ 8*100 /
+DY
+ 8*50 /
+DZ
+ 8*10 /
+TOPS
+ 4*8000 /
+INCLUDE
+ 'PORO.INC' /
+SCHEDULE
+WCONPROD
+ 'P1' 'OPEN' 'ORAT' 'WUOPRL' 4* 1000 /
+/
+)";
+        std::ofstream include(include_file);
+        include << "PORO\n 0.25 0.20 3*0.15 0.1 1* 0.3 /\n";
+    }
+
+    Parser parser;
+    parser.setDeckCacheDirectory(cache_dir.string());
+
+    const auto deck1 = parser.parseFile(data_file);
+    const auto deck0 = Parser().parseFile(data_file);
+    BOOST_CHECK( deck0 == deck1 );
+
+    std::vector<fs::path> cache_files;
+    for (const auto& entry : fs::directory_iterator(cache_dir))
+        cache_files.push_back(entry.path());
+    BOOST_REQUIRE_EQUAL( cache_files.size(), 1U );
+    const auto write_time = fs::last_write_time(cache_files[0]);
+
+    // unchanged input: the deck is read from the cache, which is not rewritten
+    const auto deck2 = parser.parseFile(data_file);
+    BOOST_CHECK( deck0 == deck2 );
+    BOOST_CHECK( deck0.getKeyword("PORO").getValueStatus() == deck2.getKeyword("PORO").getValueStatus() );
+    BOOST_CHECK( write_time == fs::last_write_time(cache_files[0]) );
+    BOOST_CHECK_EQUAL( deck2.getKeyword("WCONPROD").getRecord(0).getItem("ORAT").get<UDAValue>(0).get<std::string>(), "WUOPRL" );
+    BOOST_CHECK_CLOSE( deck2.getKeyword("DX").getSIDoubleData()[0], 100 * 0.3048, 1e-10 );
+
+    // a changed include file invalidates the cache
+    {
+        std::ofstream include(include_file);
+        include << "PORO\n 8*0.35 /\n";
+    }
+    const auto deck3 = parser.parseFile(data_file);
+    BOOST_CHECK_EQUAL( deck3.getKeyword("PORO").getSIDoubleData()[0], 0.35 );
+    BOOST_CHECK( Parser().parseFile(data_file) == deck3 );
+    BOOST_CHECK( parser.parseFile(data_file) == deck3 );
+
+    // a damaged cache file is ignored
+    {
+        std::ofstream damaged(cache_files[0].string(), std::ios::binary);
+        damaged << "OPMDECK1 and then garbage";
+    }
+    BOOST_CHECK( parser.parseFile(data_file) == deck3 );
+
+    // a parser with a changed keyword definition does not use the cache
+    {
+        std::ofstream include(include_file);
+        include << "PORO\n 6*0.25 1* 0.3 /\n";
+    }
+    const auto deck4 = parser.parseFile(data_file);
+    BOOST_CHECK( parser.parseFile(data_file) == deck4 );
+    BOOST_CHECK_EQUAL( deck4.getKeyword("PORO").getSIDoubleData()[6], 0.0 );
+
+    Parser changed;
+    changed.addParserKeyword( Json::JsonObject( R"({"name" : "PORO" , "sections" : ["GRID"], "data" : {"value_type" : "DOUBLE" , "default" : 0.5 , "dimension":"1"}})" ) );
+    changed.setDeckCacheDirectory(cache_dir.string());
+    BOOST_CHECK_EQUAL( changed.parseFile(data_file).getKeyword("PORO").getSIDoubleData()[6], 0.5 );
+
+    fs::remove_all(work_dir);
+}
@@ -0,0 +1,286 @@
+/*
+  Copyright 2020 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE SnapshotTests
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <opm/common/utility/FileSystem.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FieldPropsManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Action/ASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/SpiralICD.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/MSW/Valve.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQASTNode.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQActive.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/UDQ/UDQConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WList.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/WListManager.hpp>
+#include <opm/parser/eclipse/EclipseState/Snapshot.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Util/BinarySerializer.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Units/UnitSystem.hpp>
+
+using namespace Opm;
+
+namespace {
+
+template <class T>
+T roundTrip(const T& data) {
+    BinarySerializer packer;
+    packer.pack(data);
+
+    T copy;
+    BinarySerializer unpacker(packer.buffer());
+    unpacker.unpack(copy);
+    BOOST_CHECK(unpacker.done());
+    return copy;
+}
+
+template <class T>
+std::vector<char> packed(const T& data) {
+    BinarySerializer packer;
+    packer.pack(data);
+    return packer.buffer();
+}
+
+template <class T>
+bool equal_fields(const FieldPropsManager& fp1, const FieldPropsManager& fp2) {
+    // keys() follows the order of a hash map
+    auto keys = fp1.keys<T>();
+    auto keys2 = fp2.keys<T>();
+    std::sort(keys.begin(), keys.end());
+    std::sort(keys2.begin(), keys2.end());
+    if (keys != keys2)
+        return false;
+
+    for (const auto& key : keys) {
+        if (fp1.get_copy<T>(key) != fp2.get_copy<T>(key))
+            return false;
+
+        if (fp1.defaulted<T>(key) != fp2.defaulted<T>(key))
+            return false;
+    }
+
+    return true;
+}
+
+bool equal(const FieldPropsManager& fp1, const FieldPropsManager& fp2) {
+    return fp1.active_size() == fp2.active_size() &&
+           fp1.actnum() == fp2.actnum() &&
+           fp1.porv(true) == fp2.porv(true) &&
+           fp1.default_region() == fp2.default_region() &&
+           equal_fields<int>(fp1, fp2) &&
+           equal_fields<double>(fp1, fp2);
+}
+
+// EclipseState has no operator==
+bool equal(const EclipseState& es1, const EclipseState& es2) {
+    return es1.getInputGrid().equal(es2.getInputGrid()) &&
+           es1.getInputGrid().getNumActive() == es2.getInputGrid().getNumActive() &&
+           es1.getInputGrid().getActiveMap() == es2.getInputGrid().getActiveMap() &&
+           equal(es1.fieldProps(), es2.fieldProps()) &&
+           es1.getTableManager() == es2.getTableManager() &&
+           es1.runspec() == es2.runspec() &&
+           es1.getEclipseConfig() == es2.getEclipseConfig() &&
+           es1.getDeckUnitSystem() == es2.getDeckUnitSystem() &&
+           es1.getInputNNC() == es2.getInputNNC() &&
+           es1.getInputEDITNNC() == es2.getInputEDITNNC() &&
+           es1.gridDims() == es2.gridDims() &&
+           es1.getSimulationConfig() == es2.getSimulationConfig() &&
+           es1.getTransMult() == es2.getTransMult() &&
+           es1.getFaults() == es2.getFaults() &&
+           es1.getTitle() == es2.getTitle() &&
+           es1.aquifer() == es2.aquifer();
+}
+
+struct Case {
+    explicit Case(const std::string& deck_file) :
+        deck(Parser().parseFile(deck_file)),
+        es(deck),
+        schedule(deck, es),
+        summary_config(deck, schedule, es.getTableManager())
+    {}
+
+    Deck deck;
+    EclipseState es;
+    Schedule schedule;
+    SummaryConfig summary_config;
+};
+
+}
+
+
+BOOST_AUTO_TEST_CASE(SerializerContainers) {
+    std::vector<bool> flags = {true, false, true};
+    std::map<std::string, std::vector<int>> numbers = {{"A", {1, 2, 3}}, {"B", {}}};
+    std::optional<double> value = 1.5;
+    std::optional<double> no_value;
+    std::shared_ptr<const std::string> null_ptr;
+    std::unique_ptr<int> int_ptr(new int(42));
+
+    BOOST_CHECK(roundTrip(flags) == flags);
+    BOOST_CHECK(roundTrip(numbers) == numbers);
+    BOOST_CHECK(roundTrip(value) == value);
+    BOOST_CHECK(!roundTrip(no_value));
+    BOOST_CHECK(!roundTrip(null_ptr));
+    BOOST_CHECK_EQUAL(*roundTrip(int_ptr), 42);
+    BOOST_CHECK_EQUAL(roundTrip(std::string("WELL-1")), "WELL-1");
+
+    auto field = UnitSystem::newFIELD();
+    BOOST_CHECK(roundTrip(field) == field);
+    BOOST_CHECK_EQUAL(roundTrip(field).getDimension("Pressure").getSIScaling(),
+                      field.getDimension("Pressure").getSIScaling());
+
+    BinarySerializer unpacker(packed(std::string("ABC")));
+    std::string str;
+    unpacker.unpack(str);
+    BOOST_CHECK_THROW(unpacker.unpack(str), std::runtime_error);
+    BOOST_CHECK_THROW(unpacker.pack(str), std::logic_error);
+}
+
+
+BOOST_AUTO_TEST_CASE(SerializerSharedPointers) {
+    auto value = std::make_shared<std::string>("WELL-1");
+    std::vector<std::shared_ptr<std::string>> pointers = {value, value, nullptr, std::make_shared<std::string>("WELL-1"), value};
+
+    const auto copy = roundTrip(pointers);
+    BOOST_REQUIRE_EQUAL(copy.size(), pointers.size());
+    BOOST_CHECK(copy[0] == copy[1]);
+    BOOST_CHECK(copy[0] == copy[4]);
+    BOOST_CHECK(!copy[2]);
+    BOOST_CHECK(copy[3] != copy[0]);
+    BOOST_CHECK_EQUAL(*copy[3], *copy[0]);
+
+    // an object shared between pointers is packed once
+    std::vector<std::shared_ptr<std::string>> distinct = {value, std::make_shared<std::string>("WELL-1"), nullptr,
+                                                          std::make_shared<std::string>("WELL-1"), std::make_shared<std::string>("WELL-1")};
+    BOOST_CHECK(packed(pointers).size() < packed(distinct).size());
+}
+
+
+BOOST_AUTO_TEST_CASE(SerializeScheduleSharing) {
+    const Case input("SPE1CASE2.DATA");
+    const auto copy = roundTrip(input.schedule);
+
+    // a well which is unchanged from one report step to the next is the
+    // same object in both steps, also after unpacking
+    std::size_t shared_steps = 0;
+    for (const auto& well_name : input.schedule.wellNames()) {
+        for (std::size_t step = 1; step < input.schedule.size(); step++) {
+            if (!input.schedule.hasWell(well_name, step - 1) || !input.schedule.hasWell(well_name, step))
+                continue;
+
+            const bool shared = &input.schedule.getWell(well_name, step - 1) == &input.schedule.getWell(well_name, step);
+            BOOST_CHECK_EQUAL(&copy.getWell(well_name, step - 1) == &copy.getWell(well_name, step), shared);
+            if (shared)
+                shared_steps++;
+        }
+    }
+    BOOST_CHECK(shared_steps > 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(SerializeDeck) {
+    const auto deck = Parser().parseFile("SPE1CASE2.DATA");
+    const auto copy = roundTrip(deck);
+
+    BOOST_CHECK(copy == deck);
+    BOOST_CHECK_EQUAL(copy.size(), deck.size());
+    BOOST_CHECK(copy.hasKeyword("WCONPROD"));
+    BOOST_CHECK(copy.getActiveUnitSystem() == deck.getActiveUnitSystem());
+    BOOST_CHECK_EQUAL(copy.getDataFile(), deck.getDataFile());
+    BOOST_CHECK(copy.getKeyword("PORO").getSIDoubleData() == deck.getKeyword("PORO").getSIDoubleData());
+}
+
+
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+    for (const auto& deck_file : {"SPE1CASE2.DATA", "UDQ_ACTIONX_TEST1.DATA", "SOFR_TEST.DATA"}) {
+        BOOST_TEST_MESSAGE("Round trip of: " << deck_file);
+        const Case input(deck_file);
+
+        BOOST_CHECK(roundTrip(input.schedule) == input.schedule);
+        BOOST_CHECK(roundTrip(input.summary_config) == input.summary_config);
+        BOOST_CHECK(equal(roundTrip(input.es), input.es));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(SnapshotFile) {
+    const Case input("UDQ_ACTIONX_TEST1.DATA");
+    const std::string snapshot_file = "UDQ_ACTIONX_TEST1.SNAPSHOT";
+
+    Snapshot::save(snapshot_file, input.es, input.schedule, input.summary_config);
+    {
+        EclipseState es;
+        Schedule schedule;
+        SummaryConfig summary_config;
+        Snapshot::load(snapshot_file, es, schedule, summary_config);
+
+        BOOST_CHECK(equal(es, input.es));
+        BOOST_CHECK(es.getInputGrid().getNumActive() > 0);
+        BOOST_CHECK(es.fieldProps().get_copy<double>("SWL") == input.es.fieldProps().get_copy<double>("SWL"));
+        BOOST_CHECK(schedule == input.schedule);
+        BOOST_CHECK(summary_config == input.summary_config);
+        const auto last_step = input.schedule.size() - 1;
+        BOOST_CHECK_EQUAL(schedule.getWells(last_step).size(), input.schedule.getWells(last_step).size());
+    }
+
+    // a truncated file, and a file which is not a snapshot
+    const auto size = Opm::filesystem::file_size(snapshot_file);
+    Opm::filesystem::resize_file(snapshot_file, size - 1);
+    {
+        EclipseState es;
+        Schedule schedule;
+        SummaryConfig summary_config;
+        BOOST_CHECK_THROW(Snapshot::load(snapshot_file, es, schedule, summary_config), std::runtime_error);
+    }
+
+    {
+        std::ofstream stream(snapshot_file);
+        stream << "RUNSPEC\n";
+    }
+    {
+        EclipseState es;
+        Schedule schedule;
+        SummaryConfig summary_config;
+        BOOST_CHECK_THROW(Snapshot::load(snapshot_file, es, schedule, summary_config), std::runtime_error);
+    }
+
+    {
+        EclipseState es;
+        Schedule schedule;
+        SummaryConfig summary_config;
+        BOOST_CHECK_THROW(Snapshot::load("NO_SUCH.SNAPSHOT", es, schedule, summary_config), std::invalid_argument);
+    }
+
+    Opm::filesystem::remove(snapshot_file);
+}
@@ -18,7 +18,11 @@
  */
 
 #define BOOST_TEST_MODULE ParserTests
+#include <cstring>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 
 #include "src/opm/parser/eclipse/Parser/raw/StarToken.hpp"
@@ -125,3 +129,67 @@ BOOST_AUTO_TEST_CASE( readValueToken_basic_validity_tests ) {
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "123*456" ) ) );
     BOOST_CHECK_EQUAL( "123*456", Opm::readValueToken<std::string>( std::string( "'123*456'" ) ) );
 }
+
+BOOST_AUTO_TEST_CASE( readNumberToken_matches_readValueToken ) {
+    const std::vector<std::string> doubles = {
+        "0", "-0", "+0.0", ".5", "5.", "3.3", "-3.3e0", "3.3D-2", "1.0E+05", "1e5",
+        "0.1", "0.12345678901234", "2345.678d3", "1234.5678", "8325.0001", "9.87654321E-290",
+        "1.79769313486231E308", "123456789012345", "-999999999999999E-22"
+    };
+
+    for (const auto& token : doubles) {
+        double value;
+        BOOST_CHECK_MESSAGE( Opm::readNumberToken( Opm::string_view( token ), value ), token );
+        BOOST_CHECK_EQUAL( value, Opm::readValueToken<double>( token ) );
+    }
+
+    for (const std::string token : { "", ".", "-", "1.0.0", "1g0", "1.23h", "1e", "1.0E+", "1e400", "1e-400",
+                                     "1234567890123456", "0.1234567890123456", "9.87654321E-300", "nan", "3*", "'1.0'",
+                                     "816312866551026252", "288406259241508773", "661082255365434063E+6",
+                                     "000032920655302119" }) {
+        double value;
+        BOOST_CHECK_MESSAGE( !Opm::readNumberToken( Opm::string_view( token ), value ), token );
+    }
+
+    // values are bitwise identical to readValueToken(), whether a random
+    // token is taken by the fast path or left to readValueToken()
+
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<int> numDigits( 1, 19 );
+    std::uniform_int_distribution<int> digit( 0, 9 );
+    std::uniform_int_distribution<int> exponent( -300, 300 );
+
+    for (int i = 0; i < 100000; ++i) {
+        std::string token;
+        const int n = numDigits( gen );
+        const int dot = std::uniform_int_distribution<int>( 0, n )( gen );
+
+        for (int d = 0; d < n; ++d) {
+            if (d == dot)
+                token += '.';
+
+            token += static_cast<char>( '0' + digit( gen ) );
+        }
+
+        if (i % 2 == 1)
+            token += "E" + std::to_string( exponent( gen ) );
+
+        double value;
+        if (!Opm::readNumberToken( Opm::string_view( token ), value ))
+            value = Opm::readValueToken<double>( token );
+
+        const double expected = Opm::readValueToken<double>( token );
+        BOOST_CHECK_MESSAGE( std::memcmp( &value, &expected, sizeof value ) == 0, token );
+    }
+
+    for (const std::string token : { "0", "-17", "+17", "123456789" }) {
+        int value;
+        BOOST_CHECK( Opm::readNumberToken( Opm::string_view( token ), value ) );
+        BOOST_CHECK_EQUAL( value, Opm::readValueToken<int>( token ) );
+    }
+
+    for (const std::string token : { "", "-", "1.0", "1234567890", "12a" }) {
+        int value;
+        BOOST_CHECK( !Opm::readNumberToken( Opm::string_view( token ), value ) );
+    }
+}
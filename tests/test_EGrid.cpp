@@ -20,6 +20,7 @@
 #include "config.h"
 
 #include <opm/io/eclipse/EGrid.hpp>
+#include <opm/common/utility/numeric/calculateCellVol.hpp>
 
 #define BOOST_TEST_MODULE Test EGrid
 #include <boost/test/unit_test.hpp>
@@ -31,6 +32,7 @@
 #include <iostream>
 #include <iomanip>
 #include <math.h>
+#include <numeric>
 #include <stdio.h>
 #include <tuple>
 
@@ -185,3 +187,41 @@ BOOST_AUTO_TEST_CASE(getCellCorners) {
     BOOST_CHECK_EQUAL(Y == ref_Y, true);
     BOOST_CHECK_EQUAL(Z == ref_Z, true);
 }
+
+
+BOOST_AUTO_TEST_CASE(getCellGeometry) {
+
+    std::string testFile="SPE1CASE1.EGRID";
+
+    EGrid grid1(testFile);
+
+    const auto geometry = grid1.getCellGeometry();
+
+    BOOST_CHECK_EQUAL(geometry.volume.size(), static_cast<std::size_t>(grid1.activeCells()));
+
+    for (int actInd = 0; actInd < grid1.activeCells(); actInd++) {
+        std::array<double,8> X, Y, Z;
+        grid1.getCellCorners(grid1.ijk_from_active_index(actInd), X, Y, Z);
+
+        for (int c = 0; c < 8; c++) {
+            BOOST_CHECK_CLOSE(geometry.cornerX[c][actInd], X[c], 1e-10);
+            BOOST_CHECK_CLOSE(geometry.cornerY[c][actInd], Y[c], 1e-10);
+            BOOST_CHECK_CLOSE(geometry.cornerZ[c][actInd], Z[c], 1e-10);
+        }
+
+        BOOST_CHECK_CLOSE(geometry.volume[actInd], calculateCellVol(X, Y, Z), 1e-10);
+        BOOST_CHECK_CLOSE(geometry.depth[actInd], ((Z[0]+Z[1]+Z[2]+Z[3])/4.0 + (Z[4]+Z[5]+Z[6]+Z[7])/4.0) / 2.0, 1e-10);
+        BOOST_CHECK_CLOSE(geometry.centerX[actInd], std::accumulate(X.begin(), X.end(), 0.0) / 8.0, 1e-10);
+    }
+
+    // subset of cells, only requested quantities are calculated
+
+    const auto subset = grid1.getCellGeometry(10, 20, Opm::CellGeometry::Volumes);
+
+    BOOST_CHECK_EQUAL(subset.volume.size(), 10);
+    BOOST_CHECK(subset.depth.empty());
+    BOOST_CHECK(subset.cornerX[0].empty());
+    BOOST_CHECK(std::equal(subset.volume.begin(), subset.volume.end(), geometry.volume.begin() + 10));
+
+    BOOST_CHECK_THROW(grid1.getCellGeometry(10, grid1.activeCells() + 1), std::invalid_argument);
+}
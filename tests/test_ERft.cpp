@@ -205,3 +205,76 @@ BOOST_AUTO_TEST_CASE(TestERft_2) {
         std::cout << " > Warning! temporary file was not deleted" << std::endl;
     };
 }
+
+
+BOOST_AUTO_TEST_CASE(TestERft_CacheBudget) {
+
+    std::string testFile="SPE1CASE1.RFT";
+
+    ERft reference(testFile);
+
+    // arrays released to stay within the budget are read again by getRft()
+
+    OpenOptions options;
+    options.cacheBudget = 64;
+
+    ERft rft1(testFile, options);
+
+    BOOST_CHECK(rft1.cacheStatistics().evictions > 0);
+
+    for (const auto& rft : reference.listOfRftReports()) {
+        const auto& wellName = std::get<0>(rft);
+        const auto& date = std::get<1>(rft);
+
+        for (const auto& array : reference.listOfRftArrays(wellName, date)) {
+            const auto& arrName = std::get<0>(array);
+
+            switch (std::get<1>(array)) {
+            case INTE:
+                BOOST_CHECK(rft1.getRft<int>(arrName, wellName, date) == reference.getRft<int>(arrName, wellName, date));
+                break;
+            case REAL:
+                BOOST_CHECK(rft1.getRft<float>(arrName, wellName, date) == reference.getRft<float>(arrName, wellName, date));
+                break;
+            case DOUB:
+                BOOST_CHECK(rft1.getRft<double>(arrName, wellName, date) == reference.getRft<double>(arrName, wellName, date));
+                break;
+            case LOGI:
+                BOOST_CHECK(rft1.getRft<bool>(arrName, wellName, date) == reference.getRft<bool>(arrName, wellName, date));
+                break;
+            case CHAR:
+                BOOST_CHECK(rft1.getRft<std::string>(arrName, wellName, date) == reference.getRft<std::string>(arrName, wellName, date));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    BOOST_CHECK(rft1.cacheStatistics().misses > 0);
+
+    // through a const object: an array released by the next load is read
+    // again by the following getRft().  The arrays of well B-2H hold three
+    // values each, the budget leaves room for one of them only.
+
+    options.cacheBudget = 16;
+
+    const ERft rft2(testFile, options);
+    const ERft::RftDate date{2016, 5, 31};
+
+    const std::vector<float> pressure = rft2.getRft<float>("PRESSURE", "B-2H", date);
+    const auto stats1 = rft2.cacheStatistics();
+
+    BOOST_CHECK(rft2.getRft<float>("SGAS", "B-2H", date) == reference.getRft<float>("SGAS", "B-2H", date));
+
+    const auto stats2 = rft2.cacheStatistics();
+    BOOST_CHECK_EQUAL(stats2.evictions, stats1.evictions + 1);
+    BOOST_CHECK_EQUAL(stats2.misses, stats1.misses + 1);
+
+    BOOST_CHECK(rft2.getRft<float>("PRESSURE", "B-2H", date) == pressure);
+    BOOST_CHECK(pressure == reference.getRft<float>("PRESSURE", "B-2H", date));
+
+    const auto stats3 = rft2.cacheStatistics();
+    BOOST_CHECK_EQUAL(stats3.evictions, stats2.evictions + 1);
+    BOOST_CHECK_EQUAL(stats3.misses, stats2.misses + 1);
+}
@@ -34,6 +34,7 @@
 #include <math.h>
 #include <random>
 #include <stdio.h>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include<numeric>
@@ -246,6 +247,160 @@ BOOST_AUTO_TEST_CASE(TestERst_2) {
     };
 }
 
+BOOST_AUTO_TEST_CASE(TestERst_Concurrent) {
+
+    // one ERst object shared by several threads, each thread reading all
+    // report steps in a different order, should give the same arrays as
+    // sequential reading
+
+    std::string testFile="SPE1_TESTCASE.UNRST";
+
+    ERst rst1(testFile);
+    const std::vector<int> seqnums = rst1.listOfReportStepNumbers();
+
+    for (int seqnum : seqnums) {
+        rst1.loadReportStepNumber(seqnum);
+    }
+
+    Opm::EclIO::OpenOptions options;
+    options.keepOpen = true;
+
+    ERst rst2(testFile, options);
+
+    const int nThreads = 4;
+    std::vector<int> failures(nThreads, 0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < nThreads; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<int> order = seqnums;
+            std::rotate(order.begin(), order.begin() + (t * 2) % order.size(), order.end());
+
+            for (int seqnum : order) {
+                if (rst2.getRst<int>("ICON", seqnum, 0) != rst1.getRst<int>("ICON", seqnum, 0))
+                    failures[t]++;
+
+                if (rst2.getRst<float>("PRESSURE", seqnum, 0) != rst1.getRst<float>("PRESSURE", seqnum, 0))
+                    failures[t]++;
+
+                if (rst2.getRst<double>("XGRP", seqnum, 0) != rst1.getRst<double>("XGRP", seqnum, 0))
+                    failures[t]++;
+
+                if (rst2.getRst<std::string>("ZWEL", seqnum, 0) != rst1.getRst<std::string>("ZWEL", seqnum, 0))
+                    failures[t]++;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < nThreads; t++) {
+        BOOST_CHECK_EQUAL(failures[t], 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestERst_Cache) {
+
+    std::string testFile="SPE1_TESTCASE.UNRST";
+
+    ERst rst1(testFile);
+
+    // SEQNUM arrays are loaded when the file is opened
+
+    const auto initial = rst1.cacheStatistics();
+
+    // unloading report step releases its arrays, which are loaded again on demand
+
+    rst1.loadReportStepNumber(5);
+
+    const auto pressure = rst1.getRst<float>("PRESSURE", 5, 0);
+    auto stats = rst1.cacheStatistics();
+
+    BOOST_CHECK(stats.bytesResident >= initial.bytesResident + pressure.size() * sizeof(float));
+    BOOST_CHECK_EQUAL(stats.hits, initial.hits + 1);
+    BOOST_CHECK_EQUAL(stats.misses, initial.misses);
+
+    rst1.unloadReportStep(5);
+    BOOST_CHECK(rst1.cacheStatistics().bytesResident < initial.bytesResident);
+
+    BOOST_CHECK(rst1.getRst<float>("PRESSURE", 5, 0) == pressure);
+
+    stats = rst1.cacheStatistics();
+    BOOST_CHECK_EQUAL(stats.misses, initial.misses + 1);
+
+    BOOST_CHECK_THROW(rst1.unloadReportStep(4), std::invalid_argument);
+
+    // memory held by loaded arrays stays within budget
+
+    Opm::EclIO::OpenOptions options;
+    options.cacheBudget = 4 * pressure.size() * sizeof(float);
+
+    ERst rst2(testFile, options);
+    const auto initial2 = rst2.cacheStatistics();
+
+    for (int seqnum : rst2.listOfReportStepNumbers()) {
+        rst1.loadReportStepNumber(seqnum);
+
+        BOOST_CHECK(*rst2.getRstShared<float>("PRESSURE", seqnum, 0) == rst1.getRst<float>("PRESSURE", seqnum, 0));
+        BOOST_CHECK(*rst2.getRstShared<float>("SWAT", seqnum, 0) == rst1.getRst<float>("SWAT", seqnum, 0));
+        BOOST_CHECK(*rst2.getRstShared<int>("ICON", seqnum, 0) == rst1.getRst<int>("ICON", seqnum, 0));
+
+        BOOST_CHECK(rst2.cacheStatistics().bytesResident <= options.cacheBudget);
+    }
+
+    stats = rst2.cacheStatistics();
+    BOOST_CHECK(stats.evictions > 0);
+    BOOST_CHECK_EQUAL(stats.hits, initial2.hits);
+    BOOST_CHECK_EQUAL(stats.misses, initial2.misses + 3 * rst2.listOfReportStepNumbers().size());
+}
+
+BOOST_AUTO_TEST_CASE(TestERst_CacheEviction) {
+
+    std::string testFile="SPE1_TESTCASE.UNRST";
+
+    ERst reference(testFile);
+    const auto& reportSteps = reference.listOfReportStepNumbers();
+
+    for (int seqnum : reportSteps)
+        reference.loadReportStepNumber(seqnum);
+
+    const std::vector<float> pressure0 = reference.getRst<float>("PRESSURE", reportSteps.front(), 0);
+
+    Opm::EclIO::OpenOptions options;
+    options.cacheBudget = 2 * pressure0.size() * sizeof(float);
+
+    ERst rst(testFile, options);
+
+    // a handle from getRstShared() outlives the cache entry
+
+    const auto handle = rst.getRstShared<float>("SWAT", reportSteps.front(), 0);
+
+    // arrays read through getRst() are released to stay within the budget
+
+    for (int seqnum : reportSteps) {
+        for (const auto& name : {"PRESSURE", "SWAT", "SGAS", "RS"}) {
+            BOOST_CHECK(rst.getRst<float>(name, seqnum, 0) == reference.getRst<float>(name, seqnum, 0));
+            BOOST_CHECK(rst.cacheStatistics().bytesResident <= options.cacheBudget);
+        }
+    }
+
+    BOOST_CHECK(rst.cacheStatistics().evictions > 0);
+    BOOST_CHECK(*handle == reference.getRst<float>("SWAT", reportSteps.front(), 0));
+
+    // the most recently used array is served from memory
+
+    const auto misses = rst.cacheStatistics().misses;
+    const auto& pressure = rst.getRst<float>("PRESSURE", reportSteps.front(), 0);
+    BOOST_CHECK(&rst.getRst<float>("PRESSURE", reportSteps.front(), 0) == &pressure);
+    BOOST_CHECK_EQUAL(rst.cacheStatistics().misses, misses + 1);
+    BOOST_CHECK(pressure == pressure0);
+
+    rst.unloadReportStep(reportSteps.front());
+    BOOST_CHECK(rst.cacheStatistics().bytesResident <= options.cacheBudget);
+}
+
 BOOST_AUTO_TEST_CASE(TestERst_3) {
 
     std::string testFile="SPE1_TESTCASE.FUNRST";
@@ -24,15 +24,23 @@
 #include <boost/test/unit_test.hpp>
 
 #include <opm/io/eclipse/EclFile.hpp>
+#include <opm/io/eclipse/EclOutput.hpp>
 
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <math.h>
+#include <memory>
+#include <sstream>
 #include <stdio.h>
+#include <thread>
 #include <tuple>
 
+#include <opm/common/utility/FileSystem.hpp>
+
+#include "WorkArea.cpp"
+
 using Opm::EclIO::ESmry;
 
 template<typename InputIterator1, typename InputIterator2>
@@ -353,6 +361,269 @@ BOOST_AUTO_TEST_CASE(TestESmry_4) {
 
 
 
+BOOST_AUTO_TEST_CASE(TestESmry_LazyLoading) {
+
+    // vectors loaded one by one, in a single batch and from a memory mapped
+    // file should all be identical, also when base run data is involved
+
+    std::vector<std::string> vectList = {"TIME", "WGPR:PROD", "WBHP:INJ", "FGOR", "BPR:10,10,3"};
+
+    for (bool loadBaseRunData : {false, true}) {
+        ESmry smry1("SPE1CASE1_RST60.SMSPEC", loadBaseRunData);
+
+        ESmry smry2("SPE1CASE1_RST60.SMSPEC", loadBaseRunData);
+        smry2.loadData(vectList);
+
+        ESmry smry3("SPE1CASE1_RST60.SMSPEC", loadBaseRunData, Opm::EclIO::OpenOptions{true});
+
+        for (const auto& key : vectList) {
+            BOOST_CHECK(smry1.get(key) == smry2.get(key));
+            BOOST_CHECK(smry1.get(key) == smry3.get(key));
+        }
+
+        BOOST_CHECK(smry1.get_at_rstep("TIME") == smry3.get_at_rstep("TIME"));
+    }
+
+    ESmry smry4("SPE1CASE1.SMSPEC");
+    BOOST_CHECK_THROW(smry4.loadData({"TIME", "NO_SUCH_KEY"}), std::invalid_argument);
+
+    smry4.loadData();
+    BOOST_CHECK_EQUAL(smry4.get("TIME").size(), smry4.get("WOPR:PROD").size());
+}
+
+
+BOOST_AUTO_TEST_CASE(TestESmry_CacheFile) {
+
+    std::vector<std::string> vectList = {"TIME", "WGPR:PROD", "WBHP:INJ", "FGOR", "BPR:10,10,3"};
+
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    ESmry smry1("SPE1CASE1.SMSPEC");
+    BOOST_CHECK(!smry1.usesCacheFile());
+
+    smry1.get("FGOR");
+    smry1.writeCacheFile();
+
+    BOOST_CHECK(Opm::filesystem::exists("SPE1CASE1.ESMRY"));
+
+    {
+        ESmry smry2("SPE1CASE1.SMSPEC");
+        BOOST_CHECK(smry2.usesCacheFile());
+
+        for (const auto& key : smry1.keywordList()) {
+            BOOST_CHECK(smry1.get(key) == smry2.get(key));
+        }
+
+        BOOST_CHECK(smry1.get_at_rstep("TIME") == smry2.get_at_rstep("TIME"));
+        BOOST_CHECK_EQUAL(smry1.timestepIdxAtReportstepStart(10), smry2.timestepIdxAtReportstepStart(10));
+    }
+
+    // cache file is ignored when source files are modified after the cache was written
+
+    const auto cacheTime = Opm::filesystem::last_write_time("SPE1CASE1.ESMRY");
+    Opm::filesystem::last_write_time("SPE1CASE1.UNSMRY", cacheTime + std::chrono::seconds(10));
+
+    {
+        ESmry smry3("SPE1CASE1.SMSPEC", false, Opm::EclIO::OpenOptions{}, false);
+        BOOST_CHECK(!smry3.usesCacheFile());
+        BOOST_CHECK(smry1.get("WBHP:INJ") == smry3.get("WBHP:INJ"));
+        BOOST_CHECK(Opm::filesystem::last_write_time("SPE1CASE1.ESMRY") == cacheTime);
+    }
+
+    // and rewritten by default, after which it is used again
+
+    {
+        ESmry smry3("SPE1CASE1.SMSPEC");
+        BOOST_CHECK(smry3.usesCacheFile());
+        BOOST_CHECK(smry1.get("WBHP:INJ") == smry3.get("WBHP:INJ"));
+
+        // only the renamed file is left behind
+        for (const auto& entry : Opm::filesystem::directory_iterator(".")) {
+            BOOST_CHECK_MESSAGE(entry.path().extension() != ".tmp", entry.path().string());
+        }
+    }
+
+    ESmry smry4("SPE1CASE1.SMSPEC");
+    BOOST_CHECK(smry4.usesCacheFile());
+    BOOST_CHECK(smry1.get("BPR:10,10,3") == smry4.get("BPR:10,10,3"));
+}
+
+
+BOOST_AUTO_TEST_CASE(TestESmry_CompressedData) {
+
+    using namespace Opm::EclIO;
+
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    ESmry smry1("SPE1CASE1.SMSPEC");
+    smry1.loadData();
+
+    // same summary data with every array compressed, as by convertECL -c
+
+    {
+        EclFile input("SPE1CASE1.UNSMRY");
+        EclOutput output("SPE1CASE1.UNSMRY.tmp", false, std::ios::out, true);
+
+        const auto arrays = input.getList();
+
+        for (std::size_t i = 0; i < arrays.size(); i++) {
+            const auto& name = std::get<0>(arrays[i]);
+
+            switch (std::get<1>(arrays[i])) {
+            case INTE:
+                output.write(name, input.get<int>(i));
+                break;
+            case REAL:
+                output.write(name, input.get<float>(i));
+                break;
+            default:
+                BOOST_FAIL("Unexpected array type in summary file");
+            }
+        }
+    }
+
+    Opm::filesystem::rename("SPE1CASE1.UNSMRY.tmp", "SPE1CASE1.UNSMRY");
+    BOOST_REQUIRE(EclFile("SPE1CASE1.UNSMRY").compressedInput());
+
+    ESmry smry2("SPE1CASE1.SMSPEC");
+
+    BOOST_CHECK(smry2.get("FOPR") == smry1.get("FOPR"));
+    BOOST_CHECK(smry2.get("FOPR").back() > 0.0f);
+
+    for (const auto& key : smry1.keywordList()) {
+        BOOST_CHECK_MESSAGE(smry1.get(key) == smry2.get(key), key);
+    }
+
+    BOOST_CHECK(smry1.get_at_rstep("WBHP:INJ") == smry2.get_at_rstep("WBHP:INJ"));
+
+    // the transposed file is written from the decompressed values
+
+    smry2.writeCacheFile();
+
+    ESmry smry3("SPE1CASE1.SMSPEC");
+    BOOST_CHECK(smry3.usesCacheFile());
+    BOOST_CHECK(smry1.get("WBHP:INJ") == smry3.get("WBHP:INJ"));
+}
+
+
+BOOST_AUTO_TEST_CASE(TestESmry_ConcurrentGet) {
+
+    // vectors loaded on first access by several threads at once, each
+    // thread visiting the keywords in a different order, should be
+    // identical to the vectors loaded by a single thread
+
+    using namespace Opm::EclIO;
+
+    ESmry smry1("SPE1CASE1.SMSPEC");
+    smry1.loadData();
+
+    const auto& keys = smry1.keywordList();
+
+    for (bool useCacheFile : {false, true}) {
+        WorkArea work;
+        work.copyIn("SPE1CASE1.SMSPEC");
+        work.copyIn("SPE1CASE1.UNSMRY");
+
+        if (useCacheFile) {
+            ESmry("SPE1CASE1.SMSPEC").writeCacheFile();
+        }
+
+        ESmry smry2("SPE1CASE1.SMSPEC");
+        BOOST_CHECK(smry2.usesCacheFile() == useCacheFile);
+
+        const int nThreads = 4;
+        std::vector<int> failures(nThreads, 0);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < nThreads; t++) {
+            threads.emplace_back([&, t]() {
+                std::vector<std::string> order = keys;
+                std::rotate(order.begin(), order.begin() + (t * order.size()) / nThreads, order.end());
+
+                for (const auto& key : order) {
+                    if (smry2.get(key) != smry1.get(key))
+                        failures[t]++;
+                }
+
+                smry2.loadData({"FOPR", "WBHP:INJ", "TIME"});
+
+                if (smry2.get("FOPR") != smry1.get("FOPR"))
+                    failures[t]++;
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (int t = 0; t < nThreads; t++) {
+            BOOST_CHECK_EQUAL(failures[t], 0);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestESmry_MultipleFiles) {
+
+    // split unified summary file into one non-unified file per report step,
+    // summary data read from the (concurrently loaded) non-unified files
+    // should be identical to the unified data
+
+    std::vector<std::string> vectList = {"TIME", "WGPR:PROD", "WBHP:INJ", "FGOR", "BPR:10,10,3"};
+
+    ESmry smry1("SPE1CASE1.SMSPEC");
+    smry1.loadData(vectList);
+
+    WorkArea work;
+    work.copyIn("SPE1CASE1.SMSPEC");
+    work.copyIn("SPE1CASE1.UNSMRY");
+
+    {
+        Opm::EclIO::EclFile unsmry("SPE1CASE1.UNSMRY");
+        unsmry.loadData();
+
+        const auto arrayList = unsmry.getList();
+
+        std::unique_ptr<Opm::EclIO::EclOutput> output;
+        int reportStep = 0;
+
+        for (size_t n = 0; n < arrayList.size(); n++) {
+            const std::string& name = std::get<0>(arrayList[n]);
+
+            if (name == "SEQHDR") {
+                std::ostringstream fileName;
+                fileName << "SPE1CASE1.S" << std::setw(4) << std::setfill('0') << ++reportStep;
+                output = std::make_unique<Opm::EclIO::EclOutput>(fileName.str(), false);
+            }
+
+            if (std::get<1>(arrayList[n]) == Opm::EclIO::REAL) {
+                output->write(name, unsmry.get<float>(n));
+            } else {
+                output->write(name, unsmry.get<int>(n));
+            }
+        }
+
+        BOOST_CHECK(reportStep > 1);
+    }
+
+    Opm::filesystem::remove("SPE1CASE1.UNSMRY");
+
+    for (bool memoryMap : {false, true}) {
+        ESmry smry2("SPE1CASE1.SMSPEC", false, Opm::EclIO::OpenOptions{memoryMap});
+
+        for (const auto& key : vectList) {
+            BOOST_CHECK(smry1.get(key) == smry2.get(key));
+        }
+
+        BOOST_CHECK(smry1.get_at_rstep("TIME") == smry2.get_at_rstep("TIME"));
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(TestUnits) {
     ESmry smry("SPE1CASE1.SMSPEC");
 
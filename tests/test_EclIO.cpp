@@ -24,14 +24,21 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <cmath>
+#include <cstring>
 #include <numeric>
+#include <thread>
+#include <vector>
 
 #include <opm/io/eclipse/EclFile.hpp>
 #include <opm/io/eclipse/EclUtil.hpp>
 #include "WorkArea.cpp"
+#include "src/opm/io/eclipse/FormattedNumbers.hpp"
 
 #include <opm/io/eclipse/EclOutput.hpp>
 
@@ -88,6 +95,53 @@ void write_header(std::ofstream& ofileH, std::string& arrName, int size, std::st
 }
 
 
+BOOST_AUTO_TEST_CASE(TestEclUtil_flipEndian) {
+
+    // bulk conversion should match the scalar helpers for any length,
+    // including tails not filling a complete SIMD register
+
+    for (std::size_t num : {0, 1, 3, 7, 8, 9, 17, 1000, 1003}) {
+        std::vector<int> ivect(num);
+        std::vector<float> fvect(num);
+        std::vector<double> dvect(num);
+
+        for (std::size_t i = 0; i < num; i++) {
+            ivect[i] = static_cast<int>(i * 2654435761u);
+            fvect[i] = 1.5f * i - 100.0f;
+            dvect[i] = -3.25 * i + 1.0e10;
+        }
+
+        std::vector<int> iflip(num);
+        std::vector<float> fflip(num);
+        std::vector<double> dflip(num);
+
+        flipEndian(ivect.data(), iflip.data(), num);
+        flipEndian(fvect.data(), fflip.data(), num);
+        flipEndian(dvect.data(), dflip.data(), num);
+
+        for (std::size_t i = 0; i < num; i++) {
+            BOOST_CHECK_EQUAL(iflip[i], flipEndianInt(ivect[i]));
+
+            float fref = flipEndianFloat(fvect[i]);
+            double dref = flipEndianDouble(dvect[i]);
+
+            BOOST_CHECK_EQUAL(std::memcmp(&fflip[i], &fref, sizeof(float)), 0);
+            BOOST_CHECK_EQUAL(std::memcmp(&dflip[i], &dref, sizeof(double)), 0);
+        }
+
+        // in place conversion twice restores original values
+
+        flipEndian(iflip.data(), num);
+        flipEndian(fflip.data(), num);
+        flipEndian(dflip.data(), num);
+
+        BOOST_CHECK(iflip == ivect);
+        BOOST_CHECK(fflip == fvect);
+        BOOST_CHECK(dflip == dvect);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(TestEclFile_X231) {
 
     std::string filename = "TEST.DAT";
@@ -238,6 +292,164 @@ BOOST_AUTO_TEST_CASE(TestEclFile_FORMATTED) {
 
 }
 
+BOOST_AUTO_TEST_CASE(TestEclFile_MemoryMapped) {
+
+    std::string testFile="ECLFILE.INIT";
+
+    // arrays decoded from a memory mapped file should be identical
+    // to arrays read through a file stream
+
+    EclFile file1(testFile);
+    file1.loadData();
+
+    EclFile file2(testFile, OpenOptions{true});
+
+    BOOST_CHECK(!file1.memoryMapped());
+    BOOST_CHECK(file2.memoryMapped());
+
+    BOOST_CHECK_EQUAL(file1.size(), file2.size());
+    BOOST_CHECK(file1.arrayNames() == file2.arrayNames());
+
+    BOOST_CHECK(file1.get<int>("ICON") == file2.get<int>("ICON"));
+    BOOST_CHECK(file1.get<bool>("LOGIHEAD") == file2.get<bool>("LOGIHEAD"));
+    BOOST_CHECK(file1.get<float>("PORV") == file2.get<float>("PORV"));
+    BOOST_CHECK(file1.get<double>("XCON") == file2.get<double>("XCON"));
+    BOOST_CHECK(file1.get<std::string>("KEYWORDS") == file2.get<std::string>("KEYWORDS"));
+
+    // zero-copy views
+
+    auto icon = file2.getMapped<int>("ICON");
+    auto porv = file2.getMapped<float>(2);
+    auto xcon = file2.getMapped<double>("XCON");
+
+    BOOST_CHECK_EQUAL(icon.size(), 1875);
+    BOOST_CHECK_EQUAL(porv.size(), 3146);
+    BOOST_CHECK_EQUAL(xcon.size(), 1740);
+
+    BOOST_CHECK(icon.toVector() == file1.get<int>("ICON"));
+    BOOST_CHECK(porv.toVector() == file1.get<float>("PORV"));
+    BOOST_CHECK(xcon.toVector() == file1.get<double>("XCON"));
+
+    BOOST_CHECK_EQUAL(porv[1500], file1.get<float>("PORV")[1500]);
+
+    BOOST_CHECK_THROW(file2.getMapped<float>("ICON"), std::runtime_error);
+    BOOST_CHECK_THROW(file2.getMapped<int>("XXXX"), std::invalid_argument);
+    BOOST_CHECK_THROW(file1.getMapped<int>("ICON"), std::runtime_error);
+
+    // formatted files are always read through a stream
+
+    EclFile file3("ECLFILE.FINIT", OpenOptions{true});
+    BOOST_CHECK(!file3.memoryMapped());
+    BOOST_CHECK(file3.get<int>("ICON") == file1.get<int>("ICON"));
+}
+
+BOOST_AUTO_TEST_CASE(TestEclFile_IndexFile) {
+
+    WorkArea work;
+    work.copyIn("ECLFILE.INIT");
+    work.copyIn("ECLFILE.FINIT");
+
+    OpenOptions options;
+    options.useIndexFile = true;
+
+    EclFile file1("ECLFILE.INIT");
+    file1.loadData();
+
+    BOOST_CHECK(!Opm::filesystem::exists("ECLFILE.INIT.idx"));
+
+    {
+        EclFile file2("ECLFILE.INIT", options);
+        BOOST_CHECK(Opm::filesystem::exists("ECLFILE.INIT.idx"));
+        BOOST_CHECK(file1.getList() == file2.getList());
+    }
+
+    // header information taken from index file
+
+    for (bool memoryMap : {false, true}) {
+        options.memoryMap = memoryMap;
+
+        EclFile file3("ECLFILE.INIT", options);
+
+        BOOST_CHECK(file1.getList() == file3.getList());
+        BOOST_CHECK(file1.get<int>("ICON") == file3.get<int>("ICON"));
+        BOOST_CHECK(file1.get<float>("PORV") == file3.get<float>("PORV"));
+        BOOST_CHECK(file1.get<std::string>("KEYWORDS") == file3.get<std::string>("KEYWORDS"));
+    }
+
+    options.memoryMap = false;
+
+    // arrays appended to the file are added to the index
+
+    const auto indexSize = Opm::filesystem::file_size("ECLFILE.INIT.idx");
+    const std::vector<double> newArray = {1.0, 2.0, 3.0};
+
+    {
+        EclOutput output("ECLFILE.INIT", false, std::ios::app);
+        output.write("NEWARR", newArray);
+    }
+
+    {
+        EclFile file4("ECLFILE.INIT", options);
+
+        BOOST_CHECK_EQUAL(file4.size(), file1.size() + 1);
+        BOOST_CHECK(file4.get<double>("NEWARR") == newArray);
+        BOOST_CHECK(file4.get<int>("ICON") == file1.get<int>("ICON"));
+        BOOST_CHECK(Opm::filesystem::file_size("ECLFILE.INIT.idx") > indexSize);
+    }
+
+    // file rewritten, index is rebuilt
+
+    {
+        EclOutput output("ECLFILE.INIT", false);
+        output.write("NEWARR", newArray);
+    }
+
+    {
+        EclFile file5("ECLFILE.INIT", options);
+
+        BOOST_CHECK_EQUAL(file5.size(), 1);
+        BOOST_CHECK(file5.get<double>("NEWARR") == newArray);
+    }
+
+    EclFile file6("ECLFILE.FINIT", options);
+    EclFile file7("ECLFILE.FINIT", options);
+
+    BOOST_CHECK(Opm::filesystem::exists("ECLFILE.FINIT.idx"));
+    BOOST_CHECK(file6.getList() == file7.getList());
+    BOOST_CHECK(file7.get<int>("ICON") == file1.get<int>("ICON"));
+
+    // index written by several threads at once, each under its own
+    // temporary name
+
+    Opm::filesystem::remove("ECLFILE.FINIT.idx");
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            EclFile file8("ECLFILE.FINIT", options);
+
+            if (file8.getList() != file6.getList())
+                failures[t]++;
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_CHECK(std::all_of(failures.begin(), failures.end(), [](int n) { return n == 0; }));
+    BOOST_CHECK(Opm::filesystem::exists("ECLFILE.FINIT.idx"));
+
+    for (const auto& entry : Opm::filesystem::directory_iterator(".")) {
+        BOOST_CHECK_MESSAGE(entry.path().extension() != ".tmp", entry.path().string());
+    }
+
+    EclFile file9("ECLFILE.FINIT", options);
+    BOOST_CHECK(file9.getList() == file6.getList());
+}
+
 BOOST_AUTO_TEST_CASE(TestEcl_Write_binary) {
 
     std::string inputFile="ECLFILE.INIT";
@@ -333,6 +545,192 @@ BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_not_finite) {
 }
 
 
+BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_exponents) {
+    WorkArea wa;
+    std::vector<double> double_vector{1.0, -0.5, 1.0e-100, -1.234e+150, 0.0, 3.0e-310};
+    std::vector<float> float_vector{1.0f, -2.5e-30f, 7.0e+30f, 0.0f};
+    std::vector<int> int_vector{0, -1, 2147483647, -2147483647};
+
+    {
+        EclOutput testfile("TEST.FINIT", true);
+        testfile.write("DOUBLE", double_vector);
+        testfile.write("FLOAT", float_vector);
+        testfile.write("INT", int_vector);
+    }
+
+    // values written with D exponent and with three digit exponents (no
+    // exponent character) must be read back unchanged
+
+    EclFile file1("TEST.FINIT");
+    file1.loadData();
+
+    const auto& d = file1.get<double>("DOUBLE");
+    const auto& f = file1.get<float>("FLOAT");
+
+    BOOST_CHECK_EQUAL(d.size(), double_vector.size());
+
+    for (std::size_t i = 0; i < double_vector.size(); i++)
+        BOOST_CHECK_CLOSE(d[i], double_vector[i], 1e-10);
+
+    BOOST_CHECK_EQUAL(f.size(), float_vector.size());
+
+    for (std::size_t i = 0; i < float_vector.size(); i++)
+        BOOST_CHECK_CLOSE(f[i], float_vector[i], 1e-4);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(file1.get<int>("INT").begin(), file1.get<int>("INT").end(),
+                                  int_vector.begin(), int_vector.end());
+}
+
+
+namespace {
+
+// text of REAL and DOUB values worked out from their exact binary values,
+// rounded half to even to 8 and 14 digits: carries into the next power of
+// ten, ties, denormals and DOUB exponents of three digits (exponent
+// character dropped, decided by the exponent in scientific notation as in
+// the previous writer)
+
+const std::vector<std::pair<float, std::string>> realText = {
+    { 0.0f, "0.00000000E+00" },
+    { -1.0f, "-0.10000000E+01" },
+    { 0.1f, "0.10000000E+00" },
+    { -123.456f, "-0.12345600E+03" },
+    { 0.000244140625f, "0.24414062E-03" },
+    { 0.000732421875f, "0.73242188E-03" },
+    { 1.0e-6f, "0.10000000E-05" },
+    { 1.0e12f, "0.10000000E+13" },
+    { 0.99999994f, "0.99999994E+00" },
+    { 3.4028235e38f, "0.34028235E+39" },
+    { -1.17549435e-38f, "-0.11754944E-37" },
+    { 1.0e-45f, "0.14012985E-44" },
+};
+
+const std::vector<std::pair<double, std::string>> doubText = {
+    { 0.0, "0.00000000000000D+00" },
+    { -0.0, "0.00000000000000D+00" },
+    { -0.5, "-0.50000000000000D+00" },
+    { 0.1, "0.10000000000000D+00" },
+    { 0.999999999999999, "0.10000000000000D+01" },
+    { -0.999999999999999, "-0.10000000000000D+01" },
+    { 4.76837158203125e-07, "0.47683715820312D-06" },
+    { -123456.789, "-0.12345678900000D+06" },
+    { 1.234e+150, "0.12340000000000+151" },
+    { -2.5e-150, "-0.25000000000000-149" },
+    { 1.0e-100, "0.10000000000000-99" },
+    { 5.0e+99, "0.50000000000000D+100" },
+    { 1.7976931348623157e+308, "0.17976931348623+309" },
+    { 4.9406564584124654e-324, "0.49406564584125-323" },
+};
+
+template <Opm::EclIO::Formatted::Conversion conversion>
+void checkFormattedNumbers()
+{
+    char text[32];
+
+    for (const auto& [value, expected] : realText) {
+        char* last = Opm::EclIO::Formatted::encodeReal<conversion>(value, text);
+        BOOST_CHECK_EQUAL(std::string(text, last), expected);
+    }
+
+    for (const auto& [value, expected] : doubText) {
+        char* last = Opm::EclIO::Formatted::encodeDoub<conversion>(value, text);
+        BOOST_CHECK_EQUAL(std::string(text, last), expected);
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(TestEcl_Formatted_numbers) {
+
+    // to_chars is used when the compiler supports it for floating point
+    // values, snprintf otherwise.  Both must produce the same text.
+
+    checkFormattedNumbers<Opm::EclIO::Formatted::Conversion::Printf>();
+
+#if HAVE_FLOATING_POINT_CHARCONV
+    checkFormattedNumbers<Opm::EclIO::Formatted::Conversion::Charconv>();
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(TestEcl_Write_formatted_text) {
+    WorkArea wa;
+
+    std::vector<float> reals;
+    std::vector<double> doubs;
+
+    for (const auto& entry : realText)
+        reals.push_back(entry.first);
+
+    for (const auto& entry : doubText)
+        doubs.push_back(entry.first);
+
+    {
+        EclOutput testfile("TEST.FINIT", true);
+        testfile.write("REAL", reals);
+        testfile.write("DOUB", doubs);
+        testfile.write("INTE", std::vector<int>{0, -1, 2147483647, -2147483647, 42, 7, 100});
+    }
+
+    const std::string expected =
+        " 'REAL    '          12 'REAL'\n"
+        "   0.00000000E+00  -0.10000000E+01   0.10000000E+00  -0.12345600E+03\n"
+        "   0.24414062E-03   0.73242188E-03   0.10000000E-05   0.10000000E+13\n"
+        "   0.99999994E+00   0.34028235E+39  -0.11754944E-37   0.14012985E-44\n"
+        " 'DOUB    '          14 'DOUB'\n"
+        "   0.00000000000000D+00   0.00000000000000D+00  -0.50000000000000D+00\n"
+        "   0.10000000000000D+00   0.10000000000000D+01  -0.10000000000000D+01\n"
+        "   0.47683715820312D-06  -0.12345678900000D+06   0.12340000000000+151\n"
+        "  -0.25000000000000-149    0.10000000000000-99  0.50000000000000D+100\n"
+        "   0.17976931348623+309   0.49406564584125-323\n"
+        " 'INTE    '           7 'INTE'\n"
+        "           0          -1  2147483647 -2147483647          42           7\n"
+        "         100\n";
+
+    std::ifstream file("TEST.FINIT", std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    BOOST_CHECK_EQUAL(text, expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(TestEcl_Write_blocks) {
+    WorkArea wa;
+
+    // more than one chunk of writeBlocks(), last chunk partial
+    std::vector<double> values(130001);
+
+    for (std::size_t i = 0; i < values.size(); i++)
+        values[i] = 1.0e5 * std::sin(static_cast<double>(i));
+
+    for (const bool formatted : { false, true }) {
+        {
+            EclOutput testfile("TEST1.DAT", formatted);
+            testfile.write("DOUB", values);
+            testfile.write("REAL", std::vector<float>(values.begin(), values.end()));
+        }
+
+        {
+            EclOutput testfile("TEST2.DAT", formatted);
+
+            testfile.writeBlocks<double>("DOUB", values.size(),
+                [&values](std::size_t first, std::size_t num, double* dst)
+                {
+                    std::copy(values.begin() + first, values.begin() + first + num, dst);
+                });
+
+            testfile.writeBlocks<float>("REAL", values.size(),
+                [&values](std::size_t first, std::size_t num, float* dst)
+                {
+                    for (std::size_t i = 0; i < num; i++)
+                        dst[i] = static_cast<float>(values[first + i]);
+                });
+        }
+
+        BOOST_CHECK_EQUAL(compare_files("TEST1.DAT", "TEST2.DAT"), true);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(TestEcl_getList) {
 
     std::string inputFile="ECLFILE.INIT";
@@ -46,6 +46,7 @@
 #include <numeric>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <time.h>
@@ -276,7 +277,7 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
         "'PROD' 'G' 3 3 1000 'OIL' /\n"
         "/\n";
 
-    auto write_and_check = [&]( int first = 1, int last = 5 ) {
+    auto write_and_check = [&]( int first = 1, int last = 5, std::size_t asyncQueue = 0 ) {
         auto deck = Parser().parseString( deckString);
         auto es = EclipseState( deck );
         auto& eclGrid = es.getInputGrid();
@@ -286,6 +287,8 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
         es.getIOConfig().setBaseName( "FOO" );
 
         EclipseIO eclWriter( es, eclGrid , schedule, summary_config);
+        if (asyncQueue > 0)
+            eclWriter.enableAsyncOutput( asyncQueue );
 
         using measure = UnitSystem::measure;
         using TargetType = data::TargetType;
@@ -324,9 +327,21 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
                                      i,
                                      false,
                                      first_step - start_time,
-                                     restart_value);
+                                     std::move(restart_value));
 
-            checkRestartFile( i );
+            if (asyncQueue == 0)
+                checkRestartFile( i );
+        }
+
+        if (asyncQueue > 0) {
+            eclWriter.flush();
+
+            const auto stats = eclWriter.asyncOutputStatistics();
+            BOOST_CHECK_EQUAL( stats.submitted, static_cast<std::size_t>(last - first) );
+            BOOST_CHECK_EQUAL( stats.completed, stats.submitted );
+            BOOST_CHECK( stats.maxQueued <= asyncQueue );
+
+            checkRestartFile( last - 1 );
         }
 
         checkInitFile( deck , eGridProps);
@@ -378,4 +393,70 @@ BOOST_AUTO_TEST_CASE(EclipseIOIntegration) {
      * the file
      */
     BOOST_CHECK_EQUAL( file_size, write_and_check( 3, 5 ) );
+
+    /* output written by the background writer is identical */
+    BOOST_CHECK_EQUAL( file_size, write_and_check( 1, 5, 1 ) );
+    BOOST_CHECK( file_size < write_and_check( 3, 7, 2 ) );
+}
+
+BOOST_AUTO_TEST_CASE(EclipseIOFlushSummary) {
+    const char *deckString =
+        "RUNSPEC\n"
+        "UNIFOUT\n"
+        "OIL\n"
+        "METRIC\n"
+        "DIMENS\n"
+        "3 3 3/\n"
+        "GRID\n"
+        "DXV\n"
+        "1.0 2.0 3.0 /\n"
+        "DYV\n"
+        "4.0 5.0 6.0 /\n"
+        "DZV\n"
+        "7.0 8.0 9.0 /\n"
+        "TOPS\n"
+        "9*100 /\n"
+        "PORO \n"
+        "  27*0.15 /\n"
+        "SUMMARY\n"
+        "FOPR\n"
+        "SCHEDULE\n"
+        "TSTEP\n"
+        "1.0 2.0 3.0 /\n";
+
+    const auto ministeps = [](const std::string& file_name) {
+        EclIO::EclFile file(file_name);
+        const auto arrays = file.getList();
+        return std::count_if(arrays.begin(), arrays.end(),
+                             [](const EclIO::EclFile::EclEntry& entry) { return std::get<0>(entry) == "PARAMS"; });
+    };
+
+    WorkArea work_area("test_ecl_writer_flush");
+
+    for (const std::size_t asyncQueue : { 0, 2 }) {
+        auto deck = Parser().parseString( deckString );
+        auto es = EclipseState( deck );
+        Schedule schedule(deck, es);
+        SummaryConfig summary_config( deck, schedule, es.getTableManager( ));
+        SummaryState st(std::chrono::system_clock::now());
+        es.getIOConfig().setBaseName( "FOO" );
+
+        EclipseIO eclWriter( es, es.getInputGrid(), schedule, summary_config );
+        if (asyncQueue > 0)
+            eclWriter.enableAsyncOutput( asyncQueue );
+
+        auto policy = out::Summary::FlushPolicy{};
+        policy.ministeps = 10;
+        eclWriter.setSummaryFlushPolicy( policy );
+        eclWriter.writeInitial( );
+
+        for (int step = 1; step <= 2; ++step) {
+            RestartValue restart_value(createBlackoilState( step, 3 * 3 * 3 ), data::Wells{});
+            eclWriter.writeTimeStep( st, step, false, step * 86400.0, std::move(restart_value) );
+        }
+
+        // the policy holds the ministeps back until they are flushed
+        eclWriter.flush();
+        BOOST_CHECK_EQUAL( ministeps("FOO.UNSMRY"), 2 );
+    }
 }
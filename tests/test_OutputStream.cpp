@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "config.h"
+
 #define BOOST_TEST_MODULE OutputStream
 
 #include <boost/test/unit_test.hpp>
@@ -32,6 +34,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <ctime>
 #include <iterator>
 #include <ostream>
@@ -1086,6 +1089,109 @@ BOOST_AUTO_TEST_CASE(Formatted_Separate)
     }
 }
 
+#if HAVE_ZLIB
+BOOST_AUTO_TEST_CASE(Compressed_Unified)
+{
+    const auto rset = RSet("CASE");
+    const auto fmt  = ::Opm::EclIO::OutputStream::Formatted { false };
+    const auto unif = ::Opm::EclIO::OutputStream::Unified   { true };
+    const auto comp = ::Opm::EclIO::OutputStream::Compressed{ true };
+
+    // large enough to be compressed in several blocks
+    auto pressure = std::vector<double>(400 * 1000);
+    for (std::size_t i = 0; i < pressure.size(); ++i)
+        pressure[i] = 250.0 + 1.0e-3*i;
+
+    for (const auto seqnum : { 1, 13 }) {
+        auto rst = ::Opm::EclIO::OutputStream::Restart {
+            rset, seqnum, fmt, unif, comp
+        };
+
+        rst.write("I", std::vector<int>        {1, 7, 2, seqnum});
+        rst.write("L", std::vector<bool>       {true, false, false, true});
+        rst.write("Z", std::vector<std::string>{"W1", "W2"});
+        rst.message("STARTSOL");
+        rst.write("PRESSURE", pressure);
+        rst.write("SWAT", pressure.size(),
+                  ::Opm::EclIO::OutputStream::Restart::BlockFill<float> {
+                      [](std::size_t first, std::size_t num, float* dst)
+                      {
+                          for (std::size_t i = 0; i < num; ++i)
+                              dst[i] = 0.5f*((first + i) % 3);
+                      }
+                  });
+        rst.message("ENDSOL");
+    }
+
+    {
+        // Appending uses the compression of the existing file.
+        auto rst = ::Opm::EclIO::OutputStream::Restart {
+            rset, 5, fmt, unif
+        };
+
+        rst.write("I", std::vector<int>{1, 2, 3, 5});
+    }
+
+    const auto fname = ::Opm::EclIO::OutputStream::
+        outputFileName(rset, "UNRST");
+
+    auto rst = ::Opm::EclIO::ERst{fname};
+
+    BOOST_CHECK(rst.compressedInput());
+
+    {
+        const auto seqnum        = rst.listOfReportStepNumbers();
+        const auto expect_seqnum = std::vector<int>{1, 5};
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(seqnum.begin(), seqnum.end(),
+                                      expect_seqnum.begin(),
+                                      expect_seqnum.end());
+    }
+
+    {
+        const auto& I = rst.getRst<int>("I", 5, 0);
+        const auto  expect_I = std::vector<int>{1, 2, 3, 5};
+        BOOST_CHECK_EQUAL_COLLECTIONS(I.begin(), I.end(),
+                                      expect_I.begin(),
+                                      expect_I.end());
+    }
+
+    {
+        const auto& L = rst.getRst<bool>("L", 1, 0);
+        const auto  expect_L = std::vector<bool>{true, false, false, true};
+        BOOST_CHECK_EQUAL_COLLECTIONS(L.begin(), L.end(),
+                                      expect_L.begin(),
+                                      expect_L.end());
+    }
+
+    {
+        const auto& Z = rst.getRst<std::string>("Z", 1, 0);
+        const auto  expect_Z = std::vector<std::string>{"W1", "W2"};
+        BOOST_CHECK_EQUAL_COLLECTIONS(Z.begin(), Z.end(),
+                                      expect_Z.begin(),
+                                      expect_Z.end());
+    }
+
+    {
+        const auto& P = rst.getRst<double>("PRESSURE", 1, 0);
+        BOOST_CHECK_EQUAL_COLLECTIONS(P.begin(), P.end(),
+                                      pressure.begin(),
+                                      pressure.end());
+    }
+
+    {
+        const auto& S = rst.getRst<float>("SWAT", 1, 0);
+        BOOST_REQUIRE_EQUAL(S.size(), pressure.size());
+        BOOST_CHECK_EQUAL(S[0], 0.0f);
+        BOOST_CHECK_EQUAL(S[1], 0.5f);
+        BOOST_CHECK_EQUAL(S.back(), 0.5f*((S.size() - 1) % 3));
+    }
+
+    // compressed data is much smaller than the plain binary arrays
+    BOOST_CHECK(Opm::filesystem::file_size(fname) < pressure.size()*sizeof(double));
+}
+#endif // HAVE_ZLIB
+
 BOOST_AUTO_TEST_SUITE_END() // Class_Restart
 
 // ==========================================================================
@@ -42,8 +42,16 @@
 #include <opm/io/eclipse/EclIOdata.hpp>
 #include <opm/io/eclipse/ERst.hpp>
 
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <tuple>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <opm/common/utility/TimeService.hpp>
 
 #include <tests/WorkArea.cpp>
@@ -924,4 +932,198 @@ BOOST_AUTO_TEST_CASE(Restore_Cumulatives)
 }
 
 
+#ifdef _OPENMP
+
+namespace {
+
+// Deck with enough wells, groups and multi-segment wells for the taskloops
+// of the restart aggregators to be split into several tasks.  Well Wn is
+// horizontal in row J = n, layer 2, and is the only well of group Gn.
+std::string manyWellsDeck(const int numWells, const int numMSW)
+{
+    std::ostringstream deck;
+
+    deck << "RUNSPEC\nOIL\nGAS\nWATER\nDISGAS\nVAPOIL\nUNIFOUT\n"
+         << "DIMENS\n 10 " << numWells << " 3 /\n"
+         << "START\n 1 NOV 1979 /\n"
+         << "WELLDIMS\n " << numWells << " 3 " << numWells << " 2 /\n"
+         << "WSEGDIMS\n " << numMSW << " 4 1 /\n"
+         << "GRID\n"
+         << "DXV\n 10*100 /\nDYV\n " << numWells << "*100 /\nDZV\n 3*10 /\n"
+         << "TOPS\n " << 10 * numWells << "*2000 /\n"
+         << "PORO\n " << 30 * numWells << "*0.2 /\n"
+         << "SOLUTION\n"
+         << "SCHEDULE\n"
+         << "RPTRST\n BASIC=1 /\n";
+
+    deck << "WELSPECS\n";
+    for (int w = 1; w <= numWells; w++)
+        deck << " 'W" << w << "' 'G" << w << "' 1 " << w << " 2015 'OIL' /\n";
+    deck << "/\n";
+
+    deck << "COMPDAT\n";
+    for (int w = 1; w <= numWells; w++)
+        for (int i = 1; i <= 3; i++)
+            deck << " 'W" << w << "' " << i << ' ' << w << " 2 2 'OPEN' 1* 32.948 0.311 3047.839 1* 1* 'X' 22.1 /\n";
+    deck << "/\n";
+
+    deck << "WCONPROD\n";
+    for (int w = 1; w <= numWells; w += 2)
+        deck << " 'W" << w << "' 'OPEN' 'ORAT' 20000 4* 1000 /\n";
+    deck << "/\n";
+
+    deck << "WCONINJE\n";
+    for (int w = 2; w <= numWells; w += 2)
+        deck << " 'W" << w << "' 'WATER' 'OPEN' 'RATE' 100 1* 400 /\n";
+    deck << "/\n";
+
+    for (int w = 1; w <= numMSW; w++) {
+        deck << "WELSEGS\n 'W" << w << "' 2015 0 0.31 'INC' /\n"
+             << " 2 4 1 1 100 0 0.2 1.E-3 1* 1* /\n/\n"
+             << "COMPSEGS\n 'W" << w << "' /\n";
+
+        for (int i = 1; i <= 3; i++)
+            deck << ' ' << i << ' ' << w << " 2 1 " << 100 * (i - 1) << ' ' << 100 * i << " 'X' 3* /\n";
+
+        deck << "/\n";
+    }
+
+    deck << "TSTEP\n 10 /\n";
+
+    return deck.str();
+}
+
+data::Wells manyWellsRates(const Schedule& schedule, const EclipseGrid& grid, const int sim_step)
+{
+    auto xw = data::Wells{};
+    double value = 1.0;
+
+    for (const auto& well : schedule.getWells(sim_step)) {
+        auto& x = xw[well.name()];
+
+        x.rates.set(data::Rates::opt::wat, value++)
+               .set(data::Rates::opt::oil, value++)
+               .set(data::Rates::opt::gas, value++);
+        x.bhp = value++;
+        x.thp = value++;
+
+        for (const auto& conn : well.getConnections()) {
+            x.connections.emplace_back();
+
+            auto& c = x.connections.back();
+            c.index = grid.getGlobalIndex(conn.getI(), conn.getJ(), conn.getK());
+            c.rates.set(data::Rates::opt::wat, value++)
+                   .set(data::Rates::opt::oil, value++)
+                   .set(data::Rates::opt::gas, value++);
+            c.pressure = value++;
+        }
+
+        if (well.isMultiSegment()) {
+            for (std::size_t seg = 1; seg <= 4; seg++) {
+                auto& segment = x.segments[seg];
+                segment.segNumber = seg;
+                segment.pressure = value++;
+                segment.rates.set(data::Rates::opt::oil, value++);
+            }
+        }
+    }
+
+    return xw;
+}
+
+SummaryState manyWellsState(const Schedule& schedule, const int sim_step)
+{
+    auto state = SummaryState{std::chrono::system_clock::now()};
+    double value = 1.0;
+
+    for (const auto& well : schedule.getWells(sim_step)) {
+        for (const auto* vector : {"WOPR", "WWPR", "WGPR", "WOPT", "WWIT", "WBHP"})
+            state.update(std::string(vector) + ':' + well.name(), value++);
+    }
+
+    for (const auto& group : schedule.groupNames(sim_step)) {
+        for (const auto* vector : {"GOPR", "GWPR", "GGPR", "GOPT", "GWIT"})
+            state.update(std::string(vector) + ':' + group, value++);
+    }
+
+    return state;
+}
+
+std::string fileContents(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Concurrent_Aggregates)
+{
+    // The restart aggregates are captured as OpenMP tasks, the wells,
+    // connections, groups and segments of each in taskloops.  Output
+    // written by a team of several threads must be identical to the
+    // output of a single thread.
+
+    namespace OS = ::Opm::EclIO::OutputStream;
+
+    WorkArea wa{"test_Restart"};
+
+    const auto deck = Parser{}.parseString(manyWellsDeck(40, 8));
+
+    EclipseState es(deck);
+    const auto& grid = es.getInputGrid();
+    const Schedule schedule(deck, es);
+
+    es.getIOConfig().setEclCompatibleRST(false);
+
+    const auto seqnum = 1;
+    const auto sim_step = seqnum - 1;
+
+    const auto restart_value = RestartValue {
+        mkSolution(grid.getNumActive()), manyWellsRates(schedule, grid, sim_step)
+    };
+
+    const auto sumState = manyWellsState(schedule, sim_step);
+
+    auto writeRestart = [&](const std::string& baseName, const int numThreads)
+    {
+        const auto rset = OS::ResultSet{ wa.currentWorkingDirectory(), baseName };
+        const auto maxThreads = omp_get_max_threads();
+
+        omp_set_num_threads(numThreads);
+
+        {
+            auto rstFile = OS::Restart {
+                rset, seqnum, OS::Formatted{ false }, OS::Unified{ true }
+            };
+
+            RestartIO::save(rstFile, seqnum, 100, restart_value,
+                            es, grid, schedule, sumState, true);
+        }
+
+        omp_set_num_threads(maxThreads);
+
+        return OS::outputFileName(rset, "UNRST");
+    };
+
+    const auto serialFile = writeRestart("SERIAL", 1);
+
+    {
+        EclIO::ERst rst{ serialFile };
+
+        for (const auto* array : {"IGRP", "IWEL", "ICON", "ISEG", "RSEG", "OPM_XWEL"})
+            BOOST_CHECK_MESSAGE(rst.hasKey(array), "Restart file must have " << array);
+    }
+
+    const auto serial = fileContents(serialFile);
+
+    for (int run = 0; run < 3; run++) {
+        const auto parallelFile = writeRestart("PARALLEL", 4);
+
+        BOOST_CHECK(fileContents(parallelFile) == serial);
+    }
+}
+
+#endif // _OPENMP
+
 }
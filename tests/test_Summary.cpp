@@ -1637,6 +1637,90 @@ BOOST_AUTO_TEST_CASE(Test_SummaryState) {
     BOOST_CHECK_EQUAL(st.num_wells(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(Test_SummaryState_Handles) {
+    Opm::SummaryState st(std::chrono::system_clock::now());
+
+    const auto wwct = st.well_handle("OP1", "WWCT");
+    BOOST_CHECK(!st.has(wwct));
+    BOOST_CHECK(!st.has_well_var("OP1", "WWCT"));
+    BOOST_CHECK(!st.has("WWCT:OP1"));
+    BOOST_CHECK_EQUAL(st.wells().size(), 0);
+
+    st.update(wwct, 0.75);
+    BOOST_CHECK_EQUAL(st.get(wwct), 0.75);
+    BOOST_CHECK_EQUAL(st.get_well_var("OP1", "WWCT"), 0.75);
+    BOOST_CHECK_EQUAL(st.get("WWCT:OP1"), 0.75);
+    BOOST_CHECK_EQUAL(st.well_handle("OP1", "WWCT"), wwct);
+
+    const auto fopt = st.handle("FOPT");
+    BOOST_CHECK_EQUAL(st.find_handle("FOPT"), fopt);
+    BOOST_CHECK_EQUAL(st.find_handle("FWPT"), Opm::SummaryState::invalid_handle);
+    st.update(fopt, 100);
+    st.update("FOPT", 100);
+    BOOST_CHECK_EQUAL(st.get(fopt), 200);
+
+    // Handles remain valid in copies and across deserialize()
+    auto st2 = st;
+    BOOST_CHECK_EQUAL(st2.layout(), st.layout());
+    st2.update(fopt, 100);
+    st2.deserialize(st.serialize());
+    BOOST_CHECK_EQUAL(st2.get(fopt), 200);
+    BOOST_CHECK_EQUAL(st2.get(wwct), 0.75);
+
+    st2.update("FWPT", 1);
+    BOOST_CHECK(st2.layout() != st.layout());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_evaluation) {
+    setup cfg( "test_summary_parallel" );
+
+    SummaryState st_serial(std::chrono::system_clock::now());
+    SummaryState st_parallel(std::chrono::system_clock::now());
+
+    out::Summary serial( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    out::Summary parallel( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+    parallel.enableParallelEvaluation();
+
+    for (int step = 0; step < 3; ++step) {
+        serial.eval(st_serial, step, step*day, cfg.es, cfg.schedule, cfg.wells, {});
+        parallel.eval(st_parallel, step, step*day, cfg.es, cfg.schedule, cfg.wells, {});
+    }
+
+    BOOST_CHECK_EQUAL(st_serial.size(), st_parallel.size());
+    for (const auto& value_pair : st_serial)
+        BOOST_CHECK_EQUAL(value_pair.second, st_parallel.get(value_pair.first));
+}
+
+BOOST_AUTO_TEST_CASE(flush_policy) {
+    setup cfg( "test_summary_flush_policy" );
+
+    {
+        out::Summary writer( cfg.es, cfg.config, cfg.grid, cfg.schedule, cfg.name );
+
+        auto policy = out::Summary::FlushPolicy{};
+        policy.ministeps = 2;
+        writer.setFlushPolicy(policy);
+
+        SummaryState st(std::chrono::system_clock::now());
+        for (int step = 0; step < 3; ++step) {
+            writer.eval( st, step, step * day, cfg.es, cfg.schedule, cfg.wells, {});
+            writer.add_timestep( st, step);
+            writer.write(false);
+        }
+
+        const auto stats = writer.flushStatistics();
+        BOOST_CHECK_EQUAL(stats.flushes, 1U);
+        BOOST_CHECK_EQUAL(stats.ministepsWritten, 2U);
+
+        // The last ministep is pending, it is written when the writer goes
+        // out of scope.
+    }
+
+    auto res = readsum( cfg.name );
+    BOOST_CHECK_EQUAL(res->get("TIME").size(), 3U);
+    BOOST_CHECK_CLOSE(res->get("TIME").back(), 2.0, 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // ####################################################################